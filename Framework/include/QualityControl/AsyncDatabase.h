@@ -0,0 +1,140 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   AsyncDatabase.h
+///
+
+#ifndef QC_REPOSITORY_ASYNCDATABASE_H
+#define QC_REPOSITORY_ASYNCDATABASE_H
+
+#include "QualityControl/DatabaseInterface.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace o2::quality_control::repository
+{
+
+/// \brief Decorator which uploads MonitorObjects and QualityObjects to the wrapped database in background threads.
+///
+/// storeMO and storeQO only enqueue the object and return immediately, a pool of workers performs the actual uploads.
+/// If an object with the same path is still waiting in the queue, it is replaced by the newer version, so that only
+/// the latest one is uploaded when the database cannot keep up. When the queue is full, the oldest pending object
+/// is dropped. All the other calls are forwarded synchronously to the wrapped database.
+///
+/// Each worker owns its own instance of the wrapped database, so that the backends do not have to be thread-safe.
+/// The store methods enqueue a copy of the object, so the uploaded content is the one at the time of the call, even if
+/// the caller modifies the object afterwards. Since the copies are serialized in the worker threads, ROOT thread
+/// safety has to be enabled with ROOT::EnableThreadSafety().
+class AsyncDatabase : public DatabaseInterface
+{
+ public:
+  struct Stats {
+    size_t queueDepth = 0;
+    size_t stored = 0;
+    size_t dropped = 0;
+    size_t coalesced = 0;
+    size_t failed = 0;
+    double meanUploadLatencyMs = 0; // time between enqueueing and the end of the upload
+    double maxUploadLatencyMs = 0;
+  };
+
+  using BackendFactory = std::function<std::unique_ptr<DatabaseInterface>()>;
+
+  /// \param backendFactory creates the databases which perform the actual storage, one per worker plus one for
+  ///                       the synchronous calls
+  /// \param workers number of upload threads
+  /// \param maxQueueSize maximum number of objects waiting for upload
+  AsyncDatabase(const BackendFactory& backendFactory, size_t workers = 1, size_t maxQueueSize = 1000);
+  ~AsyncDatabase() override;
+
+  void connect(const std::string& host, const std::string& database, const std::string& username, const std::string& password) override;
+  void connect(const std::unordered_map<std::string, std::string>& config) override;
+
+  // storage
+  void storeMO(std::shared_ptr<const o2::quality_control::core::MonitorObject> mo) override;
+  void storeQO(std::shared_ptr<const o2::quality_control::core::QualityObject> qo) override;
+  void storeAny(const void* obj, std::type_info const& typeInfo, std::string const& path, std::map<std::string, std::string> const& metadata,
+                std::string const& detectorName, std::string const& taskName, long from = -1, long to = -1) override;
+
+  // retrieval
+  void* retrieveAny(std::type_info const& tinfo, std::string const& path,
+                    std::map<std::string, std::string> const& metadata, long timestamp = Timestamp::Current,
+                    std::map<std::string, std::string>* headers = nullptr,
+                    const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") override;
+  std::shared_ptr<o2::quality_control::core::MonitorObject> retrieveMO(std::string objectPath, std::string objectName,
+                                                                       long timestamp = Timestamp::Current,
+                                                                       const core::Activity& activity = {},
+                                                                       const std::map<std::string, std::string>& metadata = {}) override;
+  std::shared_ptr<o2::quality_control::core::QualityObject> retrieveQO(std::string qoPath, long timestamp = Timestamp::Current,
+                                                                       const core::Activity& activity = {},
+                                                                       const std::map<std::string, std::string>& metadata = {}) override;
+  std::string retrieveJson(std::string path, long timestamp, const std::map<std::string, std::string>& metadata) override;
+  TObject* retrieveTObject(std::string path, const std::map<std::string, std::string>& metadata, long timestamp = Timestamp::Current, std::map<std::string, std::string>* headers = nullptr) override;
+
+  void disconnect() override;
+  void prepareTaskDataContainer(std::string taskName) override;
+  std::vector<std::string> getPublishedObjectNames(std::string taskName) override;
+  void truncate(std::string path, std::string objectName) override;
+  void setMaxObjectSize(size_t maxObjectSize) override;
+  core::ValidityInterval getLatestObjectValidity(const std::string& path, const std::map<std::string, std::string>& metadata = {}) override;
+  /// \brief The objects are queued and uploaded after storeMO and storeQO return.
+  bool storesSynchronously() const override { return false; }
+
+  /// \brief Blocks until all the queued objects are uploaded.
+  void flush();
+
+  /// \brief Returns the statistics accumulated since the previous call and resets the counters.
+  Stats getAndResetStats();
+
+  DatabaseInterface* getBackend() { return mBackend.get(); }
+
+ private:
+  using StorageItem = std::variant<std::shared_ptr<const core::MonitorObject>, std::shared_ptr<const core::QualityObject>>;
+  struct PendingUpload {
+    StorageItem item;
+    std::chrono::steady_clock::time_point enqueued;
+  };
+
+  void enqueue(const std::string& path, StorageItem item);
+  void workerLoop(DatabaseInterface& backend);
+  void stopWorkers();
+
+  std::unique_ptr<DatabaseInterface> mBackend;                    // used for all the synchronous calls
+  std::vector<std::unique_ptr<DatabaseInterface>> mWorkerBackends; // one per upload thread
+  size_t mMaxQueueSize;
+
+  std::mutex mMutex;
+  std::condition_variable mQueueCondition; // signals new items or stopping
+  std::condition_variable mIdleCondition;  // signals that queue is empty and no uploads are ongoing
+  std::deque<std::string> mQueueOrder;     // paths in the order they should be uploaded
+  std::unordered_map<std::string, PendingUpload> mPending; // the newest version of an object for each path
+  size_t mUploadsInProgress = 0;
+  bool mStopping = false;
+  std::vector<std::thread> mWorkers;
+
+  Stats mStats;
+  double mTotalUploadLatencyMs = 0;
+};
+
+} // namespace o2::quality_control::repository
+
+#endif // QC_REPOSITORY_ASYNCDATABASE_H
@@ -22,11 +22,18 @@
 #include <Framework/Task.h>
 #include "QualityControl/QualitiesToFlagCollectionConverter.h"
 #include "QualityControl/Provenance.h"
+#include <Common/Timer.h>
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace o2::quality_control::core
 {
 
-// This class gathers all QualityObjects from it's inputs, converting them to flags + sending them to grpc RCT/BKP when stop() is invoked
+// This class gathers all QualityObjects from it's inputs, converting them to flags + sending them to grpc RCT/BKP when stop() is invoked.
+// In the streaming mode, the flags which cannot change anymore are also sent periodically during the run.
 class BookkeepingQualitySink : public framework::Task
 {
  public:
@@ -34,10 +41,18 @@ class BookkeepingQualitySink : public framework::Task
   using FlagsMap = std::unordered_map<std::string /*detector*/,
                                       std::unordered_map<std::string /* QO name */,
                                                          std::unique_ptr<QualitiesToFlagCollectionConverter>>>;
-  using SendCallback = std::function<void(const std::string& grpcUri, const FlagsMap&, Provenance)>;
+  using FlagCollections = std::unordered_map<std::string /*detector*/,
+                                             std::vector<std::unique_ptr<QualityControlFlagCollection>>>;
+  using SendCallback = std::function<void(const std::string& grpcUri, const FlagCollections&, Provenance)>;
+
+  struct StreamingConfig {
+    double flushPeriodSeconds = 0;   // 0 disables the periodic flushes, all the flags are sent at the end of run
+    size_t maxBufferedFlags = 10000; // per detector, the finalized flags are flushed as soon as this many new flags are buffered
+  };
 
   // sendCallback is mainly used for testing without the necessity to do grpc calls
   BookkeepingQualitySink(const std::string& grpcUri, Provenance, SendCallback sendCallback = send);
+  BookkeepingQualitySink(const std::string& grpcUri, Provenance, SendCallback sendCallback, StreamingConfig streamingConfig);
 
   void run(framework::ProcessingContext&) override;
   void init(framework::InitContext& iCtx) override;
@@ -47,7 +62,7 @@ class BookkeepingQualitySink : public framework::Task
 
   static void customizeInfrastructure(std::vector<framework::CompletionPolicy>& policies);
   static framework::DataProcessorLabel getLabel() { return { "BookkeepingQualitySink" }; }
-  static void send(const std::string& grpcUri, const FlagsMap&, Provenance);
+  static void send(const std::string& grpcUri, const FlagCollections&, Provenance);
 
  private:
   /// \brief Callback for CallbackService::Id::Start (DPL) a.k.a. RUN transition (FairMQ)
@@ -56,8 +71,16 @@ class BookkeepingQualitySink : public framework::Task
   std::string mGrpcUri;
   Provenance mProvenance;
   SendCallback mSendCallback;
+  StreamingConfig mStreamingConfig;
+  AliceO2::Common::Timer mFlushTimer;
   FlagsMap mFlagsMap;
+  std::unordered_map<std::string /*detector*/, size_t> mForcedFlushThresholds; // buffered flags above which the finalized ones are flushed
 
+  bool isStreaming() const { return mStreamingConfig.flushPeriodSeconds > 0; }
+  void trimToRunDuration(QualitiesToFlagCollectionConverter& converter) const;
+  /// \brief Sends the flags which end before the newest QO of their converter, for all or only the provided detector.
+  void flushFinalized(const std::string* onlyDetector = nullptr);
+  size_t countBufferedFlags(const std::string& detector) const;
   void sendAndClear();
 };
 
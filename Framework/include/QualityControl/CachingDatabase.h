@@ -0,0 +1,159 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CachingDatabase.h
+///
+
+#ifndef QC_REPOSITORY_CACHINGDATABASE_H
+#define QC_REPOSITORY_CACHINGDATABASE_H
+
+#include "QualityControl/DatabaseInterface.h"
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace o2::quality_control::repository
+{
+
+/// \brief Memory-bounded cache of objects retrieved from a database, with a time-to-live.
+///
+/// The entries expire after the configured time-to-live and the least recently used ones are evicted when the total
+/// size exceeds the limit. If an entry is requested while another thread is already retrieving it, the second thread
+/// waits for the first one instead of issuing the same request. The cached objects are never handed out directly,
+/// the callers should copy them.
+///
+/// One instance is shared by the whole process (see getInstance()), so that the post-processing tasks running in the
+/// same process do not retrieve the same objects several times.
+class RetrievalCache
+{
+ public:
+  struct Entry {
+    std::shared_ptr<const TObject> object; // nullptr if the object was not found
+    std::map<std::string, std::string> headers;
+    size_t size = 0; // estimated size in memory, in bytes
+  };
+
+  struct Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t deduplicated = 0; // requests which waited for an identical one in progress
+    size_t evicted = 0;      // entries removed to respect the size limit
+    size_t expired = 0;      // entries removed because of their time-to-live
+    size_t entries = 0;
+    size_t sizeBytes = 0;
+  };
+
+  RetrievalCache(std::chrono::milliseconds timeToLive, size_t maxSizeBytes);
+
+  static RetrievalCache& getInstance();
+
+  /// \brief Changes the time-to-live and the size limit. The already cached entries keep their expiration time.
+  void setLimits(std::chrono::milliseconds timeToLive, size_t maxSizeBytes);
+
+  /// \brief Returns the entry for the key if it is cached and valid, otherwise creates it with the provided function.
+  /// Exceptions thrown by the function are propagated to all the callers waiting for the same key.
+  std::shared_ptr<const Entry> getOrRetrieve(const std::string& key, const std::function<Entry()>& retrieve);
+
+  void clear();
+
+  /// \brief Returns the statistics accumulated since the creation of the cache.
+  Stats getStats() const;
+
+  /// \brief Estimates how much memory an object occupies, using the size of its serialized form.
+  static size_t estimateSize(const TObject* object);
+
+ private:
+  struct Slot {
+    std::shared_ptr<const Entry> entry;
+    std::chrono::steady_clock::time_point expiration;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  void insert(const std::string& key, std::shared_ptr<const Entry> entry);
+  void erase(std::unordered_map<std::string, Slot>::iterator slot);
+
+  mutable std::mutex mMutex;
+  std::chrono::milliseconds mTimeToLive;
+  size_t mMaxSizeBytes;
+  size_t mSizeBytes = 0;
+  std::unordered_map<std::string, Slot> mSlots;
+  std::list<std::string> mLruOrder; // the most recently used keys at the front
+  std::unordered_map<std::string, std::shared_future<std::shared_ptr<const Entry>>> mInFlight;
+  Stats mStats;
+};
+
+/// \brief Decorator which serves the retrievals of MonitorObjects, QualityObjects and TObjects from a RetrievalCache.
+///
+/// Each call returns a new copy of the cached object, so the callers may modify it freely. Objects retrieved with
+/// the timestamps Timestamp::Current or Timestamp::Latest may be outdated by up to the time-to-live of the cache.
+/// Objects which are not found are not cached. All the other calls are forwarded to the wrapped database.
+class CachingDatabase : public DatabaseInterface
+{
+ public:
+  CachingDatabase(std::unique_ptr<DatabaseInterface> backend, RetrievalCache& cache = RetrievalCache::getInstance());
+  ~CachingDatabase() override = default;
+
+  void connect(const std::string& host, const std::string& database, const std::string& username, const std::string& password) override;
+  void connect(const std::unordered_map<std::string, std::string>& config) override;
+
+  // storage
+  void storeMO(std::shared_ptr<const o2::quality_control::core::MonitorObject> mo) override;
+  void storeQO(std::shared_ptr<const o2::quality_control::core::QualityObject> qo) override;
+  void storeAny(const void* obj, std::type_info const& typeInfo, std::string const& path, std::map<std::string, std::string> const& metadata,
+                std::string const& detectorName, std::string const& taskName, long from = -1, long to = -1) override;
+
+  // retrieval
+  void* retrieveAny(std::type_info const& tinfo, std::string const& path,
+                    std::map<std::string, std::string> const& metadata, long timestamp = Timestamp::Current,
+                    std::map<std::string, std::string>* headers = nullptr,
+                    const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") override;
+  std::shared_ptr<o2::quality_control::core::MonitorObject> retrieveMO(std::string objectPath, std::string objectName,
+                                                                       long timestamp = Timestamp::Current,
+                                                                       const core::Activity& activity = {},
+                                                                       const std::map<std::string, std::string>& metadata = {}) override;
+  std::shared_ptr<o2::quality_control::core::QualityObject> retrieveQO(std::string qoPath, long timestamp = Timestamp::Current,
+                                                                       const core::Activity& activity = {},
+                                                                       const std::map<std::string, std::string>& metadata = {}) override;
+  std::string retrieveJson(std::string path, long timestamp, const std::map<std::string, std::string>& metadata) override;
+  TObject* retrieveTObject(std::string path, const std::map<std::string, std::string>& metadata, long timestamp = Timestamp::Current, std::map<std::string, std::string>* headers = nullptr) override;
+
+  void disconnect() override;
+  void prepareTaskDataContainer(std::string taskName) override;
+  std::vector<std::string> getPublishedObjectNames(std::string taskName) override;
+  void truncate(std::string path, std::string objectName) override;
+  void setMaxObjectSize(size_t maxObjectSize) override;
+  core::ValidityInterval getLatestObjectValidity(const std::string& path, const std::map<std::string, std::string>& metadata = {}) override;
+  /// \brief Returns a copy using the same cache, or nullptr if the backend cannot be copied.
+  std::unique_ptr<DatabaseInterface> clone() override;
+  bool storesSynchronously() const override { return mBackend->storesSynchronously(); }
+
+  DatabaseInterface* getBackend() { return mBackend.get(); }
+
+ private:
+  /// \brief Creates a key which identifies the retrieval, the backend is included to tell apart different databases.
+  std::string makeKey(const char* kind, const std::string& path, long timestamp, const std::map<std::string, std::string>& metadata) const;
+
+  std::unique_ptr<DatabaseInterface> mBackend;
+  RetrievalCache& mCache;
+  std::string mBackendId; // host and database name, as given in connect()
+};
+
+} // namespace o2::quality_control::repository
+
+#endif // QC_REPOSITORY_CACHINGDATABASE_H
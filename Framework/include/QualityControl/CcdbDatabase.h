@@ -21,7 +21,9 @@
 #include <Common/Timer.h>
 #include <boost/property_tree/ptree_fwd.hpp>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace o2::ccdb
 {
@@ -64,8 +66,33 @@ class CcdbDatabase : public DatabaseInterface
   void connect(const std::string& host, const std::string& database, const std::string& username, const std::string& password) override;
   void connect(const std::unordered_map<std::string, std::string>& config) override;
 
+  /**
+   * \brief An object serialized in the format expected by the CCDB.
+   * It can be uploaded many times without being streamed again.
+   */
+  struct SerializedObject {
+    std::unique_ptr<std::vector<char>> image;
+    std::string fileName;
+    std::string objectType;
+  };
+
+  /**
+   * \brief Serializes the object the same way as storeMO does before uploading it.
+   * @param obj The object to serialize, typically the one encapsulated in a MonitorObject.
+   * @return The serialized object.
+   */
+  static SerializedObject serialize(const TObject* obj);
+
   // storage
   void storeMO(std::shared_ptr<const o2::quality_control::core::MonitorObject> q) override;
+  /**
+   * \brief Stores a MonitorObject whose encapsulated object has been already serialized.
+   * The path, metadata and validity are taken from the MonitorObject, but its encapsulated object is not streamed.
+   * The caller is responsible for providing the serialized version of the same object.
+   * @param mo The MonitorObject to store.
+   * @param serializedObject The result of serialize(mo->getObject()).
+   */
+  void storeMO(std::shared_ptr<const o2::quality_control::core::MonitorObject> mo, const SerializedObject& serializedObject);
   void storeQO(std::shared_ptr<const o2::quality_control::core::QualityObject> q) override;
   void storeAny(const void* obj, std::type_info const& typeInfo, std::string const& path, std::map<std::string, std::string> const& metadata,
                 std::string const& detectorName, std::string const& taskName, long from = -1, long to = -1) override;
@@ -127,6 +154,7 @@ class CcdbDatabase : public DatabaseInterface
   std::vector<uint64_t> getTimestampsForObject(const std::string& path);
 
   void setMaxObjectSize(size_t maxObjectSize) override;
+  std::unique_ptr<DatabaseInterface> clone() override;
 
  private:
   void init();
@@ -140,6 +168,20 @@ class CcdbDatabase : public DatabaseInterface
    */
   std::string getListingAsString(const std::string& subpath = "", const std::string& accept = "text/plain", bool latestOnly = false);
 
+  struct StorageParameters {
+    std::string path;
+    std::map<std::string, std::string> metadata;
+    long from;
+    long to;
+  };
+
+  /**
+   * Validates the MonitorObject and prepares the path, metadata and validity to store it with.
+   * @param mo
+   * @return The storage parameters or nothing if the object should not be stored.
+   */
+  std::optional<StorageParameters> prepareStorageParameters(const core::MonitorObject& mo);
+
   /**
    * Takes care of the possible errors returned by the storage calls.
    * @param path
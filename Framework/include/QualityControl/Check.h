@@ -23,6 +23,7 @@
 #include "QualityControl/QualityObject.h"
 #include "QualityControl/CheckConfig.h"
 #include "QualityControl/CheckInterface.h"
+#include "QualityControl/MonitorObjectsView.h"
 
 namespace o2::quality_control::core
 {
@@ -64,7 +65,19 @@ class Check
   void init();
   void reset();
 
-  core::QualityObjectsType check(std::map<std::string, std::shared_ptr<o2::quality_control::core::MonitorObject>>& moMap);
+  /**
+   * \brief Runs the check on the required MonitorObjects from the map.
+   * @param moMap All the MonitorObjects available, it is not modified.
+   * @param beautifyObjects If false, the MonitorObjects are not beautified. It can be then done with beautify().
+   * @return QualityObjects produced by the check.
+   */
+  core::QualityObjectsType check(std::map<std::string, std::shared_ptr<o2::quality_control::core::MonitorObject>>& moMap, bool beautifyObjects = true);
+
+  /**
+   * \brief Beautifies the MonitorObjects which were checked to produce the QualityObjects.
+   * Meant to be used after check() was called with beautifyObjects set to false.
+   */
+  void beautify(std::map<std::string, std::shared_ptr<o2::quality_control::core::MonitorObject>>& moMap, const core::QualityObjectsType& qualityObjects);
 
   const std::string& getName() const { return mCheckConfig.name; };
   o2::framework::OutputSpec getOutputSpec() const { return mCheckConfig.qoSpec; };
@@ -82,10 +95,13 @@ class Check
   static CheckConfig extractConfig(const core::CommonSpec&, const CheckSpec&);
 
  private:
-  void beautify(std::map<std::string, std::shared_ptr<core::MonitorObject>>& moMap, const core::Quality& quality);
+  /// Fills mSelectedObjects with the entries of moMap which should be checked, sorted by name.
+  void selectObjects(std::map<std::string, std::shared_ptr<core::MonitorObject>>& moMap);
+  void beautify(const core::MonitorObjectsView& objects, const core::Quality& quality);
 
   CheckConfig mCheckConfig;
   CheckInterface* mCheckInterface = nullptr;
+  std::vector<const core::MonitorObjectsView::Entry*> mSelectedObjects; // reused across the calls to avoid allocations
 };
 
 } // namespace o2::quality_control::checker
@@ -23,6 +23,7 @@
 #include "QualityControl/Activity.h"
 
 #include "QualityControl/QCInputs.h"
+#include "QualityControl/MonitorObjectsView.h"
 
 namespace o2::quality_control::core
 {
@@ -61,6 +62,17 @@ class CheckInterface : public core::UserCodeInterface
   /// @return The quality associated with these objects.
   virtual core::Quality check(const core::QCInputs& data);
 
+  /// \brief Returns the quality associated with these objects.
+  ///
+  /// This is the method invoked by the framework. Overriding it avoids copying the objects into a map at each call.
+  /// The default implementation copies the objects into a map and calls check(std::map*), so that the Checks
+  /// which override one of the other signatures keep working.
+  ///
+  /// @param view A view of the MonitorObjects to check, sorted by their full names (i.e. <task_name>/<mo name>).
+  ///             It is valid only during this call.
+  /// @return The quality associated with these objects.
+  virtual core::Quality check(const core::MonitorObjectsView& view);
+
   /// \brief Modify the aspect of the plot.
   ///
   /// Modify the aspect of the plot.
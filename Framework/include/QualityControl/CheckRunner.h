@@ -27,6 +27,7 @@
 #include <unordered_set>
 // O2
 #include <Common/Timer.h>
+#include <boost/asio/thread_pool.hpp>
 #include <Framework/Task.h>
 #include <Framework/DataProcessorSpec.h>
 // QC
@@ -34,6 +35,8 @@
 #include "QualityControl/CheckRunnerConfig.h"
 #include "QualityControl/Check.h"
 #include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/LatencyTracing.h"
 #include "QualityControl/QualityObject.h"
 #include "QualityControl/UpdatePolicyManager.h"
 
@@ -140,6 +143,10 @@ class CheckRunner : public framework::Task
    * taking the worse quality encountered. The MonitorObject is modified by setting its quality
    * and by calling the "beautifying" methods of the Check's.
    *
+   * If more than one thread is configured, the ready Checks are run in parallel. In such case, the MonitorObjects
+   * are beautified only once all the Checks are done, one Check after another.
+   * In both cases, the QualityObjects are returned in the same, deterministic order.
+   *
    * @param mo The MonitorObject to evaluate and whose quality will be set according
    *        to the worse quality encountered while running the Check's.
    */
@@ -203,6 +210,8 @@ class CheckRunner : public framework::Task
    * Send metrics to the monitoring system if the time has come.
    */
   void sendPeriodicMonitoring();
+  /// \brief Stamps the QOs and fills the latencies of the Checks, the storage and the whole chain.
+  void traceLatencies(const QualityObjectsType& qualityObjects, uint64_t checkDone);
 
   /// \brief Callback for CallbackService::Id::Start (DPL) a.k.a. RUN transition (FairMQ)
   void start(framework::ServiceRegistryRef services);
@@ -222,6 +231,7 @@ class CheckRunner : public framework::Task
   std::vector<std::shared_ptr<MonitorObject>> mMonitorObjectStoreVector;
   UpdatePolicyManager updatePolicyManager;
   bool mReceivedEOS = false;
+  std::unique_ptr<boost::asio::thread_pool> mCheckThreadPool; // only if the Checks should be run in parallel
 
   // DPL
   o2::framework::Inputs mInputs;
@@ -243,6 +253,12 @@ class CheckRunner : public framework::Task
   int mTotalQOSent;
   int mNumberQOStored = 0; // since the last publication of the monitoring data
   int mNumberMOStored = 0; // since the last publication of the monitoring data
+  std::map<std::string, double> mCheckDurationsMs; // the longest execution of each Check since the last publication of the monitoring data
+  std::map<std::string, std::vector<core::MergeStatistics>> mMergeStatistics;     // of each task since the last publication of the monitoring data
+  std::map<std::string, std::vector<core::MergeStatistics>> mLastMergeStatistics; // totals carried by the last merged collection of each task
+  std::map<std::string, core::latency_tracing::LatencyHistogram> mLatencies; // since the last publication of the monitoring data
+  uint64_t mInputTimestamp = 0;                                               // when the current inputs were received
+  std::vector<uint64_t> mTracedFirstDataTimestamps;                           // of the traced inputs received in the current call
   AliceO2::Common::Timer mTimer;
   AliceO2::Common::Timer mTimerTotalDurationActivity;
 };
@@ -33,6 +33,8 @@ struct CheckRunnerConfig {
   core::LogDiscardParameters infologgerDiscardParameters;
   core::Activity fallbackActivity;
   framework::Options options{};
+  size_t threads = 1; // number of threads executing the Checks in parallel, 1 means that they are run sequentially
+  bool latencyTracing = false; // the latencies stamped in the received objects are sent as metrics
 };
 
 } // namespace o2::quality_control::checker
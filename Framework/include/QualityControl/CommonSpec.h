@@ -40,13 +40,17 @@ struct CommonSpec {
   int activityFillNumber = 0;
   int activityOriginalNumber = 0;
   std::string monitoringUrl = "infologger:///debug?qc";
+  bool latencyTracing = false;
   std::string consulUrl;
   std::string conditionDBUrl = "http://ali-qcdb-test.cern.ch:8083";
   LogDiscardParameters infologgerDiscardParameters;
   double postprocessingPeriod = 30.0;
   std::string bookkeepingUrl;
+  double bookkeepingFlagsFlushPeriodSeconds = 0;
+  size_t bookkeepingMaxBufferedFlags = 10000;
   std::string kafkaBrokersUrl;
   std::string kafkaTopicAliECSRun = "aliecs.run";
+  size_t checkRunnerThreads = 1;
 };
 
 } // namespace o2::quality_control::core
@@ -0,0 +1,151 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CounterArray.h
+///
+
+#ifndef QUALITYCONTROL_COUNTERARRAY_H
+#define QUALITYCONTROL_COUNTERARRAY_H
+
+#include <Mergers/MergeInterface.h>
+#include <TNamed.h>
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <span>
+#include <vector>
+
+class TH1;
+
+namespace o2::quality_control::core
+{
+
+/// \brief Dense array of counters with a fixed binning in 1 or 2 dimensions, which can be published as a MonitorObject.
+///
+/// It is meant to replace TH1::Fill and TH2::Fill in the hot loops of tasks. The counters are stored contiguously with
+/// the same bin numbering as ROOT histograms, including the underflow and overflow bins, but filling them involves no
+/// virtual calls, no statistics and no axis extension. Besides filling single values, bin numbers can be filled
+/// directly (e.g. chip and row indices) and whole batches of values can be filled at once.
+///
+/// The counters are merged by Mergers as any MergeInterface object. They can be turned into a histogram with
+/// materialize(), or added to an existing one with fillHistogram(), typically once per cycle before publishing.
+template <typename T>
+class CounterArray : public TNamed, public o2::mergers::MergeInterface
+{
+ public:
+  CounterArray() = default;
+  /// \brief Creates a 1-dimensional array.
+  CounterArray(const char* name, const char* title, int nbinsx, double xmin, double xmax);
+  /// \brief Creates a 2-dimensional array.
+  CounterArray(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax);
+  ~CounterArray() override = default;
+
+  int getDimension() const { return mNBinsY > 0 ? 2 : 1; }
+  int getNBinsX() const { return mNBinsX; }
+  int getNBinsY() const { return mNBinsY; }
+
+  /// \brief Returns the bin containing x, 0 for the underflow and nbinsx + 1 for the overflow, as TAxis::FindFixBin.
+  int findBinX(double x) const { return findBin(x, mXMin, mXMax, mNBinsX); }
+  int findBinY(double y) const { return findBin(y, mYMin, mYMax, mNBinsY); }
+
+  /// \brief Fills a value with weight 1. The weighted variants have their own names, so that a weight is never taken
+  /// for the second coordinate of a 2D fill, or the other way round.
+  void fill(double x) { fillWeighted(x, 1); }
+  void fill(double x, double y) { fillWeighted(x, y, 1); }
+  void fillWeighted(double x, T weight)
+  {
+    assert(getDimension() == 1);
+    mCounters[findBinX(x)] += weight;
+    mEntries++;
+  }
+  void fillWeighted(double x, double y, T weight)
+  {
+    assert(getDimension() == 2);
+    mCounters[getIndex(findBinX(x), findBinY(y))] += weight;
+    mEntries++;
+  }
+  /// \brief Increments a bin directly. The bin numbers are not checked, they have to be within [0, nbins + 1].
+  void fillBin(int binx) { fillBinWeighted(binx, 1); }
+  /// \brief Increments a bin directly. The bin numbers are not checked, they have to be within [0, nbins + 1].
+  void fillBin(int binx, int biny) { fillBinWeighted(binx, biny, 1); }
+  void fillBinWeighted(int binx, T weight)
+  {
+    assert(getDimension() == 1);
+    mCounters[binx] += weight;
+    mEntries++;
+  }
+  void fillBinWeighted(int binx, int biny, T weight)
+  {
+    assert(getDimension() == 2);
+    mCounters[getIndex(binx, biny)] += weight;
+    mEntries++;
+  }
+
+  /// \brief Fills a batch of values with weight 1.
+  void fill(std::span<const double> x);
+  /// \brief Fills a batch of pairs of values with weight 1. The spans should have the same size.
+  void fill(std::span<const double> x, std::span<const double> y);
+  /// \brief Fills a batch of bin numbers with weight 1. The bin numbers are not checked.
+  void fillBins(std::span<const int> binsX);
+  /// \brief Fills a batch of pairs of bin numbers with weight 1. The bin numbers are not checked.
+  void fillBins(std::span<const int> binsX, std::span<const int> binsY);
+
+  T getBinContent(int binx, int biny = 0) const { return mCounters[getIndex(binx, biny)]; }
+  /// \brief All the counters, in the order of ROOT global bin numbers (including underflow and overflow bins).
+  const std::vector<T>& getCounters() const { return mCounters; }
+  /// \brief The number of fill calls (each element of a batch counts as one).
+  ULong64_t getEntries() const { return mEntries; }
+  /// \brief The sum of all the counters, including underflow and overflow.
+  double getSum() const;
+  void reset();
+
+  /// \brief Creates a histogram with the same name, title, binning and contents. TH1F/TH2F for floats, TH1D/TH2D otherwise.
+  std::unique_ptr<TH1> materialize() const;
+  /// \brief Adds the counters to a histogram with the same binning, such as the one created by materialize().
+  /// The statistics of the histogram are recomputed from its bin contents.
+  void fillHistogram(TH1* histogram) const;
+
+  void merge(o2::mergers::MergeInterface* const other) override;
+
+ private:
+  static int findBin(double value, double min, double max, int nbins)
+  {
+    if (value < min) {
+      return 0;
+    }
+    if (!(value < max)) {
+      return nbins + 1; // also NaNs go to the overflow, as in TAxis
+    }
+    return 1 + std::min(static_cast<int>(nbins * (value - min) / (max - min)), nbins - 1);
+  }
+  size_t getIndex(int binx, int biny) const { return binx + static_cast<size_t>(mNBinsX + 2) * biny; }
+
+  int mNBinsX = 0;
+  int mNBinsY = 0; // 0 for 1-dimensional arrays
+  double mXMin = 0;
+  double mXMax = 1;
+  double mYMin = 0;
+  double mYMax = 1;
+  std::vector<T> mCounters;
+  ULong64_t mEntries = 0;
+
+  ClassDefOverride(CounterArray, 1);
+};
+
+using CounterArrayI = CounterArray<UInt_t>;
+using CounterArrayL = CounterArray<ULong64_t>;
+using CounterArrayF = CounterArray<Float_t>;
+
+} // namespace o2::quality_control::core
+
+#endif // QUALITYCONTROL_COUNTERARRAY_H
@@ -208,6 +208,19 @@ class DatabaseInterface
    * @return validity of the latest matching object
    */
   virtual core::ValidityInterval getLatestObjectValidity(const std::string& path, const std::map<std::string, std::string>& metadata = {}) = 0;
+
+  /**
+   * Creates a new instance connected to the same database, which can be used in another thread.
+   * @return the new instance or nullptr if it is not supported by the implementation
+   */
+  virtual std::unique_ptr<DatabaseInterface> clone() { return nullptr; }
+
+  /**
+   * Tells whether the objects passed to storeMO and storeQO are not used anymore once these calls return.
+   * If it is the case, the callers may pass objects which they do not own, without copying them.
+   * @return false if the implementation keeps the objects to store them later
+   */
+  virtual bool storesSynchronously() const { return true; }
 };
 
 } // namespace o2::quality_control::repository
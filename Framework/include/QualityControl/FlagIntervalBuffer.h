@@ -0,0 +1,85 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   FlagIntervalBuffer.h
+///
+
+#ifndef QUALITYCONTROL_FLAGINTERVALBUFFER_H
+#define QUALITYCONTROL_FLAGINTERVALBUFFER_H
+
+#include "QualityControl/ValidityInterval.h"
+#include <DataFormatsQualityControl/FlagType.h>
+#include <DataFormatsQualityControl/QualityControlFlag.h>
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace o2::quality_control::core
+{
+
+/// \brief Intervals of flags, grouped by the kind of the flag and indexed by their start.
+///
+/// A kind is a pair of a flag type and a comment. They are interned when a kind is first seen, so that flags are
+/// compared by an integer. The intervals of one kind must never overlap or be adjacent, they are expected to be
+/// merged before (see takeConnecting()). Thus, when sorted by their start, they are sorted by their end as well, which
+/// allows to find the intervals overlapping or connecting with a given one in O(log n + k).
+class FlagIntervalBuffer
+{
+ public:
+  using Kind = size_t;
+
+  /// \brief Returns the kind of the flag type and comment, interning them if they are new.
+  Kind getKind(const FlagType& flagType, const std::string& comment);
+  size_t getNumberOfKinds() const { return mKinds.size(); }
+  const FlagType& getFlagType(Kind kind) const { return mKinds.at(kind).flagType; }
+  const std::string& getComment(Kind kind) const { return mKinds.at(kind).comment; }
+
+  /// \brief Adds an interval, which must not overlap or be adjacent to other intervals of the same kind.
+  void insert(Kind kind, ValidityInterval interval);
+  /// \brief Removes the intervals of the kind which overlap or are adjacent to the provided one.
+  /// \return The union of the provided interval and the removed ones.
+  ValidityInterval takeConnecting(Kind kind, ValidityInterval interval);
+  /// \brief Removes the provided interval from the intervals of the kind, which may split them into two.
+  void exclude(Kind kind, ValidityInterval interval);
+  /// \brief Returns the intervals of the kind which overlap with the provided one, sorted by their start.
+  std::vector<ValidityInterval> getOverlapping(Kind kind, ValidityInterval interval) const;
+  /// \brief Trims all the intervals to the provided one, the intervals outside of it are removed.
+  void intersect(ValidityInterval interval);
+  /// \brief Removes and returns the intervals of the kind which end before the provided time, sorted by their start.
+  std::vector<ValidityInterval> takeEndingBefore(Kind kind, validity_time_t time);
+
+  /// \brief Removes all the intervals of the kind.
+  void erase(Kind kind);
+  /// \brief Removes all the intervals, the interned kinds are kept.
+  void clear();
+  size_t size() const;
+
+  /// \brief Returns all the buffered intervals as flags with the provided source.
+  std::vector<QualityControlFlag> getFlags(const std::string& source) const;
+
+ private:
+  struct KindInfo {
+    FlagType flagType;
+    std::string comment;
+  };
+  std::vector<KindInfo> mKinds;
+  std::unordered_map<std::string, size_t> mComments;       // comment -> interned comment id
+  std::map<std::pair<uint16_t, size_t>, Kind> mKindLookup; // flag type id and comment id -> kind
+  std::vector<std::map<validity_time_t, validity_time_t>> mIntervals; // for each kind, start -> end
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QUALITYCONTROL_FLAGINTERVALBUFFER_H
@@ -0,0 +1,79 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   LatencyTracing.h
+///
+
+#ifndef QUALITYCONTROL_LATENCYTRACING_H
+#define QUALITYCONTROL_LATENCYTRACING_H
+
+#include <Monitoring/Metric.h>
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+
+/// \brief Tracing of the latency between the arrival of data in a QC task and the storage of its results.
+///
+/// When enabled, each stage stamps the current time (ms since epoch) into the metadata of the objects, under the keys
+/// metadata_keys::trace*. The Check Runners compute the latencies between consecutive stages and send their
+/// distributions as metrics.
+namespace o2::quality_control::core::latency_tracing
+{
+
+/// \brief Distribution of latencies in fixed buckets.
+///
+/// The Monitoring library has no histogram type, thus the bucket counts are sent as values "le_<upper edge>" of one
+/// metric, together with the count, the mean and the maximum.
+class LatencyHistogram
+{
+ public:
+  /// The upper edges of the buckets in ms. The last bucket contains everything above.
+  static constexpr std::array<uint64_t, 9> BucketEdgesMs{ 10, 100, 500, 1000, 5000, 10000, 30000, 60000, 120000 };
+  using Buckets = std::array<uint64_t, BucketEdgesMs.size() + 1>;
+
+  void fill(double latencyMs);
+  void reset();
+
+  uint64_t getCount() const { return mCount; }
+  double getMean() const { return mCount > 0 ? mSum / mCount : 0; }
+  double getMax() const { return mMax; }
+  const Buckets& getBuckets() const { return mBuckets; }
+
+  o2::monitoring::Metric toMetric(const std::string& name) const;
+
+ private:
+  Buckets mBuckets{};
+  uint64_t mCount = 0;
+  double mSum = 0;
+  double mMax = 0;
+};
+
+/// \brief Returns the current time in ms since epoch, as stamped in the metadata.
+uint64_t getCurrentTimestamp();
+
+/// \brief Returns the timestamp stored under the key, if present and valid.
+std::optional<uint64_t> getTimestamp(const std::map<std::string, std::string>& metadata, const std::string& key);
+
+/// \brief Fills the latencies between the consecutive stages stamped in the metadata.
+///
+/// The latencies are filled in the histograms named after the stages which end them: "cycle" (first data to the end of
+/// the cycle), "publication" (end of the cycle to the snapshot), "transport" (snapshot to the Check Runner input,
+/// including Mergers) and "check" (Check Runner input to the end of the Checks). The latencies from or to a missing
+/// stage are skipped.
+void fillLatencies(const std::map<std::string, std::string>& metadata, std::map<std::string, LatencyHistogram>& latencies);
+
+} // namespace o2::quality_control::core::latency_tracing
+
+#endif // QUALITYCONTROL_LATENCYTRACING_H
@@ -14,6 +14,11 @@
 #pragma link C++ class o2::quality_control::postprocessing::PostProcessingInterface + ;
 #pragma link C++ class o2::quality_control::postprocessing::TrendingTask + ;
 #pragma link C++ class o2::quality_control::core::MonitorObjectCollection + ;
+#pragma link C++ struct o2::quality_control::core::MergeStatistics + ;
+#pragma link C++ class std::vector<o2::quality_control::core::MergeStatistics> + ;
+#pragma link C++ class o2::quality_control::core::CounterArray < UInt_t> + ;
+#pragma link C++ class o2::quality_control::core::CounterArray < ULong64_t> + ;
+#pragma link C++ class o2::quality_control::core::CounterArray < Float_t> + ;
 #pragma link C++ class o2::quality_control::core::ValidityInterval + ;
 #pragma link C++ class o2::quality_control::postprocessing::SliceInfo + ;
 #pragma link C++ class std::vector<o2::quality_control::postprocessing::SliceInfo> + ;
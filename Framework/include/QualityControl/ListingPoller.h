@@ -0,0 +1,137 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ListingPoller.h
+///
+
+#ifndef QUALITYCONTROL_LISTINGPOLLER_H
+#define QUALITYCONTROL_LISTINGPOLLER_H
+
+#include "QualityControl/ValidityInterval.h"
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <boost/property_tree/ptree.hpp>
+
+namespace o2::quality_control::postprocessing
+{
+
+/// \brief Watches a database for new versions of objects on behalf of many triggers.
+///
+/// The watched objects are grouped by their directory and metadata filter, and one "latest only" listing of the
+/// whole directory is requested for each group instead of one listing per object. A listing is shared by all the
+/// subscriptions of a group until one of them asks again, i.e. typically once per round of trigger checks, or until
+/// it is older than the maximum age.
+///
+/// A new version of an object is reported only once the publication of its cycle looks complete, i.e. when none of
+/// the objects in the same directory still belongs to an older cycle of the same series. If the objects do not carry
+/// a cycle number, they are reported immediately. If the directory did not change between two listings or the
+/// maximum wait time passed, the object is reported anyway, as some objects might not be published in every cycle.
+///
+/// One instance per database URL is shared by all the triggers in the process (see getInstance()).
+class ListingPoller
+{
+ public:
+  /// \brief Returns a "latest only" listing of the path with the given metadata filters, in the same format as
+  /// CcdbDatabase::getListingAsPtree.
+  using ListingFunction = std::function<boost::property_tree::ptree(const std::string& path, const std::map<std::string, std::string>& metadata, bool latestOnly)>;
+
+  class Subscription;
+
+  struct Stats {
+    size_t listings = 0; // listing requests sent to the database
+    size_t subscriptions = 0;
+    size_t groups = 0;
+  };
+
+  ListingPoller(ListingFunction listing,
+                std::chrono::milliseconds maxListingAge = std::chrono::seconds(1),
+                std::chrono::milliseconds maxCompletenessWait = std::chrono::seconds(10));
+
+  static std::shared_ptr<ListingPoller> getInstance(const std::string& databaseUrl);
+
+  /// \brief Starts watching the object. The latest version existing at the time of subscribing is not reported.
+  std::shared_ptr<Subscription> subscribe(const std::string& objectPath, const std::map<std::string, std::string>& metadata = {});
+
+  /// \brief Returns the validity of a new and complete version of the subscribed object, or an invalid interval.
+  core::ValidityInterval poll(Subscription& subscription);
+
+  /// \brief Returns the full listing of the path (all the versions), shared with other callers for the maximum age.
+  /// The lock is not held while the listing is requested, so concurrent callers might request the same listing.
+  boost::property_tree::ptree getFullListing(const std::string& objectPath);
+
+  Stats getStats() const;
+
+  class Subscription
+  {
+   private:
+    friend class ListingPoller;
+    struct PendingVersion {
+      core::ValidityInterval validity;
+      std::optional<unsigned long> cycle;
+      std::optional<unsigned long> previousCycle;
+      size_t groupRevision;
+      size_t groupRefreshes;
+      std::chrono::steady_clock::time_point detected;
+    };
+
+    std::string mPath;
+    std::string mGroupKey;
+    uint64_t mLastModified = 0;
+    std::optional<unsigned long> mCycle;
+    size_t mConsumedRefreshes = 0; // the last group listing this subscription has looked at
+    std::optional<PendingVersion> mPending;
+  };
+
+ private:
+  struct ListedObject {
+    uint64_t lastModified = 0;
+    core::ValidityInterval validity;
+    std::optional<unsigned long> cycle;
+  };
+  struct Group {
+    std::string listingPath; // the directory of the objects followed by "/.*", or a single object
+    std::map<std::string, std::string> metadata;
+    std::unordered_map<std::string, ListedObject> objects; // by path
+    std::chrono::steady_clock::time_point lastRefresh;
+    size_t refreshes = 0;
+    size_t revision = 0; // incremented each time the content of the listing changes
+  };
+  struct FullListing {
+    boost::property_tree::ptree listing;
+    std::chrono::steady_clock::time_point retrieved;
+  };
+
+  void refresh(Group& group);
+  bool isComplete(const Group& group, const Subscription::PendingVersion& pending) const;
+  /// \brief Removes the full listings older than the maximum age, it expects mMutex to be locked.
+  void dropExpiredFullListings();
+
+  ListingFunction mListing;
+  std::chrono::milliseconds mMaxListingAge;
+  std::chrono::milliseconds mMaxCompletenessWait;
+
+  mutable std::mutex mMutex;
+  std::unordered_map<std::string, Group> mGroups;
+  std::unordered_map<std::string, FullListing> mFullListings;
+  Stats mStats;
+};
+
+} // namespace o2::quality_control::postprocessing
+
+#endif // QUALITYCONTROL_LISTINGPOLLER_H
@@ -0,0 +1,38 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   MergeHelpers.h
+///
+
+#ifndef QUALITYCONTROL_MERGEHELPERS_H
+#define QUALITYCONTROL_MERGEHELPERS_H
+
+class TObject;
+
+namespace o2::quality_control::core::merge_helpers
+{
+
+/// \brief Adds the histogram other to the histogram target by summing their bin arrays directly.
+///
+/// TH1::Merge creates a TList and a merger object and checks the compatibility of the axes bin by bin, which dominates
+/// the merging time of small or mostly empty histograms. This function handles the common case of two histograms of
+/// the same class with float or double bins and identical binning, including under- and overflows, sums of squares of
+/// weights and statistics.
+/// \return false if the objects are not supported: they are not histograms of the same class, they have different axes,
+///         labelled bins, a restricted axis range, a fill buffer or different Sumw2 settings, or they are profiles or
+///         averaged histograms (TH1::kIsAverage), or their bins are integers, which ROOT caps at the maximum of their type.
+///         Nothing is modified then and the merge should be done by ROOT.
+bool mergeHistograms(TObject* target, const TObject* other);
+
+} // namespace o2::quality_control::core::merge_helpers
+
+#endif // QUALITYCONTROL_MERGEHELPERS_H
@@ -18,20 +18,62 @@
 #define QUALITYCONTROL_MONITOROBJECTCOLLECTION_H
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <TObjArray.h>
+#include <RtypesCore.h>
 #include <Mergers/MergeInterface.h>
 
 namespace o2::quality_control::core
 {
 
+/// \brief The number and duration of the merges of objects of one class into a MonitorObjectCollection.
+struct MergeStatistics {
+  std::string className;
+  ULong64_t merges = 0;
+  ULong64_t fastMerges = 0; // done by merge_helpers::mergeHistograms instead of ROOT
+  double durationMs = 0;
+};
+
+/// \brief Adds the statistics of other to those of the same classes in target.
+void addMergeStatistics(std::vector<MergeStatistics>& target, const std::vector<MergeStatistics>& other);
+
+/// \brief The merges counted in current which were not counted yet in previous, per class.
+/// Collections carry totals since their target was created, thus consecutive publications of a Merger share a part of
+/// their merges. If the totals of a class went down, the target was recreated and its totals are taken as they are.
+std::vector<MergeStatistics> getNewMergeStatistics(const std::vector<MergeStatistics>& current, const std::vector<MergeStatistics>& previous);
+
+/// \brief TObjArray of MonitorObjects which can be merged by Mergers.
+///
+/// The collection keeps a transient index from object names to objects, so that FindObject(const char*) does not
+/// have to scan the whole array. The index is updated when objects are added and rebuilt lazily after removals and
+/// deserialization, thus the names of the objects should not change while they are in the collection.
+/// If several objects share the same name, the lookup returns the one which was indexed first.
 class MonitorObjectCollection : public TObjArray, public mergers::MergeInterface
 {
  public:
   MonitorObjectCollection() = default;
+  MonitorObjectCollection(const MonitorObjectCollection& other);
   ~MonitorObjectCollection() = default;
 
   void merge(mergers::MergeInterface* const other) override;
 
+  using TObjArray::FindObject;
+  TObject* FindObject(const char* name) const override;
+
+  using TObjArray::Remove;
+  void Add(TObject* obj) override;
+  void AddFirst(TObject* obj) override;
+  void AddLast(TObject* obj) override;
+  void AddAt(TObject* obj, Int_t idx) override;
+  void AddAtAndExpand(TObject* obj, Int_t idx) override;
+  Int_t AddAtFree(TObject* obj) override;
+  TObject* Remove(TObject* obj) override;
+  TObject* RemoveAt(Int_t idx) override;
+  void RemoveRange(Int_t idx1, Int_t idx2) override;
+  void Clear(Option_t* option = "") override;
+  void Delete(Option_t* option = "") override;
+
   void postDeserialization() override;
 
   void setDetector(const std::string&);
@@ -42,13 +84,35 @@ class MonitorObjectCollection : public TObjArray, public mergers::MergeInterface
 
   void addOrUpdateMetadata(const std::string& key, const std::string& value);
 
+  /// \brief Sets the names of the objects which were omitted from this collection because they did not change.
+  /// A collection with a non-empty list is partial, the receiver should keep using its previous versions of these objects.
+  void setUnchangedObjects(std::vector<std::string> names);
+  const std::vector<std::string>& getUnchangedObjects() const;
+
   MergeInterface* cloneMovingWindow() const override;
 
+  /// \brief The merges which produced this collection, per class of the merged objects.
+  /// It includes the merges done earlier on the collections merged into this one, e.g. in the lower Merger layers.
+  /// The statistics are totals since the collection was created, see getNewMergeStatistics.
+  const std::vector<MergeStatistics>& getMergeStatistics() const;
+
  private:
+  void recordMerge(const std::string& className, bool fastMerge, double durationMs);
+
+  void addToIndex(TObject* obj);
+  void invalidateIndex();
+  void buildIndex() const;
+  TObject* slotContent(Int_t idx) const;
+
   std::string mDetector = "TST";
   std::string mTaskName = "Test";
+  std::vector<std::string> mUnchangedObjects;
+  std::vector<MergeStatistics> mMergeStatistics;
+
+  mutable std::unordered_map<std::string, TObject*> mIndex; //! name -> object
+  mutable bool mIndexValid = false;                        //!
 
-  ClassDefOverride(MonitorObjectCollection, 3);
+  ClassDefOverride(MonitorObjectCollection, 6);
 };
 
 } // namespace o2::quality_control::core
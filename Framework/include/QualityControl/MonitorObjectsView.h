@@ -0,0 +1,102 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   MonitorObjectsView.h
+///
+
+#ifndef QC_CORE_MONITOROBJECTSVIEW_H
+#define QC_CORE_MONITOROBJECTSVIEW_H
+
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace o2::quality_control::core
+{
+
+class MonitorObject;
+
+/// \brief Non-owning, read-only view over a set of named MonitorObjects, sorted by their names.
+///
+/// It refers to the entries of a map owned by someone else (e.g. the cache of a CheckRunner), thus it must not outlive
+/// the map and the map must not be modified while the view is used. Iterating over the view yields the same
+/// name-object pairs as iterating over the map, so it can be used the same way:
+/// \code{.cpp}
+/// for (const auto& [name, mo] : view) {
+///   // ...
+/// }
+/// \endcode
+class MonitorObjectsView
+{
+ public:
+  using Entry = std::map<std::string, std::shared_ptr<MonitorObject>>::value_type;
+
+  class Iterator
+  {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Entry;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Entry*;
+    using reference = const Entry&;
+
+    Iterator() = default;
+    explicit Iterator(const Entry* const* position) : mPosition(position) {}
+
+    reference operator*() const { return **mPosition; }
+    pointer operator->() const { return *mPosition; }
+    Iterator& operator++()
+    {
+      ++mPosition;
+      return *this;
+    }
+    Iterator operator++(int)
+    {
+      auto previous = *this;
+      ++mPosition;
+      return previous;
+    }
+    bool operator==(const Iterator&) const = default;
+
+   private:
+    const Entry* const* mPosition = nullptr;
+  };
+
+  MonitorObjectsView() = default;
+  /// \param entries Pointers to the map entries to be viewed, they must be sorted by name.
+  explicit MonitorObjectsView(std::span<const Entry* const> entries) : mEntries(entries) {}
+
+  Iterator begin() const { return Iterator{ mEntries.data() }; }
+  Iterator end() const { return Iterator{ mEntries.data() + mEntries.size() }; }
+  size_t size() const { return mEntries.size(); }
+  bool empty() const { return mEntries.empty(); }
+
+  /// \brief Returns the MonitorObject with the given full name (i.e. <task_name>/<mo name>) or nullptr if not in the view.
+  MonitorObject* get(std::string_view name) const;
+
+  /// \brief Returns a view of the entries [offset, offset + count).
+  MonitorObjectsView subview(size_t offset, size_t count) const { return MonitorObjectsView{ mEntries.subspan(offset, count) }; }
+
+  /// \brief Copies the viewed entries into a map, for the interfaces which still need one.
+  std::map<std::string, std::shared_ptr<MonitorObject>> toMap() const;
+
+ private:
+  std::span<const Entry* const> mEntries;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_MONITOROBJECTSVIEW_H
@@ -39,6 +39,13 @@ constexpr auto qcCheckName = "qc_check_name";
 constexpr auto qcAdjustableEOV = "adjustableEOV"; // this is a keyword for the CCDB
 constexpr auto cycleNumber = "CycleNumber";
 
+// Latency tracing, timestamps in ms since epoch
+constexpr auto traceFirstData = "qc_trace_first_data";
+constexpr auto traceCycleEnd = "qc_trace_cycle_end";
+constexpr auto traceSnapshot = "qc_trace_snapshot";
+constexpr auto traceCheckRunnerInput = "qc_trace_checkrunner_input";
+constexpr auto traceCheckDone = "qc_trace_check_done";
+
 // QC Activity
 constexpr auto runType = "RunType";
 constexpr auto runNumber = "RunNumber";
@@ -23,7 +23,11 @@
 #include "QualityControl/MonitorObjectCollection.h"
 #include <Mergers/Mergeable.h>
 // stl
+#include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class TObject;
 
@@ -131,6 +135,23 @@ class ObjectsManager
 
   MonitorObjectCollection* getNonOwningArray() const;
 
+  /**
+   * \brief Returns a collection of the objects which changed since the previous call.
+   * Works as getNonOwningArray(), but histograms and counter arrays whose content did not change since they were
+   * returned the last time are omitted and listed as unchanged in the collection. The contents are compared with
+   * a hash of their bins, so the cost is proportional to the number of bins.
+   * Objects of other types, including trees, are always considered as changed.
+   * @return A new collection which does not own the objects, it must be deleted by the caller.
+   */
+  MonitorObjectCollection* getNonOwningArrayOfChangedObjects();
+
+  /**
+   * \brief Informs that the task has reset its objects.
+   * The objects are then compared to their state after the reset, so that any entry added after the reset is published,
+   * even if the new content is identical to the one published before the reset.
+   */
+  void notifyObjectsReset();
+
   /**
    * \brief Add metadata to a MonitorObject.
    * Add a metadata pair to a MonitorObject. This is propagated to the database.
@@ -208,21 +229,63 @@ class ObjectsManager
   void updateValidity(validity_time_t);
 
   const Activity& getActivity() const;
+  /// \brief Sets the activity of all the registered objects.
+  /// It also forgets which objects were already published, so that the first publication in a new activity is complete.
   void setActivity(const Activity& activity);
 
   void setMovingWindowsList(const std::vector<std::string>&);
   const std::vector<std::string>& getMovingWindowsList() const;
 
+  /// \brief Sets the number of workers which fill the published objects concurrently, see getShard().
+  /// Each worker but the first one gets its own copy (shard) of each published histogram or counter array.
+  /// 1 (default) disables the shards.
+  void setNumberOfShards(size_t);
+  size_t getNumberOfShards() const;
+
+  /**
+   * \brief Returns the copy of a published object which belongs to a worker.
+   * Worker 0 uses the published object itself. The shards are created when the object starts being published, thus
+   * this method can be called concurrently by the workers. Their contents are added to the published objects and reset
+   * in mergeShards().
+   * @param obj The published object.
+   * @param worker Index of the worker, smaller than getNumberOfShards().
+   * @throw ObjectNotFoundError if the object has no shards, e.g. it is not published or its type is not supported.
+   */
+  template <typename T>
+  T* getShard(T* obj, size_t worker)
+  {
+    return static_cast<T*>(getShardImpl(obj, worker));
+  }
+
+  /// \brief Merges the contents of the shards into the published objects and resets the shards.
+  void mergeShards();
+
  private:
+  /// a cheap summary of an object content, used to detect that it did not change between two publications
+  struct ChangeMarker {
+    double entries = 0;
+    double sumOfWeights = 0;
+    size_t contentHash = 0; // of the bins or counters
+    bool operator==(const ChangeMarker&) const = default;
+  };
+  static std::optional<ChangeMarker> computeChangeMarker(const TObject* obj);
+
   std::unique_ptr<MonitorObjectCollection> mMonitorObjects;
   std::map<MonitorObject*, PublicationPolicy> mPublicationPoliciesForMOs;
+  std::unordered_map<const MonitorObject*, ChangeMarker> mLastPublishedMarkers;
   std::string mTaskName;
   std::string mTaskClass;
   std::string mDetectorName;
   Activity mActivity;
   std::vector<std::string> mMovingWindowsList;
 
+  // objects which are filled by several workers, each but the first one has a copy
+  std::unordered_map<TObject*, std::vector<std::unique_ptr<TObject>>> mShards;
+  size_t mNumberOfShards = 1;
+
   void startPublishingImpl(TObject* obj, PublicationPolicy, bool ignoreMergeableWarning);
+  void createShards(TObject* obj);
+  TObject* getShardImpl(TObject* obj, size_t worker);
 };
 
 } // namespace o2::quality_control::core
@@ -43,6 +43,10 @@ struct PostProcessingConfig : public o2::quality_control::core::UserCodeConfig {
   core::Activity activity;
   bool matchAnyRunNumber = false;
   bool validityFromLastTriggerOnly = false;
+  size_t backfillWorkers = 1; // threads which may be used by PostProcessingInterface::backfill, 1 disables backfilling
+  bool eventDrivenTriggers = false; // evaluates the triggers in the background, see TriggerQueue
+  double triggerBackoffInitialSeconds = 1.0;
+  double triggerBackoffMaxSeconds = 10.0;
 };
 
 } // namespace o2::quality_control::postprocessing
@@ -17,13 +17,20 @@
 #ifndef QUALITYCONTROL_POSTPROCESSINTERFACE_H
 #define QUALITYCONTROL_POSTPROCESSINTERFACE_H
 
+#include <functional>
 #include <string>
+#include <vector>
 #include <boost/property_tree/ptree_fwd.hpp>
 #include "QualityControl/Triggers.h"
 #include "QualityControl/ObjectsManager.h"
 #include "QualityControl/UserCodeInterface.h"
 #include <Framework/ServiceRegistryRef.h>
 
+namespace o2::monitoring
+{
+class Monitoring;
+}
+
 namespace o2::quality_control::postprocessing
 {
 
@@ -72,12 +79,34 @@ class PostProcessingInterface : public core::UserCodeInterface
   /// \param services Interface containing optional interfaces, for example DatabaseInterface
   virtual void finalize(Trigger trigger, framework::ServiceRegistryRef services) = 0;
 
+  /// \brief Update of a post-processing task with a sequence of triggers known in advance.
+  /// Called instead of update() when past objects are reprocessed (runOverTimestamps, ForEachObject, ForEachLatest),
+  /// "backfillWorkers" is larger than 1 and supportsBackfill() returns true. The objects are then published once
+  /// after all the triggers. The default implementation calls update() for each trigger in order.
+  /// Tasks whose updates do not depend on each other, apart from the order of their results, may override it
+  /// to process the triggers in parallel with processInParallel().
+  /// \param triggers Triggers in the order in which update() would have been called
+  /// \param services Interface containing optional interfaces, for example DatabaseInterface
+  /// \param workers  Number of threads which may be used
+  virtual void backfill(const std::vector<Trigger>& triggers, framework::ServiceRegistryRef services, size_t workers);
+  /// \brief Tells whether the runner may call backfill() instead of update().
+  /// Tasks should return true only if publishing their objects once after all the triggers is enough, e.g. because
+  /// they accumulate the results of all the triggers. Other tasks are updated and published after each trigger.
+  virtual bool supportsBackfill() const { return false; }
+
   void setObjectsManager(std::shared_ptr<core::ObjectsManager> objectsManager);
+  void setMonitoring(const std::shared_ptr<o2::monitoring::Monitoring>& monitoring);
   void setID(const std::string& id);
   [[nodiscard]] const std::string& getID() const;
 
  protected:
   std::shared_ptr<core::ObjectsManager> getObjectsManager();
+  /// \brief Calls process(trigger, worker) for each trigger index on the given number of threads.
+  /// process should return false if the trigger could not be fully processed. The results are expected to be kept
+  /// per trigger and appended by the caller in the order of the triggers afterwards. The progress is logged regularly,
+  /// the throughput is logged and sent as the metric qc_postprocessing_backfill at the end.
+  void processInParallel(const std::vector<Trigger>& triggers, size_t workers, const std::function<bool(size_t trigger, size_t worker)>& process);
+  std::shared_ptr<o2::monitoring::Monitoring> mMonitoring; // nullptr if the monitoring is not configured
 
  private:
   std::string mID;
@@ -17,6 +17,7 @@
 #ifndef QUALITYCONTROL_POSTPROCESSINGRUNNER_H
 #define QUALITYCONTROL_POSTPROCESSINGRUNNER_H
 
+#include <chrono>
 #include <memory>
 #include <functional>
 #include <boost/property_tree/ptree_fwd.hpp>
@@ -25,6 +26,7 @@
 #include "QualityControl/PostProcessingInterface.h"
 #include "QualityControl/PostProcessingRunnerConfig.h"
 #include "QualityControl/Triggers.h"
+#include "QualityControl/TriggerQueue.h"
 #include "QualityControl/Activity.h"
 #include "QualityControl/DatabaseInterface.h"
 #include "WorkflowType.h"
@@ -47,6 +49,11 @@ namespace o2::quality_control::repository
 class DatabaseInterface;
 }
 
+namespace o2::monitoring
+{
+class Monitoring;
+}
+
 namespace o2::quality_control::postprocessing
 {
 
@@ -81,6 +88,8 @@ class PostProcessingRunner
   ///
   /// \param t A vector with timestamps (ms since epoch).
   ///          The first is used for task initialisation, the last for task finalisation, so at least two are required.
+  ///          If "backfillWorkers" is larger than 1 and the task supports it, the intermediate timestamps are passed
+  ///          at once to PostProcessingInterface::backfill.
   void runOverTimestamps(const std::vector<uint64_t>& t);
 
   /// \brief Set how objects should be published. If not used, objects will be stored in repository.
@@ -88,15 +97,32 @@ class PostProcessingRunner
   /// \param callback MonitorObjectCollection publication callback
   void setPublicationCallback(MOCPublicationCallback callback);
 
+  /// \brief Returns true if the triggers are evaluated in the background (see PostProcessingConfig::eventDrivenTriggers)
+  bool hasTriggerQueue() const { return mTriggerQueue != nullptr; }
+  /// \brief Waits until a trigger fires or the timeout passes. Requires the triggers to be evaluated in the background.
+  void waitForTrigger(std::chrono::milliseconds timeout);
+
   const std::string& getID() const;
 
   static PostProcessingRunnerConfig extractConfig(const core::CommonSpec& commonSpec, const PostProcessingTaskSpec& ppTaskSpec);
 
  private:
+  /// sets the trigger functions of the group, which are evaluated in the background if the trigger queue is used
+  void setTriggers(TriggerQueue::Group group, std::vector<TriggerFcn> triggerFcns);
+  /// returns a trigger of the group which fired, waiting up to the timeout for it only if the trigger queue is used
+  Trigger tryTrigger(TriggerQueue::Group group, std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+  bool isExhausted(TriggerQueue::Group group);
+  std::vector<TriggerFcn>& getTriggers(TriggerQueue::Group group);
   void updateValidity(const Trigger& trigger);
   void doInitialize(const Trigger& trigger);
   void doUpdate(const Trigger& trigger);
+  /// updates the task with all the triggers at once, see PostProcessingInterface::backfill
+  void doBackfill(const std::vector<Trigger>& triggers);
+  /// collects the remaining triggers of the objects being iterated over and backfills the task with them
+  void backfillIteratedObjects(Trigger first);
+  void publishUpdate();
   void doFinalize(const Trigger& trigger);
+  void sendMonitoring();
 
   enum class TaskState {
     INVALID,
@@ -108,6 +134,7 @@ class PostProcessingRunner
   std::vector<TriggerFcn> mInitTriggers;
   std::vector<TriggerFcn> mUpdateTriggers;
   std::vector<TriggerFcn> mStopTriggers;
+  std::unique_ptr<TriggerQueue> mTriggerQueue; // replaces the trigger vectors above if used
 
   std::unique_ptr<PostProcessingInterface> mTask;
   framework::ServiceRegistry mServices;
@@ -121,10 +148,12 @@ class PostProcessingRunner
   PostProcessingRunnerConfig mRunnerConfig;
   std::shared_ptr<o2::quality_control::repository::DatabaseInterface> mSourceDatabase;
   std::shared_ptr<o2::quality_control::repository::DatabaseInterface> mDestinationDatabase;
+  std::shared_ptr<o2::monitoring::Monitoring> mCollector;
   std::unique_ptr<repository::DatabaseInterface> configureDatabase(std::unordered_map<std::string, std::string>& dbConfig, const std::string& name);
 };
 
 MOCPublicationCallback publishToDPL(o2::framework::DataAllocator&, std::string outputBinding);
+/// \brief Stores the objects in the repository. They are copied only if the repository does not store them synchronously.
 MOCPublicationCallback publishToRepository(o2::quality_control::repository::DatabaseInterface&);
 
 } // namespace o2::quality_control::postprocessing
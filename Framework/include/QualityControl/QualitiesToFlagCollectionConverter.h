@@ -20,10 +20,10 @@
 #include <DataFormatsQualityControl/QualityControlFlag.h>
 #include <DataFormatsQualityControl/QualityControlFlagCollection.h>
 #include <QualityControl/ValidityInterval.h>
+#include <QualityControl/FlagIntervalBuffer.h>
 
 #include <memory>
 #include <vector>
-#include <functional>
 
 namespace o2::quality_control::core
 {
@@ -44,9 +44,20 @@ class QualitiesToFlagCollectionConverter
   /// \brief Moves the final FlagCollection out and resets the converter.
   std::unique_ptr<QualityControlFlagCollection> getResult();
 
+  /// \brief Moves out the flags which cannot be modified anymore by QOs starting at or after the watermark.
+  ///
+  /// These are the flags which end before the watermark, since flags are merged or trimmed only by overlapping or
+  /// adjacent ones. As long as the following QOs do not start before the watermark, the flags returned by all the calls
+  /// and by the final getResult() together are the same as the ones which getResult() alone would return.
+  /// A warning is logged for the first QO which starts before the latest watermark.
+  std::unique_ptr<QualityControlFlagCollection> takeFinalizedFlags(validity_time_t watermark);
+
   size_t getQOsIncluded() const;
   size_t getWorseThanGoodQOs() const;
   int getRunNumber() const;
+  /// \brief Returns the latest start of validity among the QOs received since the last getResult()
+  validity_time_t getNewestQOStart() const { return mNewestQOStart; }
+  size_t getBufferedFlags() const { return mFlagBuffer.size(); }
 
   /// Sets the provided validity interval, trims affected flags and fills extensions with UnknownQuality
   void updateValidityInterval(const ValidityInterval validityInterval);
@@ -55,23 +66,21 @@ class QualitiesToFlagCollectionConverter
   /// \brief inserts the provided flag to the buffer, takes care of merging and trimming
   void insert(QualityControlFlag&& flag);
 
-  /// \brief trims all buffered flags which match the predicate using the provided interval
-  void trimBufferWithInterval(
-    ValidityInterval interval,
-    const std::function<bool(const QualityControlFlag&)>& predicate = [](const auto&) { return true; });
+  /// \brief trims all buffered UnknownQuality flags with the provided interval
+  void trimUnknownQualityWithInterval(ValidityInterval interval);
 
-  /// \brief trims the provided flag with all buffered flags which match the predicate
-  ///
-  /// The result is a vector, because a flag interval split in the middle becomes two flags.
-  std::vector<QualityControlFlag> trimFlagAgainstBuffer(
-    const QualityControlFlag& newFlag,
-    const std::function<bool(const QualityControlFlag&)>& predicate = [](const auto&) { return true; });
+  /// \brief inserts the parts of the UnknownQuality interval which are not covered by any other type of buffered flag
+  void insertUnknownQualityNotCovered(FlagIntervalBuffer::Kind kind, ValidityInterval interval);
 
   std::string mQOPath; // this is only to indicate what is the missing Quality in QC Flag
   std::unique_ptr<QualityControlFlagCollection> mConverted;
-  std::set<QualityControlFlag> mFlagBuffer;
+  FlagIntervalBuffer mFlagBuffer;
+  FlagIntervalBuffer::Kind mNoQOKind;
   size_t mQOsIncluded = 0;
   size_t mWorseThanGoodQOs = 0;
+  validity_time_t mNewestQOStart = 0;
+  validity_time_t mFinalizedWatermark = 0; // the flags ending before it were already taken out
+  bool mReportedLateQO = false;
 };
 
 } // namespace o2::quality_control::core
@@ -17,8 +17,11 @@
 #ifndef QUALITYCONTROL_REDUCTORHELPERS_H
 #define QUALITYCONTROL_REDUCTORHELPERS_H
 
+#include <memory>
 #include <string>
 
+class TObject;
+
 namespace o2::quality_control
 {
 namespace postprocessing
@@ -46,6 +49,10 @@ namespace implementation
 bool updateReductorImpl(Reductor* r, const Trigger& t, const std::string& path, const std::string& name, const std::string& type,
                         repository::DatabaseInterface& qcdb, core::ConditionAccess& ccdbAccess);
 
+/// \brief implementation details of retrieveReductorInput, hiding some header inclusions
+std::shared_ptr<TObject> retrieveReductorInputImpl(const Trigger& t, const std::string& path, const std::string& name, const std::string& type,
+                                                   repository::DatabaseInterface& qcdb);
+
 } // namespace implementation
 
 /// \brief Updates the provided Reductor with implementation-specific procedures
@@ -67,5 +74,24 @@ bool updateReductor(Reductor* r, const Trigger& t, const DataSourceT& ds, reposi
   return implementation::updateReductorImpl(r, t, path, name, type, qcdb, ccdbAccess);
 }
 
+/// \brief Retrieves the object which should be reduced for a data source of type "repository" or "repository-quality"
+///
+/// It allows for retrieving the inputs of several reductors in parallel and reducing them later with
+/// updateReductorWithInput.
+/// \return the retrieved object (a QualityObject or the object inside a MonitorObject) or nullptr if it could not be
+/// found or the type of data source is different.
+template <typename DataSourceT>
+std::shared_ptr<TObject> retrieveReductorInput(const Trigger& t, const DataSourceT& ds, repository::DatabaseInterface& qcdb)
+{
+  return implementation::retrieveReductorInputImpl(t, ds.path, ds.name, ds.type, qcdb);
+}
+
+/// \brief Returns true if the inputs of the data source are retrieved from QCDB with retrieveReductorInput.
+bool isRepositoryDataSourceType(const std::string& type);
+
+/// \brief Updates the provided Reductor with an object obtained with retrieveReductorInput
+/// \return bool value indicating the success or failure in reducing an object
+bool updateReductorWithInput(Reductor* r, TObject* input);
+
 } // namespace o2::quality_control::postprocessing::reductor_helpers
 #endif // QUALITYCONTROL_REDUCTORHELPERS_H
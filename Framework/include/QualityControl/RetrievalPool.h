@@ -0,0 +1,74 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   RetrievalPool.h
+///
+
+#ifndef QC_REPOSITORY_RETRIEVALPOOL_H
+#define QC_REPOSITORY_RETRIEVALPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TObject;
+
+namespace o2::quality_control::repository
+{
+
+class DatabaseInterface;
+
+/// \brief Runs database retrievals in a bounded number of background threads.
+///
+/// Each thread uses its own copy of the database (see DatabaseInterface::clone()), so that the implementations do not
+/// have to be thread-safe. If only one thread is requested or the database cannot be copied, the retrievals are
+/// executed directly in submit() with the original database.
+class RetrievalPool
+{
+ public:
+  using Retrieval = std::function<std::shared_ptr<TObject>(DatabaseInterface&)>;
+
+  RetrievalPool(DatabaseInterface& database, size_t parallelism);
+  ~RetrievalPool();
+
+  /// \brief Schedules the retrieval, the returned future provides its result or rethrows its exception.
+  std::shared_future<std::shared_ptr<TObject>> submit(Retrieval retrieval);
+
+  /// \brief Blocks until at least one of the retrievals is finished and returns its index in the vector.
+  /// The futures have to be returned by submit() of this pool and the vector must not be empty.
+  size_t waitForAny(const std::vector<std::shared_future<std::shared_ptr<TObject>>>& retrievals);
+
+  /// \brief Returns the number of retrievals which may be executed at the same time.
+  size_t getParallelism() const { return mWorkers.empty() ? 1 : mWorkers.size(); }
+
+ private:
+  void workerLoop(DatabaseInterface& database);
+
+  DatabaseInterface& mDatabase;
+  std::vector<std::unique_ptr<DatabaseInterface>> mWorkerDatabases;
+  std::vector<std::thread> mWorkers;
+
+  std::mutex mMutex;
+  std::condition_variable mCondition;           // signals new retrievals or stopping
+  std::condition_variable mCompletionCondition; // signals that a retrieval is finished
+  std::deque<std::packaged_task<std::shared_ptr<TObject>(DatabaseInterface&)>> mQueue;
+  bool mStopping = false;
+};
+
+} // namespace o2::quality_control::repository
+
+#endif // QC_REPOSITORY_RETRIEVALPOOL_H
@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <optional>
 
 namespace o2::quality_control::core
 {
@@ -40,8 +41,12 @@ class RootFileSource : public framework::Task
   void run(framework::ProcessingContext& pctx) override;
 
   static framework::OutputLabel outputBinding(const std::string& detectorCode, const std::string& taskName, bool movingWindow = false);
+  /// \brief Deduces the output binding of a MonitorObjectCollection from its path in the file, without reading it.
+  static std::optional<framework::OutputLabel> outputBindingFromPath(const std::string& path, bool movingWindow = false);
 
  private:
+  bool isAllowed(const std::optional<framework::OutputLabel>& binding) const;
+
   std::string mFilePath;
   std::vector<framework::OutputLabel> mAllowedOutputs;
 
@@ -18,6 +18,7 @@
 #define QUALITYCONTROL_ROOTFILESTORAGE_H
 
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <map>
 #include <variant>
@@ -39,6 +40,7 @@ class RootFileStorage
     std::string fullPath{};
     std::string name{};
     MonitorObjectCollection* moc = nullptr;
+    std::optional<uint64_t> validFrom = {}; // known only for moving windows, which are named after it
   };
   struct DirectoryNode {
     std::string fullPath{};
@@ -54,6 +56,9 @@ class RootFileStorage
   explicit RootFileStorage(const std::string& filePath, ReadMode);
   ~RootFileStorage();
 
+  /// \brief Reads the directory structure of the file.
+  ///
+  /// If loadObjects is false, the MonitorObjectCollections are not read, the nodes contain only what their TKeys tell.
   DirectoryNode readStructure(bool loadObjects = false) const;
   MonitorObjectCollection* readMonitorObjectCollection(const std::string& path) const;
 
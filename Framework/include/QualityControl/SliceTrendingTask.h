@@ -63,6 +63,10 @@ class SliceTrendingTask : public PostProcessingInterface
   void initialize(Trigger, framework::ServiceRegistryRef) final;
   void update(Trigger, framework::ServiceRegistryRef) final;
   void finalize(Trigger, framework::ServiceRegistryRef) final;
+  /// \brief Retrieves and slices the inputs of the triggers in parallel, then fills the trend in their order.
+  /// Falls back to updating sequentially if any data source is not a repository or the database cannot be copied.
+  void backfill(const std::vector<Trigger>&, framework::ServiceRegistryRef, size_t workers) final;
+  bool supportsBackfill() const final { return true; }
 
  private:
   static constexpr size_t MaxRunNumberStringLength = 6;
@@ -82,8 +86,11 @@ class SliceTrendingTask : public PostProcessingInterface
   };
 
   /// \brief Methods specific to the trending itself.
+  void setEntryTime(const Trigger& t, UInt_t& time, MetaData& metaData) const;
   void trendValues(const Trigger& t, o2::quality_control::repository::DatabaseInterface&);
   void generatePlots();
+  /// appends the entry filled last to the graphs of a plot vs time or run, returns false if the plot has to be drawn again
+  bool appendToPlot(const SliceTrendingTaskConfig::Plot& plot);
   void drawCanvasMO(TCanvas* thisCanvas, const std::string& var,
                     const std::string& name, const std::string& opt, const std::string& err, const std::vector<std::vector<float>>& axis, const std::vector<std::vector<std::string>>& sliceLabels, const TitleSettings& titlesettings);
   void getUserAxisRange(const std::string& graphAxisRange, float& limitLow, float& limitUp);
@@ -102,6 +109,7 @@ class SliceTrendingTask : public PostProcessingInterface
   UInt_t mTime;
   std::unique_ptr<TTree> mTrend;
   std::map<std::string, TObject*> mPlots;
+  std::unordered_map<std::string, Long64_t> mPlottedEntries; // the number of trend entries in each plot
   std::unordered_map<std::string, std::unique_ptr<SliceReductor>> mReductors;
   std::unordered_map<std::string, std::vector<SliceInfo>*> mSources;
   std::unordered_map<std::string, int> mNumberPads;
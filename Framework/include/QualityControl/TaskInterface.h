@@ -18,6 +18,7 @@
 #ifndef QC_CORE_TASKINTERFACE_H
 #define QC_CORE_TASKINTERFACE_H
 
+#include <functional>
 #include <memory>
 // O2
 #include <Framework/InitContext.h>
@@ -45,6 +46,8 @@ struct ConcreteDataMatcher;
 namespace o2::quality_control::core
 {
 
+class WorkerPool;
+
 /// \brief  Skeleton of a QC task.
 ///
 /// Purely abstract class defining the skeleton and the common interface of a QC task.
@@ -96,14 +99,23 @@ class TaskInterface : public UserCodeInterface
   void setMonitoring(const std::shared_ptr<o2::monitoring::Monitoring>& mMonitoring);
   void setGlobalTrackingDataRequest(std::shared_ptr<o2::globaltracking::DataRequest>);
   const o2::globaltracking::DataRequest* getGlobalTrackingDataRequest() const;
+  void setWorkerPool(std::shared_ptr<WorkerPool> workerPool);
 
  protected:
   std::shared_ptr<ObjectsManager> getObjectsManager();
   std::shared_ptr<o2::monitoring::Monitoring> mMonitoring;
 
+  /// \brief Returns the number of workers available to parallelFor(), as configured with "parallelWorkers".
+  size_t getNumberOfWorkers() const;
+  /// \brief Calls work(item, worker) for each item in [0, nItems), concurrently if the task has several workers.
+  /// It returns once all the items are processed and rethrows the first exception thrown by work.
+  /// The objects filled by work must be the shards of the worker, see ObjectsManager::getShard().
+  void parallelFor(size_t nItems, const std::function<void(size_t item, size_t worker)>& work);
+
  private:
   std::shared_ptr<ObjectsManager> mObjectsManager;
   std::shared_ptr<o2::globaltracking::DataRequest> mGlobalTrackingDataRequest;
+  std::shared_ptr<WorkerPool> mWorkerPool;
 };
 
 } // namespace o2::quality_control::core
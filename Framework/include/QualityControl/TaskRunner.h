@@ -126,6 +126,8 @@ class TaskRunner : public framework::Task
   void endOfActivity();
   void startCycle();
   void finishCycle(framework::DataAllocator& outputs);
+  /// \brief Adds the objects filled by the parallel workers of the task to the published ones
+  void mergeShards();
   int publish(framework::DataAllocator& outputs);
   void publishCycleStats();
   void saveToFile();
@@ -151,6 +153,9 @@ class TaskRunner : public framework::Task
   int mNumberObjectsPublishedInCycle = 0;
   int mTotalNumberObjectsPublished = 0; // over a run
   double mLastPublicationDuration = 0;
+  double mLastShardsMergeDuration = 0;
+  uint64_t mCycleFirstDataTimestamp = 0; // for the latency tracing, 0 until data is received in the cycle
+  uint64_t mCycleEndTimestamp = 0;
   uint64_t mDataReceivedInCycle = 0;
   AliceO2::Common::Timer mTimerTotalDurationActivity;
   AliceO2::Common::Timer mTimerDurationCycle;
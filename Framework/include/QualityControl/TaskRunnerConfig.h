@@ -59,6 +59,9 @@ struct TaskRunnerConfig : public UserCodeConfig {
   std::shared_ptr<o2::globaltracking::DataRequest> globalTrackingDataRequest;
   std::vector<std::string> movingWindows;
   bool disableLastCycle = false;
+  bool publishChangedObjectsOnly = false; // objects which did not change since the last cycle are not sent
+  size_t parallelWorkers = 1;             // number of threads which may execute TaskInterface::parallelFor
+  bool latencyTracing = false;            // the published objects are stamped with the times of the cycle stages
 };
 
 } // namespace o2::quality_control::core
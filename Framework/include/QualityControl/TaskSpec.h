@@ -77,6 +77,8 @@ struct TaskSpec {
   GlobalTrackingDataRequestSpec globalTrackingDataRequest;
   std::vector<std::string> movingWindows;
   bool disableLastCycle = false;
+  bool publishChangedObjectsOnly = false;
+  size_t parallelWorkers = 1;
 };
 
 } // namespace o2::quality_control::core
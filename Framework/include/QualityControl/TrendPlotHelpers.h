@@ -0,0 +1,47 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    TrendPlotHelpers.h
+///
+
+#ifndef QUALITYCONTROL_TRENDPLOTHELPERS_H
+#define QUALITYCONTROL_TRENDPLOTHELPERS_H
+
+#include <span>
+#include <string>
+#include <vector>
+
+class TGraph;
+class TH1;
+
+namespace o2::quality_control::postprocessing::trend_plot_helpers
+{
+
+/// \brief Splits a TTree::Draw varexp such as "a.mean:time" into its expressions. "::" does not split.
+std::vector<std::string> splitVarexp(const std::string& varexp);
+
+/// \brief Appends points to a graph which is already drawn, without resetting its axes.
+///
+/// If the graph is a TGraphErrors and the errors are provided, they are set as well.
+/// All the provided spans should have the same size.
+void appendPoints(TGraph* graph, std::span<const double> x, std::span<const double> y,
+                  std::span<const double> ex = {}, std::span<const double> ey = {});
+
+/// \brief Tells if the points fit in the axes ranges of the histogram used to draw the graph axes.
+///
+/// \param checkX if false, the x coordinates are not checked (e.g. when the range is set by the user)
+/// \param checkY if false, the y coordinates are not checked
+bool fitInFrame(const TH1* frame, std::span<const double> x, std::span<const double> y, bool checkX = true, bool checkY = true);
+
+} // namespace o2::quality_control::postprocessing::trend_plot_helpers
+
+#endif // QUALITYCONTROL_TRENDPLOTHELPERS_H
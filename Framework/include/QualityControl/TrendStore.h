@@ -0,0 +1,121 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   TrendStore.h
+///
+
+#ifndef QUALITYCONTROL_TRENDSTORE_H
+#define QUALITYCONTROL_TRENDSTORE_H
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <TTree.h>
+
+namespace o2::quality_control::postprocessing
+{
+
+/// \brief Append-only storage of trended values, split into chunks of a fixed number of entries.
+///
+/// The values are filled from the addresses registered with addBranch(), in the same way as in a TTree. They are kept
+/// in three forms:
+/// - a TTree with all the entries, used to draw expressions with TTree::Draw,
+/// - the tail, a TTree with the entries of the last, incomplete chunk, which is the only one which has to be stored
+///   again when new values are added (the same TTree as the previous one if there are no chunks),
+/// - numeric columns, one per scalar leaf or array element, which can be read directly as contiguous arrays.
+///
+/// The chunks bound the size of the uploads, not the memory: all the entries are kept in memory, both in the TTree
+/// and as columns, since plots are drawn from the whole trend.
+///
+/// When the tail reaches the chunk size, it becomes sealed: it is handed over once with takeNewlySealedChunks(), so
+/// it can be stored under its own name (see getChunkName()), and a new tail is started. A trend stored this way can
+/// be restored by loading its sealed chunks in order and then its tail.
+class TrendStore
+{
+ public:
+  /// Metadata key which tells how many sealed chunks precede the stored tail.
+  static constexpr auto SealedChunksMetadataKey = "TrendSealedChunks";
+
+  /// \param name the name of the trend, also used for the tail and as a prefix of the sealed chunks
+  /// \param chunkSize the number of entries in a chunk, 0 disables sealing (the tail contains the whole trend)
+  TrendStore(std::string name, size_t chunkSize);
+  ~TrendStore() = default;
+
+  /// \brief Declares a branch, as TTree::Branch(name, address, leafList). All branches have to be declared before
+  /// anything is filled or loaded.
+  ///
+  /// Numeric leaves with fixed dimensions become columns named "branch.leaf" and "branch.leaf[i]" (or "branch" and
+  /// "branch[i]" if the branch has only one leaf). Leaves which follow a string or a variable-size array cannot be
+  /// located in memory, thus they are not available as columns.
+  void addBranch(const std::string& name, void* address, const std::string& leafList);
+
+  /// \brief Appends the values currently present at the addresses of the branches.
+  void fill();
+  /// \brief Removes all the entries and the sealed chunks, the tail object remains the same.
+  void reset();
+
+  /// \brief Appends the entries of a sealed chunk retrieved from a repository. They are not added to the tail.
+  void loadSealedChunk(TTree& chunk);
+  /// \brief Appends the entries of a tail retrieved from a repository as if they were filled.
+  /// If the tail is longer than the chunk size (e.g. a trend stored as one TTree), it is split into sealed chunks.
+  void loadTail(TTree& tail);
+
+  Long64_t getEntries() const;
+  /// \brief Returns a TTree with all the entries.
+  TTree* getTree() const { return mTree.get(); }
+  /// \brief Returns a TTree with the entries of the last, incomplete chunk. It is replaced when the chunk is sealed.
+  TTree* getTail() const { return mTail != nullptr ? mTail.get() : mTree.get(); }
+  /// \brief Returns the number of sealed chunks which precede the tail.
+  size_t getNumberOfSealedChunks() const { return mNumberOfSealedChunks; }
+  /// \brief Passes the ownership of the chunks sealed since the last call.
+  std::vector<std::unique_ptr<TTree>> takeNewlySealedChunks();
+
+  /// \brief Returns the values of a column for all the entries, or nothing if there is no column with such name.
+  std::optional<std::span<const double>> getColumn(std::string_view name) const;
+
+  static std::string getChunkName(const std::string& trendName, size_t index);
+
+ private:
+  struct Branch {
+    std::string name;
+    void* address;
+    std::string leafList;
+  };
+  struct ColumnSource {
+    const char* address;
+    char type;
+  };
+
+  std::unique_ptr<TTree> createTree(const std::string& name) const;
+  void appendColumns();
+  void loadEntries(TTree& source, bool asNewEntries);
+
+  std::string mName;
+  size_t mChunkSize;
+  size_t mNumberOfSealedChunks = 0;
+  std::vector<Branch> mBranches;
+  std::unique_ptr<TTree> mTree;
+  std::unique_ptr<TTree> mTail; // nullptr if the trend is not split into chunks
+  std::vector<std::unique_ptr<TTree>> mNewlySealedChunks;
+  std::vector<ColumnSource> mColumnSources;
+  std::vector<std::vector<double>> mColumns;
+  std::unordered_map<std::string, size_t> mColumnIndices; // column name -> index in mColumns
+};
+
+} // namespace o2::quality_control::postprocessing
+
+#endif // QUALITYCONTROL_TRENDSTORE_H
@@ -20,13 +20,22 @@
 #include "QualityControl/PostProcessingInterface.h"
 #include "QualityControl/Reductor.h"
 #include "QualityControl/TrendingTaskConfig.h"
+#include "QualityControl/RetrievalPool.h"
+#include "QualityControl/TrendStore.h"
 
+#include <future>
 #include <memory>
+#include <optional>
+#include <span>
 #include <unordered_map>
 #include <TTree.h>
+#include <TTreeFormula.h>
 
 class TAxis;
 class TCanvas;
+class TGraph;
+class TGraphErrors;
+class TH1;
 
 namespace o2::quality_control::repository
 {
@@ -40,8 +49,9 @@ namespace o2::quality_control::postprocessing
 ///
 /// A post-processing task which trends objects inside QC database (QCDB). It extracts some values of one or multiple
 /// objects using the Reductor classes, then stores them inside a TTree. One can generate plots out the TTree - the
-/// class exposes the TTree::Draw interface to the user. The TTree and plots are stored in the QCDB. The class is
-/// configured with configuration files, see Framework/postprocessing.json as an example.
+/// class exposes the TTree::Draw interface to the user. The trend can be stored in the QCDB in chunks of TTrees (see
+/// TrendStore), so that only the last one has to be uploaded at each update. The plots are stored in the QCDB as well.
+/// The class is configured with configuration files, see Framework/postprocessing.json as an example.
 ///
 /// \author Piotr Konopka
 class TrendingTask : public PostProcessingInterface
@@ -54,10 +64,14 @@ class TrendingTask : public PostProcessingInterface
   void initialize(Trigger, framework::ServiceRegistryRef) override;
   void update(Trigger, framework::ServiceRegistryRef) override;
   void finalize(Trigger, framework::ServiceRegistryRef) override;
+  /// \brief Retrieves and reduces the inputs of the triggers in parallel, then fills the trend in their order.
+  /// Falls back to updating sequentially if any data source is not read from QCDB or the database cannot be copied.
+  void backfill(const std::vector<Trigger>&, framework::ServiceRegistryRef, size_t workers) override;
+  bool supportsBackfill() const override { return true; }
 
  private:
   static constexpr size_t MaxRunNumberStringLength = 6;
-  struct {
+  struct MetaData {
     // we store run numbers both as an integer and as a string to allow users to select whether they need
     // a trend in integer or label domain (the latter will contain evenly-spaced data points)
     Long64_t runNumber = 0;
@@ -74,19 +88,63 @@ class TrendingTask : public PostProcessingInterface
   static void formatRunNumberXAxis(TH1* background);
   static std::string deduceGraphLegendOptions(const TrendingTaskConfig::Graph& graphConfig);
   static void applyStyleToGraph(TGraph* graph, const TrendingTaskConfig::GraphStyle& style);
+  /// tells if TTree::Draw would produce a TGraph for a 2-dimensional varexp with such option
+  static bool isGraphOption(const std::string& option);
 
+  /// an expression of a varexp, either a column of the trend or a formula compiled once for all the updates
+  struct CompiledExpression {
+    std::string column;
+    std::unique_ptr<TTreeFormula> formula;
+  };
+  /// a graph which is updated by appending the new entries of the trend
+  struct IncrementalGraph {
+    TGraph* graph = nullptr;                     // owned by the canvas
+    TGraphErrors* errors = nullptr;              // owned by the canvas
+    std::vector<CompiledExpression> expressions; // y, x and optionally the errors, as in TTree::Draw
+    std::unique_ptr<TTreeFormula> selection;
+  };
+  struct IncrementalPlot {
+    std::vector<IncrementalGraph> graphs;
+    TH1* frame = nullptr; // the histogram which draws the axes
+    Long64_t entries = 0; // the number of trend entries already in the graphs
+  };
+
+  /// sets the time and the metadata of a trend entry for the trigger
+  void setEntryTime(const Trigger& t, UInt_t& time, MetaData& metaData) const;
+
+  using ReductorInputs = std::map<std::string, std::shared_future<std::shared_ptr<TObject>>>;
   /// returns true only if all datasources were available to update reductor
   bool trendValues(const Trigger& t, repository::DatabaseInterface&);
+  /// starts retrieving the objects of all the QCDB data sources for the trigger
+  ReductorInputs retrieveInputs(const Trigger& t);
   void generatePlots();
   TCanvas* drawPlot(const TrendingTaskConfig::Plot& plotConfig);
+  /// prepares appending new entries to a plot which has just been drawn, returns false if it is not possible
+  bool prepareIncrementalPlot(const TrendingTaskConfig::Plot& plotConfig, TCanvas* canvas);
+  /// appends the new entries to the graphs of a plot, returns false if the plot has to be drawn again
+  bool appendToPlot(const TrendingTaskConfig::Plot& plotConfig);
+  std::optional<CompiledExpression> compileExpression(const std::string& expression);
+  /// returns the values of each part of a varexp such as "source.mean:time" or nothing if any of them is not a column
+  std::optional<std::vector<std::span<const double>>> getColumns(const std::string& varexp) const;
+  /// draws a graph directly from the trend columns, returns nullptr if it needs to be evaluated with TTree::Draw
+  TGraph* drawGraphFromColumns(const TrendingTaskConfig::Graph& graphConfig, const std::string& option, bool firstGraphInPlot) const;
   void initializeTrend(repository::DatabaseInterface& qcdb);
+  bool loadStoredTrend(repository::DatabaseInterface& qcdb);
   bool canContinueTrend(TTree* tree);
+  void publishTail(core::PublicationPolicy policy);
+  void publishSealedChunks();
 
   TrendingTaskConfig mConfig;
   UInt_t mTime;
-  std::unique_ptr<TTree> mTrend;
+  std::unique_ptr<TrendStore> mTrend;
+  TTree* mPublishedTail = nullptr;                   // the tail of the trend, if it is being published
+  std::vector<std::unique_ptr<TTree>> mSealedChunks; // the sealed chunks of the trend which are being published
   std::map<std::string, std::unique_ptr<TObject>> mPlots;
+  std::map<std::string, IncrementalPlot> mIncrementalPlots;
   std::unordered_map<std::string, std::unique_ptr<Reductor>> mReductors;
+  std::unique_ptr<repository::RetrievalPool> mRetrievalPool;
+  std::optional<Trigger> mPrefetchedTrigger; // the trigger for which mPrefetchedInputs are being retrieved
+  ReductorInputs mPrefetchedInputs;
 };
 
 } // namespace o2::quality_control::postprocessing
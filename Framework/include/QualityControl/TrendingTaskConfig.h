@@ -91,7 +91,10 @@ struct TrendingTaskConfig : PostProcessingConfig {
   bool producePlotsOnUpdate{};
   bool resumeTrend{};
   bool trendIfAllInputs{ false };
+  bool incrementalPlots{ false };
   std::string trendingTimestamp;
+  size_t parallelRetrievals = 1;
+  size_t trendChunkSize = 0;
   std::vector<Plot> plots;
   std::vector<DataSource> dataSources;
 };
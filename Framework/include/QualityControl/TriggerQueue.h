@@ -0,0 +1,118 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   TriggerQueue.h
+///
+
+#ifndef QUALITYCONTROL_TRIGGERQUEUE_H
+#define QUALITYCONTROL_TRIGGERQUEUE_H
+
+#include "QualityControl/Triggers.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace o2::quality_control::postprocessing
+{
+
+/// \brief Evaluates trigger functions in a background thread and keeps the triggers which fired until they are taken.
+///
+/// The trigger functions may block (e.g. listing a database or polling Kafka), thus the thread taking the triggers
+/// only waits for a ready one instead of checking all the functions by itself. Each function has at most one ready
+/// trigger. Once it is taken, the function is evaluated again immediately, so the triggers known in advance (e.g.
+/// ForEachObject) follow each other without delay. When a function does not fire, its next evaluation is delayed by a
+/// backoff, which is doubled each time up to the maximum and reset when it fires.
+///
+/// The functions are grouped as the init, update and stop triggers of a task, only one thread evaluates all of them.
+class TriggerQueue
+{
+ public:
+  enum class Group {
+    Init,
+    Update,
+    Stop
+  };
+
+  struct Backoff {
+    std::chrono::milliseconds initial{ 1000 };
+    std::chrono::milliseconds max{ 10000 };
+  };
+
+  struct Stats {
+    uint64_t evaluations = 0;
+    uint64_t fired = 0;
+    uint64_t taken = 0;
+    double evaluationSeconds = 0; // total time spent in the trigger functions
+    double maxEvaluationSeconds = 0;
+    double waitingSeconds = 0; // total time between a trigger firing and being taken
+    double maxWaitingSeconds = 0;
+  };
+
+  TriggerQueue();
+  explicit TriggerQueue(Backoff backoff);
+  ~TriggerQueue();
+  TriggerQueue(const TriggerQueue&) = delete;
+  TriggerQueue& operator=(const TriggerQueue&) = delete;
+
+  /// \brief Replaces the functions of the group. The ready triggers of the group are dropped.
+  void setTriggers(Group group, std::vector<TriggerFcn> triggerFcns);
+  /// \brief Removes all the functions and ready triggers.
+  void clear();
+
+  /// \brief Takes the ready trigger of the group which fired first, waiting up to the timeout if there is none.
+  /// \return The trigger, or TriggerType::No if none fired. Rethrows the exceptions thrown by the trigger functions.
+  Trigger take(Group group, std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+  /// \brief Waits until any trigger is ready or the timeout passes.
+  /// \return true if a trigger is ready.
+  bool waitForAny(std::chrono::milliseconds timeout);
+  /// \brief Returns true if all the functions of the group triggered for the last time and their triggers were taken.
+  bool isExhausted(Group group) const;
+
+  Stats getStats() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  struct Entry {
+    TriggerFcn fcn;
+    Group group;
+    std::chrono::milliseconds backoff;
+    Clock::time_point nextEvaluation;
+    std::optional<Trigger> ready;
+    Clock::time_point readySince;
+    bool last = false;
+    bool removed = false; // set when the entry leaves the queue, e.g. when it is replaced while being evaluated
+  };
+
+  void evaluationLoop();
+  void evaluate(const std::shared_ptr<Entry>& entry, std::unique_lock<std::mutex>& lock);
+  void erase(const std::shared_ptr<Entry>& entry);
+
+  Backoff mBackoff;
+  mutable std::mutex mMutex;
+  std::condition_variable mWakeUpEvaluation;
+  std::condition_variable mTriggerReady;
+  std::vector<std::shared_ptr<Entry>> mEntries; // in the order of the configuration, within each group
+  std::exception_ptr mError;
+  Stats mStats;
+  bool mStopping = false;
+  std::thread mThread;
+};
+
+} // namespace o2::quality_control::postprocessing
+
+#endif // QUALITYCONTROL_TRIGGERQUEUE_H
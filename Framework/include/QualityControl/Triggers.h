@@ -22,6 +22,7 @@
 #include <iosfwd>
 #include <utility>
 #include <map>
+#include <memory>
 #include "QualityControl/Activity.h"
 
 namespace o2::quality_control::postprocessing
@@ -71,6 +72,7 @@ struct Trigger {
   uint64_t timestamp;      // if tracking an object, it is the validity start (validFrom)
   std::string config{};
   std::map<std::string, std::string> metadata{}; // metadata to search in database
+  std::shared_ptr<const Trigger> next{};         // the next trigger, if known in advance, so that its inputs can be prefetched
 };
 
 using TriggerFcn = std::function<Trigger()>;
@@ -18,7 +18,10 @@
 #define QC_CHECKER_POLICYMANAGER_H
 
 #include <string>
+#include <string_view>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <vector>
 #include <functional>
 #include <iosfwd>
@@ -43,6 +46,7 @@ struct UpdatePolicy {
   // TODO this line makes me think that lambdas are not enough because we actually need to store a state...
   bool policyHelperFlag; // the purpose might change depending on policy,
   RevisionType revision = 0;
+  bool dependsOnAnyObject = false; // true if any received object might make the actor ready
 
   friend std::ostream& operator<<(std::ostream& out, const UpdatePolicy& updatePolicy); // output
 };
@@ -86,6 +90,8 @@ struct UpdatePolicy {
  *  // end run() loop
  * \endcode
  *
+ * Instead of asking each actor with isReady(), the caller can use getReadyActors(). The manager keeps track of
+ * the actors whose objects were updated since they were triggered last time, thus only these are evaluated.
  */
 class UpdatePolicyManager
 {
@@ -136,10 +142,22 @@ class UpdatePolicyManager
    */
   bool isReady(const std::string& actorName);
 
+  /**
+   * Returns the actors which are ready, sorted by name.
+   * It gives the same result as calling isReady() for each actor, but evaluates only the actors which depend on
+   * objects updated since the actors were triggered last time.
+   */
+  std::vector<std::string> getReadyActors();
+
  private:
-  std::map<std::string /* Actor name */, UpdatePolicy> mPoliciesByActor;
+  void markAllActorsAsCandidates();
+
+  std::map<std::string /* Actor name */, UpdatePolicy, std::less<>> mPoliciesByActor;
   RevisionType mGlobalRevision = 1;
   std::map<std::string /* Object name */, RevisionType> mObjectsRevision;
+  // the views point to the keys of mPoliciesByActor
+  std::unordered_map<std::string /* Object name */, std::vector<std::string_view /* Actor name */>> mActorsByObject;
+  std::set<std::string_view /* Actor name */> mCandidateActors; // actors which might be ready
 };
 
 } // namespace o2::quality_control::checker
@@ -0,0 +1,72 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   WorkerPool.h
+///
+
+#ifndef QC_CORE_WORKERPOOL_H
+#define QC_CORE_WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace o2::quality_control::core
+{
+
+/// \brief Executes loops of independent work items on a fixed set of threads.
+///
+/// The thread calling run() is the worker 0 and takes part in the work, the other workers are threads which are kept
+/// alive between the calls, so that no thread is created per processed message. Idle workers take the next item as soon
+/// as they are done with the previous one, thus uneven items are balanced between them. The index of the worker is
+/// passed to the work function, so that it can use per-worker data, see ObjectsManager::getShard().
+class WorkerPool
+{
+ public:
+  using Work = std::function<void(size_t item, size_t worker)>;
+
+  /// \brief Creates a pool with the given number of workers, including the calling thread. 0 is treated as 1.
+  explicit WorkerPool(size_t workers);
+  ~WorkerPool();
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  size_t getNumberOfWorkers() const { return mThreads.size() + 1; }
+
+  /// \brief Calls work for each item in [0, nItems) and returns once all of them are done.
+  /// If any call throws, the remaining items are skipped and the first exception is rethrown.
+  void run(size_t nItems, const Work& work);
+
+ private:
+  void workerLoop(size_t worker);
+  void process(size_t worker);
+
+  std::vector<std::thread> mThreads;
+  std::mutex mMutex;
+  std::condition_variable mStartCondition;
+  std::condition_variable mDoneCondition;
+  const Work* mWork = nullptr;
+  size_t mNumberOfItems = 0;
+  std::atomic<size_t> mNextItem = 0;
+  size_t mGeneration = 0; // incremented by each run(), so that the workers know there is new work
+  size_t mBusyWorkers = 0;
+  std::exception_ptr mException;
+  bool mStopping = false;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_WORKERPOOL_H
@@ -0,0 +1,273 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   AsyncDatabase.cxx
+///
+
+#include "QualityControl/AsyncDatabase.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <Common/Exceptions.h>
+#include <boost/exception/diagnostic_information.hpp>
+#include <algorithm>
+#include <type_traits>
+
+using namespace std::chrono;
+using namespace o2::quality_control::core;
+
+namespace o2::quality_control::repository
+{
+
+namespace
+{
+// the callers keep using their objects after storing them (e.g. beautification by the next Checks), thus we upload
+// a copy taken at the time of the call, which is not shared with anybody else
+std::shared_ptr<const MonitorObject> takeSnapshot(const MonitorObject& mo)
+{
+  auto snapshot = std::make_shared<MonitorObject>(mo);
+  if (!mo.isIsOwner() && mo.getObject() != nullptr) {
+    // the copy constructor clones only the objects which are owned
+    snapshot->setObject(mo.getObject()->Clone());
+    snapshot->setIsOwner(true);
+  }
+  return snapshot;
+}
+} // namespace
+
+AsyncDatabase::AsyncDatabase(const BackendFactory& backendFactory, size_t workers, size_t maxQueueSize)
+  : mBackend(backendFactory()),
+    mMaxQueueSize(std::max<size_t>(maxQueueSize, 1))
+{
+  workers = std::max<size_t>(workers, 1);
+  for (size_t i = 0; i < workers; i++) {
+    mWorkerBackends.emplace_back(backendFactory());
+  }
+  for (auto& backend : mWorkerBackends) {
+    mWorkers.emplace_back([this, backend = backend.get()]() { workerLoop(*backend); });
+  }
+}
+
+AsyncDatabase::~AsyncDatabase()
+{
+  stopWorkers();
+}
+
+void AsyncDatabase::connect(const std::string& host, const std::string& database, const std::string& username, const std::string& password)
+{
+  mBackend->connect(host, database, username, password);
+  for (auto& backend : mWorkerBackends) {
+    backend->connect(host, database, username, password);
+  }
+}
+
+void AsyncDatabase::connect(const std::unordered_map<std::string, std::string>& config)
+{
+  mBackend->connect(config);
+  for (auto& backend : mWorkerBackends) {
+    backend->connect(config);
+  }
+}
+
+void AsyncDatabase::storeMO(std::shared_ptr<const MonitorObject> mo)
+{
+  auto path = mo->getPath();
+  enqueue(path, takeSnapshot(*mo));
+}
+
+void AsyncDatabase::storeQO(std::shared_ptr<const QualityObject> qo)
+{
+  auto path = qo->getPath();
+  enqueue(path, std::make_shared<const QualityObject>(*qo));
+}
+
+void AsyncDatabase::enqueue(const std::string& path, StorageItem item)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (auto pending = mPending.find(path); pending != mPending.end()) {
+      // an older version is still waiting, we replace it and keep its position in the queue
+      pending->second.item = std::move(item);
+      mStats.coalesced++;
+    } else {
+      if (mQueueOrder.size() >= mMaxQueueSize) {
+        ILOG(Warning, Support) << "Upload queue is full, dropping the oldest pending object '" << mQueueOrder.front() << "'" << ENDM;
+        mPending.erase(mQueueOrder.front());
+        mQueueOrder.pop_front();
+        mStats.dropped++;
+      }
+      mQueueOrder.push_back(path);
+      mPending.emplace(path, PendingUpload{ std::move(item), steady_clock::now() });
+    }
+  }
+  mQueueCondition.notify_one();
+}
+
+void AsyncDatabase::workerLoop(DatabaseInterface& backend)
+{
+  while (true) {
+    PendingUpload upload;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mQueueCondition.wait(lock, [this]() { return mStopping || !mQueueOrder.empty(); });
+      if (mQueueOrder.empty()) { // stopping and nothing left to upload
+        return;
+      }
+      auto path = std::move(mQueueOrder.front());
+      mQueueOrder.pop_front();
+      auto pending = mPending.extract(path);
+      upload = std::move(pending.mapped());
+      mUploadsInProgress++;
+    }
+
+    bool success = true;
+    try {
+      std::visit([&backend](auto&& object) {
+        using T = std::decay_t<decltype(object)>;
+        if constexpr (std::is_same_v<T, std::shared_ptr<const MonitorObject>>) {
+          backend.storeMO(object);
+        } else {
+          backend.storeQO(object);
+        }
+      },
+                 upload.item);
+    } catch (boost::exception& e) {
+      ILOG(Info, Support) << "Unable to " << diagnostic_information(e) << ENDM;
+      success = false;
+    } catch (std::exception& e) {
+      ILOG(Error, Support) << "Unable to store an object: " << e.what() << ENDM;
+      success = false;
+    }
+    auto latencyMs = duration_cast<duration<double, std::milli>>(steady_clock::now() - upload.enqueued).count();
+
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mUploadsInProgress--;
+      if (success) {
+        mStats.stored++;
+        mTotalUploadLatencyMs += latencyMs;
+        mStats.maxUploadLatencyMs = std::max(mStats.maxUploadLatencyMs, latencyMs);
+      } else {
+        mStats.failed++;
+      }
+      if (mQueueOrder.empty() && mUploadsInProgress == 0) {
+        mIdleCondition.notify_all();
+      }
+    }
+  }
+}
+
+void AsyncDatabase::flush()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mIdleCondition.wait(lock, [this]() { return mQueueOrder.empty() && mUploadsInProgress == 0; });
+}
+
+void AsyncDatabase::stopWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mQueueCondition.notify_all();
+  for (auto& worker : mWorkers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  mWorkers.clear();
+}
+
+AsyncDatabase::Stats AsyncDatabase::getAndResetStats()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  Stats stats = mStats;
+  stats.queueDepth = mQueueOrder.size();
+  stats.meanUploadLatencyMs = stats.stored > 0 ? mTotalUploadLatencyMs / static_cast<double>(stats.stored) : 0;
+  mStats = {};
+  mTotalUploadLatencyMs = 0;
+  return stats;
+}
+
+void AsyncDatabase::storeAny(const void* obj, std::type_info const& typeInfo, std::string const& path, std::map<std::string, std::string> const& metadata,
+                             std::string const& detectorName, std::string const& taskName, long from, long to)
+{
+  // we cannot know how long the object behind the raw pointer lives, thus it is stored synchronously
+  mBackend->storeAny(obj, typeInfo, path, metadata, detectorName, taskName, from, to);
+}
+
+void* AsyncDatabase::retrieveAny(std::type_info const& tinfo, std::string const& path, std::map<std::string, std::string> const& metadata, long timestamp,
+                                 std::map<std::string, std::string>* headers, const std::string& createdNotAfter, const std::string& createdNotBefore)
+{
+  return mBackend->retrieveAny(tinfo, path, metadata, timestamp, headers, createdNotAfter, createdNotBefore);
+}
+
+std::shared_ptr<MonitorObject> AsyncDatabase::retrieveMO(std::string objectPath, std::string objectName, long timestamp, const Activity& activity,
+                                                         const std::map<std::string, std::string>& metadata)
+{
+  return mBackend->retrieveMO(std::move(objectPath), std::move(objectName), timestamp, activity, metadata);
+}
+
+std::shared_ptr<QualityObject> AsyncDatabase::retrieveQO(std::string qoPath, long timestamp, const Activity& activity,
+                                                         const std::map<std::string, std::string>& metadata)
+{
+  return mBackend->retrieveQO(std::move(qoPath), timestamp, activity, metadata);
+}
+
+std::string AsyncDatabase::retrieveJson(std::string path, long timestamp, const std::map<std::string, std::string>& metadata)
+{
+  return mBackend->retrieveJson(std::move(path), timestamp, metadata);
+}
+
+TObject* AsyncDatabase::retrieveTObject(std::string path, const std::map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>* headers)
+{
+  return mBackend->retrieveTObject(std::move(path), metadata, timestamp, headers);
+}
+
+void AsyncDatabase::disconnect()
+{
+  flush();
+  mBackend->disconnect();
+  for (auto& backend : mWorkerBackends) {
+    backend->disconnect();
+  }
+}
+
+void AsyncDatabase::prepareTaskDataContainer(std::string taskName)
+{
+  mBackend->prepareTaskDataContainer(std::move(taskName));
+}
+
+std::vector<std::string> AsyncDatabase::getPublishedObjectNames(std::string taskName)
+{
+  return mBackend->getPublishedObjectNames(std::move(taskName));
+}
+
+void AsyncDatabase::truncate(std::string path, std::string objectName)
+{
+  mBackend->truncate(std::move(path), std::move(objectName));
+}
+
+void AsyncDatabase::setMaxObjectSize(size_t maxObjectSize)
+{
+  flush();
+  mBackend->setMaxObjectSize(maxObjectSize);
+  for (auto& backend : mWorkerBackends) {
+    backend->setMaxObjectSize(maxObjectSize);
+  }
+}
+
+ValidityInterval AsyncDatabase::getLatestObjectValidity(const std::string& path, const std::map<std::string, std::string>& metadata)
+{
+  return mBackend->getLatestObjectValidity(path, metadata);
+}
+
+} // namespace o2::quality_control::repository
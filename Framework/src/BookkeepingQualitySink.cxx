@@ -64,7 +64,7 @@ void BookkeepingQualitySink::start(framework::ServiceRegistryRef services)
   QcInfoLogger::setRun(currentActivity.mId);
 }
 
-void BookkeepingQualitySink::send(const std::string& grpcUri, const BookkeepingQualitySink::FlagsMap& flags, Provenance provenance)
+void BookkeepingQualitySink::send(const std::string& grpcUri, const BookkeepingQualitySink::FlagCollections& flags, Provenance provenance)
 {
   auto& bkpClient = o2::quality_control::core::Bookkeeping::getInstance();
 
@@ -72,20 +72,11 @@ void BookkeepingQualitySink::send(const std::string& grpcUri, const BookkeepingQ
   std::optional<std::string> passName;
   std::optional<std::string> periodName;
 
-  for (auto& [detector, qoMap] : flags) {
+  for (auto& [detector, flagCollections] : flags) {
     ILOG(Info, Support) << "Processing flags for detector: " << detector << ENDM;
 
     std::vector<QcFlag> bkpQcFlags{};
-    for (auto& [qoName, converter] : qoMap) {
-      if (converter == nullptr) {
-        continue;
-      }
-      if (provenance == Provenance::AsyncQC || provenance == Provenance::MCQC) {
-        auto runDuration = ccdb::BasicCCDBManager::instance().getRunDuration(converter->getRunNumber(), false);
-        converter->updateValidityInterval({ static_cast<uint64_t>(runDuration.first), static_cast<uint64_t>(runDuration.second) });
-      }
-
-      auto flagCollection = converter->getResult();
+    for (auto& flagCollection : flagCollections) {
       if (flagCollection == nullptr) {
         continue;
       }
@@ -136,7 +127,17 @@ void BookkeepingQualitySink::send(const std::string& grpcUri, const BookkeepingQ
 }
 
 BookkeepingQualitySink::BookkeepingQualitySink(const std::string& grpcUri, Provenance provenance, SendCallback sendCallback)
-  : mGrpcUri{ grpcUri }, mProvenance{ provenance }, mSendCallback{ std::move(sendCallback) } {}
+  : BookkeepingQualitySink(grpcUri, provenance, std::move(sendCallback), StreamingConfig{})
+{
+}
+
+BookkeepingQualitySink::BookkeepingQualitySink(const std::string& grpcUri, Provenance provenance, SendCallback sendCallback, StreamingConfig streamingConfig)
+  : mGrpcUri{ grpcUri }, mProvenance{ provenance }, mSendCallback{ std::move(sendCallback) }, mStreamingConfig{ streamingConfig }
+{
+  if (isStreaming()) {
+    mFlushTimer.reset(static_cast<int>(mStreamingConfig.flushPeriodSeconds * 1000000));
+  }
+}
 
 auto collectionForQualityObject(const QualityObject& qualityObject) -> std::unique_ptr<QualityControlFlagCollection>
 {
@@ -163,11 +164,73 @@ void BookkeepingQualitySink::run(framework::ProcessingContext& context)
     auto& converter = mFlagsMap[qualityObject->getDetectorName()][qualityObject->getName()];
     if (converter == nullptr) {
       converter = std::make_unique<QualitiesToFlagCollectionConverter>(collectionForQualityObject(*qualityObject), qualityObject->getPath());
+      if (isStreaming()) {
+        // the flags sent during the run have to be trimmed already
+        trimToRunDuration(*converter);
+      }
     }
     (*converter)(*qualityObject);
+
+    if (isStreaming()) {
+      const auto& detector = qualityObject->getDetectorName();
+      auto threshold = mForcedFlushThresholds.try_emplace(detector, mStreamingConfig.maxBufferedFlags).first->second;
+      if (countBufferedFlags(detector) > threshold) {
+        flushFinalized(&detector);
+      }
+    }
+  }
+
+  if (isStreaming() && mFlushTimer.isTimeout()) {
+    flushFinalized();
+    mFlushTimer.reset(static_cast<int>(mStreamingConfig.flushPeriodSeconds * 1000000));
+  }
+}
+
+void BookkeepingQualitySink::trimToRunDuration(QualitiesToFlagCollectionConverter& converter) const
+{
+  if (mProvenance == Provenance::AsyncQC || mProvenance == Provenance::MCQC) {
+    auto runDuration = ccdb::BasicCCDBManager::instance().getRunDuration(converter.getRunNumber(), false);
+    converter.updateValidityInterval({ static_cast<uint64_t>(runDuration.first), static_cast<uint64_t>(runDuration.second) });
   }
 }
 
+void BookkeepingQualitySink::flushFinalized(const std::string* onlyDetector)
+{
+  FlagCollections finalized;
+  size_t flagsCount = 0;
+  for (auto& [detector, qoMap] : mFlagsMap) {
+    if (onlyDetector != nullptr && detector != *onlyDetector) {
+      continue;
+    }
+    for (auto& [qoName, converter] : qoMap) {
+      // the QOs are assumed to come in order, so nothing will change before the start of the newest one
+      auto flagCollection = converter->takeFinalizedFlags(converter->getNewestQOStart());
+      if (flagCollection->size() > 0) {
+        flagsCount += flagCollection->size();
+        finalized[detector].push_back(std::move(flagCollection));
+      }
+    }
+    // The flags which are not final yet, e.g. those of cumulative QOs, remain buffered until the end of run.
+    // We do not force another flush before as many new flags arrive, so that it is not attempted for every QO.
+    mForcedFlushThresholds[detector] = countBufferedFlags(detector) + mStreamingConfig.maxBufferedFlags;
+  }
+  if (!finalized.empty()) {
+    ILOG(Debug, Support) << "Flushing " << flagsCount << " finalized flags" << ENDM;
+    mSendCallback(mGrpcUri, finalized, mProvenance);
+  }
+}
+
+size_t BookkeepingQualitySink::countBufferedFlags(const std::string& detector) const
+{
+  size_t bufferedFlags = 0;
+  if (auto qoMap = mFlagsMap.find(detector); qoMap != mFlagsMap.end()) {
+    for (const auto& [qoName, converter] : qoMap->second) {
+      bufferedFlags += converter->getBufferedFlags();
+    }
+  }
+  return bufferedFlags;
+}
+
 void BookkeepingQualitySink::endOfStream(framework::EndOfStreamContext&)
 {
   sendAndClear();
@@ -181,9 +244,21 @@ void BookkeepingQualitySink::stop()
 void BookkeepingQualitySink::sendAndClear()
 {
   if (!mFlagsMap.empty()) {
-    mSendCallback(mGrpcUri, mFlagsMap, mProvenance);
+    FlagCollections flagCollections;
+    for (auto& [detector, qoMap] : mFlagsMap) {
+      auto& detectorCollections = flagCollections[detector];
+      for (auto& [qoName, converter] : qoMap) {
+        if (converter == nullptr) {
+          continue;
+        }
+        trimToRunDuration(*converter);
+        detectorCollections.push_back(converter->getResult());
+      }
+    }
+    mSendCallback(mGrpcUri, flagCollections, mProvenance);
   }
   mFlagsMap.clear();
+  mForcedFlushThresholds.clear();
 }
 
 } // namespace o2::quality_control::core
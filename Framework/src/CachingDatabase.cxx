@@ -0,0 +1,302 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CachingDatabase.cxx
+///
+
+#include "QualityControl/CachingDatabase.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/QualityObject.h"
+#include "QualityControl/ActivityHelpers.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <TBufferFile.h>
+
+using namespace std::chrono;
+using namespace o2::quality_control::core;
+
+namespace o2::quality_control::repository
+{
+
+RetrievalCache::RetrievalCache(milliseconds timeToLive, size_t maxSizeBytes)
+  : mTimeToLive(timeToLive), mMaxSizeBytes(maxSizeBytes)
+{
+}
+
+RetrievalCache& RetrievalCache::getInstance()
+{
+  static RetrievalCache instance(seconds(60), 512 * 1024 * 1024);
+  return instance;
+}
+
+void RetrievalCache::setLimits(milliseconds timeToLive, size_t maxSizeBytes)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mTimeToLive = timeToLive;
+  mMaxSizeBytes = maxSizeBytes;
+  while (mSizeBytes > mMaxSizeBytes && !mLruOrder.empty()) {
+    erase(mSlots.find(mLruOrder.back()));
+    mStats.evicted++;
+  }
+}
+
+std::shared_ptr<const RetrievalCache::Entry> RetrievalCache::getOrRetrieve(const std::string& key, const std::function<Entry()>& retrieve)
+{
+  std::promise<std::shared_ptr<const Entry>> promise;
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (auto slot = mSlots.find(key); slot != mSlots.end()) {
+      if (steady_clock::now() < slot->second.expiration) {
+        mLruOrder.splice(mLruOrder.begin(), mLruOrder, slot->second.lruPosition);
+        mStats.hits++;
+        return slot->second.entry;
+      }
+      erase(slot);
+      mStats.expired++;
+    }
+    if (auto inFlight = mInFlight.find(key); inFlight != mInFlight.end()) {
+      auto future = inFlight->second;
+      mStats.deduplicated++;
+      lock.unlock();
+      return future.get();
+    }
+    mInFlight.emplace(key, promise.get_future().share());
+    mStats.misses++;
+  }
+
+  std::shared_ptr<const Entry> entry;
+  try {
+    entry = std::make_shared<const Entry>(retrieve());
+  } catch (...) {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mInFlight.erase(key);
+    }
+    promise.set_exception(std::current_exception());
+    throw;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mInFlight.erase(key);
+    if (entry->object != nullptr) {
+      insert(key, entry);
+    }
+  }
+  promise.set_value(entry);
+  return entry;
+}
+
+void RetrievalCache::insert(const std::string& key, std::shared_ptr<const Entry> entry)
+{
+  if (entry->size > mMaxSizeBytes) {
+    ILOG(Debug, Devel) << "Object '" << key << "' is larger than the cache, it will not be cached" << ENDM;
+    return;
+  }
+  if (auto existing = mSlots.find(key); existing != mSlots.end()) {
+    erase(existing);
+  }
+  while (mSizeBytes + entry->size > mMaxSizeBytes && !mLruOrder.empty()) {
+    erase(mSlots.find(mLruOrder.back()));
+    mStats.evicted++;
+  }
+  mLruOrder.push_front(key);
+  mSizeBytes += entry->size;
+  mSlots.emplace(key, Slot{ std::move(entry), steady_clock::now() + mTimeToLive, mLruOrder.begin() });
+}
+
+void RetrievalCache::erase(std::unordered_map<std::string, Slot>::iterator slot)
+{
+  mSizeBytes -= slot->second.entry->size;
+  mLruOrder.erase(slot->second.lruPosition);
+  mSlots.erase(slot);
+}
+
+void RetrievalCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mSlots.clear();
+  mLruOrder.clear();
+  mSizeBytes = 0;
+}
+
+RetrievalCache::Stats RetrievalCache::getStats() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  Stats stats = mStats;
+  stats.entries = mSlots.size();
+  stats.sizeBytes = mSizeBytes;
+  return stats;
+}
+
+size_t RetrievalCache::estimateSize(const TObject* object)
+{
+  if (object == nullptr) {
+    return 0;
+  }
+  TBufferFile buffer(TBuffer::kWrite);
+  buffer.WriteObject(object);
+  return buffer.Length();
+}
+
+CachingDatabase::CachingDatabase(std::unique_ptr<DatabaseInterface> backend, RetrievalCache& cache)
+  : mBackend(std::move(backend)), mCache(cache)
+{
+}
+
+void CachingDatabase::connect(const std::string& host, const std::string& database, const std::string& username, const std::string& password)
+{
+  mBackend->connect(host, database, username, password);
+  mBackendId = host + "/" + database;
+}
+
+void CachingDatabase::connect(const std::unordered_map<std::string, std::string>& config)
+{
+  mBackend->connect(config);
+  mBackendId = (config.count("host") ? config.at("host") : "") + "/" + (config.count("name") ? config.at("name") : "");
+}
+
+std::string CachingDatabase::makeKey(const char* kind, const std::string& path, long timestamp, const std::map<std::string, std::string>& metadata) const
+{
+  std::string key = std::string(kind) + ":" + mBackendId + ":" + path + "@" + std::to_string(timestamp);
+  for (const auto& [name, value] : metadata) {
+    key += ";" + name + "=" + value;
+  }
+  return key;
+}
+
+std::shared_ptr<MonitorObject> CachingDatabase::retrieveMO(std::string objectPath, std::string objectName, long timestamp, const Activity& activity,
+                                                           const std::map<std::string, std::string>& metadata)
+{
+  auto keyMetadata = activity_helpers::asDatabaseMetadata(activity, false);
+  keyMetadata.insert(metadata.begin(), metadata.end());
+  auto key = makeKey("MO", activity.mProvenance + "/" + objectPath + "/" + objectName, timestamp, keyMetadata);
+
+  auto entry = mCache.getOrRetrieve(key, [&]() {
+    RetrievalCache::Entry result;
+    auto mo = mBackend->retrieveMO(objectPath, objectName, timestamp, activity, metadata);
+    result.size = RetrievalCache::estimateSize(mo ? mo->getObject() : nullptr);
+    result.object = std::move(mo);
+    return result;
+  });
+  if (entry->object == nullptr) {
+    return nullptr;
+  }
+  // the copy constructor clones the encapsulated object if the cached MO owns it
+  return std::make_shared<MonitorObject>(static_cast<const MonitorObject&>(*entry->object));
+}
+
+std::shared_ptr<QualityObject> CachingDatabase::retrieveQO(std::string qoPath, long timestamp, const Activity& activity,
+                                                           const std::map<std::string, std::string>& metadata)
+{
+  auto keyMetadata = activity_helpers::asDatabaseMetadata(activity, false);
+  keyMetadata.insert(metadata.begin(), metadata.end());
+  auto key = makeKey("QO", activity.mProvenance + "/" + qoPath, timestamp, keyMetadata);
+
+  auto entry = mCache.getOrRetrieve(key, [&]() {
+    RetrievalCache::Entry result;
+    auto qo = mBackend->retrieveQO(qoPath, timestamp, activity, metadata);
+    result.size = RetrievalCache::estimateSize(qo.get());
+    result.object = std::move(qo);
+    return result;
+  });
+  if (entry->object == nullptr) {
+    return nullptr;
+  }
+  return std::make_shared<QualityObject>(static_cast<const QualityObject&>(*entry->object));
+}
+
+TObject* CachingDatabase::retrieveTObject(std::string path, const std::map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>* headers)
+{
+  auto entry = mCache.getOrRetrieve(makeKey("TObject", path, timestamp, metadata), [&]() {
+    RetrievalCache::Entry result;
+    std::shared_ptr<const TObject> object(mBackend->retrieveTObject(path, metadata, timestamp, &result.headers));
+    result.size = RetrievalCache::estimateSize(object.get());
+    result.object = std::move(object);
+    return result;
+  });
+  if (headers) {
+    headers->insert(entry->headers.begin(), entry->headers.end());
+  }
+  return entry->object ? entry->object->Clone() : nullptr;
+}
+
+void CachingDatabase::storeMO(std::shared_ptr<const MonitorObject> mo)
+{
+  mBackend->storeMO(std::move(mo));
+}
+
+void CachingDatabase::storeQO(std::shared_ptr<const QualityObject> qo)
+{
+  mBackend->storeQO(std::move(qo));
+}
+
+void CachingDatabase::storeAny(const void* obj, std::type_info const& typeInfo, std::string const& path, std::map<std::string, std::string> const& metadata,
+                               std::string const& detectorName, std::string const& taskName, long from, long to)
+{
+  mBackend->storeAny(obj, typeInfo, path, metadata, detectorName, taskName, from, to);
+}
+
+void* CachingDatabase::retrieveAny(std::type_info const& tinfo, std::string const& path, std::map<std::string, std::string> const& metadata, long timestamp,
+                                   std::map<std::string, std::string>* headers, const std::string& createdNotAfter, const std::string& createdNotBefore)
+{
+  // we do not know how to copy an object of an arbitrary type, so we cannot cache it
+  return mBackend->retrieveAny(tinfo, path, metadata, timestamp, headers, createdNotAfter, createdNotBefore);
+}
+
+std::string CachingDatabase::retrieveJson(std::string path, long timestamp, const std::map<std::string, std::string>& metadata)
+{
+  return mBackend->retrieveJson(std::move(path), timestamp, metadata);
+}
+
+void CachingDatabase::disconnect()
+{
+  mBackend->disconnect();
+}
+
+void CachingDatabase::prepareTaskDataContainer(std::string taskName)
+{
+  mBackend->prepareTaskDataContainer(std::move(taskName));
+}
+
+std::vector<std::string> CachingDatabase::getPublishedObjectNames(std::string taskName)
+{
+  return mBackend->getPublishedObjectNames(std::move(taskName));
+}
+
+void CachingDatabase::truncate(std::string path, std::string objectName)
+{
+  mBackend->truncate(std::move(path), std::move(objectName));
+}
+
+void CachingDatabase::setMaxObjectSize(size_t maxObjectSize)
+{
+  mBackend->setMaxObjectSize(maxObjectSize);
+}
+
+ValidityInterval CachingDatabase::getLatestObjectValidity(const std::string& path, const std::map<std::string, std::string>& metadata)
+{
+  return mBackend->getLatestObjectValidity(path, metadata);
+}
+
+std::unique_ptr<DatabaseInterface> CachingDatabase::clone()
+{
+  auto backendCopy = mBackend->clone();
+  if (backendCopy == nullptr) {
+    return nullptr;
+  }
+  auto copy = std::make_unique<CachingDatabase>(std::move(backendCopy), mCache);
+  copy->mBackendId = mBackendId;
+  return copy;
+}
+
+} // namespace o2::quality_control::repository
@@ -25,6 +25,7 @@
 // O2
 #include <Common/Exceptions.h>
 #include <CCDB/CcdbApi.h>
+#include <CCDB/CcdbObjectInfo.h>
 #include <CommonUtils/MemFileHelper.h>
 // ROOT
 #include <TBufferJSON.h>
@@ -163,41 +164,38 @@ void CcdbDatabase::storeAny(const void* obj, std::type_info const& typeInfo, std
 }
 
 // Monitor object
-void CcdbDatabase::storeMO(std::shared_ptr<const o2::quality_control::core::MonitorObject> mo)
+std::optional<CcdbDatabase::StorageParameters> CcdbDatabase::prepareStorageParameters(const MonitorObject& mo)
 {
-  if (mo->getName().length() == 0 || mo->getTaskName().length() == 0) {
+  if (mo.getName().length() == 0 || mo.getTaskName().length() == 0) {
     BOOST_THROW_EXCEPTION(DatabaseException()
                           << errinfo_details("Object and task names can't be empty. Do not store. "));
   }
 
-  if (mo->getName().find_first_of("\t\n ") != string::npos || mo->getTaskName().find_first_of("\t\n ") != string::npos) {
+  if (mo.getName().find_first_of("\t\n ") != string::npos || mo.getTaskName().find_first_of("\t\n ") != string::npos) {
     BOOST_THROW_EXCEPTION(DatabaseException()
                           << errinfo_details("Object and task names can't contain white spaces. Do not store."));
   }
 
   if (isDbInFailure()) {
-    return;
+    return std::nullopt;
   }
 
-  map<string, string> metadata = activity_helpers::asDatabaseMetadata(mo->getActivity());
+  map<string, string> metadata = activity_helpers::asDatabaseMetadata(mo.getActivity());
 
   // user metadata
-  map<string, string> userMetadata = mo->getMetadataMap();
+  map<string, string> userMetadata = mo.getMetadataMap();
   if (!userMetadata.empty()) {
     metadata.insert(userMetadata.begin(), userMetadata.end());
   }
 
-  // extract object and metadata from MonitorObject
-  TObject* obj = mo->getObject();
-
   // QC metadata (prefix qc_)
-  addFrameworkMetadata(metadata, mo->getDetectorName(), mo->getObject()->IsA()->GetName());
-  metadata[metadata_keys::qcTaskName] = mo->getTaskName();
-  metadata[metadata_keys::qcTaskClass] = mo->getTaskClass();
+  addFrameworkMetadata(metadata, mo.getDetectorName(), mo.getObject()->IsA()->GetName());
+  metadata[metadata_keys::qcTaskName] = mo.getTaskName();
+  metadata[metadata_keys::qcTaskClass] = mo.getTaskClass();
 
   // path attributes
-  string path = mo->getPath();
-  auto validity = mo->getValidity();
+  string path = mo.getPath();
+  auto validity = mo.getValidity();
   auto from = static_cast<long>(validity.getMin());
   auto to = static_cast<long>(validity.getMax());
 
@@ -208,19 +206,53 @@ void CcdbDatabase::storeMO(std::shared_ptr<const o2::quality_control::core::Moni
     to = from + 1000l * 60 * 60 * 24 * 365 * 10; // ~10 years since the start of validity
   }
   if (from == to) {
-    ILOG(Warning, Support) << "The validity start of '" << mo->GetName() << "' is equal to validity end (" << from << ", " << to << "). The validity end will be extended by 1ms to allow for storage." << ENDM;
+    ILOG(Warning, Support) << "The validity start of '" << mo.GetName() << "' is equal to validity end (" << from << ", " << to << "). The validity end will be extended by 1ms to allow for storage." << ENDM;
     to += 1;
   }
 
   if (from > to) {
-    ILOG(Error, Support) << "The validity start of '" << mo->GetName() << "' later than the end (" << from << ", " << to << "). The object will not be stored" << ENDM;
+    ILOG(Error, Support) << "The validity start of '" << mo.GetName() << "' later than the end (" << from << ", " << to << "). The object will not be stored" << ENDM;
+    return std::nullopt;
+  }
+
+  return StorageParameters{ std::move(path), std::move(metadata), from, to };
+}
+
+void CcdbDatabase::storeMO(std::shared_ptr<const o2::quality_control::core::MonitorObject> mo)
+{
+  auto parameters = prepareStorageParameters(*mo);
+  if (!parameters.has_value()) {
     return;
   }
 
-  ILOG(Debug, Support) << "Storing MonitorObject " << path << ENDM;
-  int result = ccdbApi->storeAsTFileAny<TObject>(obj, path, metadata, from, to, mMaxObjectSize);
+  ILOG(Debug, Support) << "Storing MonitorObject " << parameters->path << ENDM;
+  int result = ccdbApi->storeAsTFileAny<TObject>(mo->getObject(), parameters->path, parameters->metadata, parameters->from, parameters->to, mMaxObjectSize);
 
-  handleStorageError(path, result);
+  handleStorageError(parameters->path, result);
+}
+
+CcdbDatabase::SerializedObject CcdbDatabase::serialize(const TObject* obj)
+{
+  o2::ccdb::CcdbObjectInfo info;
+  auto image = o2::ccdb::CcdbApi::createObjectImage(obj, typeid(TObject), &info);
+  return { std::move(image), info.getFileName(), info.getObjectType() };
+}
+
+void CcdbDatabase::storeMO(std::shared_ptr<const o2::quality_control::core::MonitorObject> mo, const SerializedObject& serializedObject)
+{
+  if (serializedObject.image == nullptr) {
+    BOOST_THROW_EXCEPTION(DatabaseException() << errinfo_details("The serialized object of '" + mo->getName() + "' is empty. Do not store."));
+  }
+  auto parameters = prepareStorageParameters(*mo);
+  if (!parameters.has_value()) {
+    return;
+  }
+
+  ILOG(Debug, Support) << "Storing serialized MonitorObject " << parameters->path << ENDM;
+  int result = ccdbApi->storeAsBinaryFile(serializedObject.image->data(), serializedObject.image->size(), serializedObject.fileName, serializedObject.objectType,
+                                          parameters->path, parameters->metadata, parameters->from, parameters->to, mMaxObjectSize);
+
+  handleStorageError(parameters->path, result);
 }
 
 void CcdbDatabase::storeQO(std::shared_ptr<const o2::quality_control::core::QualityObject> qo)
@@ -595,4 +627,12 @@ void CcdbDatabase::setMaxObjectSize(size_t maxObjectSize)
   CcdbDatabase::mMaxObjectSize = maxObjectSize;
 }
 
+std::unique_ptr<DatabaseInterface> CcdbDatabase::clone()
+{
+  auto copy = std::make_unique<CcdbDatabase>();
+  copy->connect(mUrl, "", "", "");
+  copy->setMaxObjectSize(mMaxObjectSize);
+  return copy;
+}
+
 } // namespace o2::quality_control::repository
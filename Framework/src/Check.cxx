@@ -84,48 +84,45 @@ void Check::reset()
   mCheckInterface->reset();
 }
 
-QualityObjectsType Check::check(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap)
+void Check::selectObjects(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap)
 {
-  if (mCheckInterface == nullptr) {
-    BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Attempting to check, but no CheckInterface is loaded"));
-  }
-
-  std::map<std::string, std::shared_ptr<MonitorObject>> shadowMap;
-  // Take only the MOs which are needed to be checked
+  mSelectedObjects.clear();
   if (mCheckConfig.allObjects) {
-    /*
-     * User didn't specify the MOs.
-     * All MOs are passed, no shadowing needed.
-     */
-    shadowMap = moMap;
+    // User didn't specify the MOs, all MOs are passed.
+    for (const auto& entry : moMap) {
+      mSelectedObjects.push_back(&entry);
+    }
   } else {
-    /*
-     * Shadow MOs.
-     * Don't pass MOs that weren't specified by user.
-     * The user might safely rely on getting only required MOs inside the map.
-     *
-     * Implementation: Copy to different map only required MOs.
-     */
-    std::ranges::copy(mCheckConfig.objectNames |
-                        std::views::filter([&](const auto& key) { return moMap.count(key) > 0; }) |
-                        std::views::transform([&](const auto& key) { return std::pair{ key, moMap[key] }; }),
-                      std::inserter(shadowMap, shadowMap.end()));
+    // Don't pass MOs that weren't specified by user, the user might safely rely on getting only required MOs.
+    // We refer to the entries of the map, so that nothing is copied.
+    for (const auto& name : mCheckConfig.objectNames) {
+      if (auto entry = moMap.find(name); entry != moMap.end()) {
+        mSelectedObjects.push_back(&*entry);
+      }
+    }
+    std::ranges::sort(mSelectedObjects, {}, [](const MonitorObjectsView::Entry* entry) -> const std::string& { return entry->first; });
   }
+}
 
-  // Prepare a vector of MO maps to be checked, each one will receive a separate Quality.
-  std::vector<std::map<std::string, std::shared_ptr<MonitorObject>>> moMapsToCheck;
-  if (mCheckConfig.policyType == UpdatePolicyType::OnEachSeparately) {
-    // In this case we want to check all MOs separately and we get separate QOs for them.
-    for (auto mo : shadowMap) {
-      moMapsToCheck.push_back({ std::move(mo) });
-    }
-  } else {
-    moMapsToCheck.emplace_back(shadowMap);
+QualityObjectsType Check::check(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap, bool beautifyObjects)
+{
+  if (mCheckInterface == nullptr) {
+    BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Attempting to check, but no CheckInterface is loaded"));
   }
 
+  selectObjects(moMap);
+  MonitorObjectsView selectedObjects{ mSelectedObjects };
+
+  // Prepare views of MOs to be checked, each one will receive a separate Quality.
+  // In the case of OnEachSeparately, we want to check all MOs separately and we get separate QOs for them.
+  const bool eachSeparately = mCheckConfig.policyType == UpdatePolicyType::OnEachSeparately;
+  const size_t numberOfChecks = eachSeparately ? selectedObjects.size() : 1;
+  const size_t objectsPerCheck = eachSeparately ? 1 : selectedObjects.size();
+
   QualityObjectsType qualityObjects;
-  for (auto& moMapToCheck : moMapsToCheck) {
-    if (std::ranges::any_of(moMapToCheck, [](const std::pair<std::string, std::shared_ptr<MonitorObject>>& item) {
+  for (size_t i = 0; i < numberOfChecks; i++) {
+    auto objectsToCheck = selectedObjects.subview(i * objectsPerCheck, objectsPerCheck);
+    if (std::ranges::any_of(objectsToCheck, [](const MonitorObjectsView::Entry& item) {
           return item.second == nullptr || item.second->getObject() == nullptr;
         })) {
       ILOG(Warning, Devel) << "Some MOs in the map to check are nullptr, skipping check '" << mCheckInterface->getName() << "'" << ENDM;
@@ -134,7 +131,7 @@ QualityObjectsType Check::check(std::map<std::string, std::shared_ptr<MonitorObj
 
     Quality quality;
     try {
-      quality = mCheckInterface->check(&moMapToCheck);
+      quality = mCheckInterface->check(objectsToCheck);
     } catch (...) {
       std::string diagnostic = boost::current_exception_diagnostic_information();
       ILOG(Error, Ops) << "Unexpected exception in user code (check):"
@@ -142,13 +139,14 @@ QualityObjectsType Check::check(std::map<std::string, std::shared_ptr<MonitorObj
       continue;
     }
     auto commonActivity = activity_helpers::strictestMatchingActivity(
-      moMapToCheck | std::views::transform([](const std::pair<std::string, std::shared_ptr<MonitorObject>>& item) {
+      objectsToCheck | std::views::transform([](const MonitorObjectsView::Entry& item) -> const Activity& {
         return item.second->getActivity();
       }));
     ILOG(Debug, Devel) << "Check '" << mCheckConfig.name << "', quality '" << quality << "'" << ENDM;
     std::vector<std::string> monitorObjectsNames;
+    monitorObjectsNames.reserve(objectsToCheck.size());
     std::optional<unsigned long> maxCycle{};
-    for (const auto& [moName, mo] : moMapToCheck) {
+    for (const auto& [moName, mo] : objectsToCheck) {
       monitorObjectsNames.emplace_back(moName);
       if (const auto cycle = mo->getMetadata(repository::metadata_keys::cycleNumber)) {
         const auto& cycleStr = cycle.value();
@@ -170,19 +168,38 @@ QualityObjectsType Check::check(std::map<std::string, std::shared_ptr<MonitorObj
     if (maxCycle.has_value()) {
       qualityObjects.back()->addMetadata(repository::metadata_keys::cycleNumber, std::to_string(maxCycle.value()));
     }
-    beautify(moMapToCheck, quality);
+    if (beautifyObjects) {
+      beautify(objectsToCheck, quality);
+    }
   }
 
   return qualityObjects;
 }
 
-void Check::beautify(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap, const Quality& quality)
+void Check::beautify(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap, const QualityObjectsType& qualityObjects)
+{
+  if (!mCheckConfig.allowBeautify) {
+    return;
+  }
+
+  for (const auto& qo : qualityObjects) {
+    mSelectedObjects.clear();
+    for (const auto& moName : qo->getMonitorObjectsNames()) {
+      if (auto entry = moMap.find(moName); entry != moMap.end()) {
+        mSelectedObjects.push_back(&*entry);
+      }
+    }
+    beautify(MonitorObjectsView{ mSelectedObjects }, qo->getQuality());
+  }
+}
+
+void Check::beautify(const MonitorObjectsView& objects, const Quality& quality)
 {
   if (!mCheckConfig.allowBeautify) {
     return;
   }
 
-  for (auto const& item : moMap) {
+  for (auto const& item : objects) {
     try {
       mCheckInterface->beautify(item.second /*mo*/, quality);
     } catch (...) {
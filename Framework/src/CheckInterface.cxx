@@ -37,6 +37,12 @@ core::Quality CheckInterface::check(const core::QCInputs& data)
   return core::Quality{};
 };
 
+core::Quality CheckInterface::check(const core::MonitorObjectsView& view)
+{
+  auto moMap = view.toMap();
+  return check(&moMap);
+}
+
 void CheckInterface::configure()
 {
   // noop, override it if you want.
@@ -26,17 +26,25 @@
 #include <Monitoring/Monitoring.h>
 #include <CommonUtils/ConfigurableParam.h>
 
+#include <optional>
 #include <utility>
+#include <future>
+#include <boost/asio/post.hpp>
 // QC
+#include "QualityControl/AsyncDatabase.h"
 #include "QualityControl/DatabaseFactory.h"
 #include "QualityControl/runnerUtils.h"
 #include "QualityControl/InfrastructureSpecReader.h"
+#include "QualityControl/MonitorObjectCollection.h"
 #include "QualityControl/CheckRunnerFactory.h"
 #include "QualityControl/RootClassFactory.h"
 #include "QualityControl/ConfigParamGlo.h"
 #include "QualityControl/Bookkeeping.h"
+#include "QualityControl/stringUtils.h"
+#include "QualityControl/ObjectMetadataKeys.h"
 
 #include <TSystem.h>
+#include <TROOT.h>
 
 using namespace std::chrono;
 using namespace AliceO2::Common;
@@ -187,6 +195,12 @@ void CheckRunner::init(framework::InitContext& iCtx)
       check.init();
       updatePolicyManager.addPolicy(check.getName(), check.getUpdatePolicyType(), check.getObjectsNames(), check.getAllObjectsOption(), false);
     }
+
+    if (mConfig.threads > 1 && mChecks.size() > 1) {
+      ILOG(Info, Devel) << "Checks will be run in parallel with " << mConfig.threads << " threads" << ENDM;
+      ROOT::EnableThreadSafety();
+      mCheckThreadPool = std::make_unique<boost::asio::thread_pool>(mConfig.threads);
+    }
   } catch (...) {
     // catch the exceptions and print it (the ultimate caller might not know how to display it)
     ILOG(Fatal, Ops) << "Unexpected exception during initialization: "
@@ -209,10 +223,20 @@ void CheckRunner::run(framework::ProcessingContext& ctx)
   prepareCacheData(ctx.inputs());
 
   auto qualityObjects = check();
+  const auto checkDone = latency_tracing::getCurrentTimestamp();
+  if (mConfig.latencyTracing) {
+    for (auto& qo : qualityObjects) {
+      qo->addMetadata(repository::metadata_keys::traceCheckRunnerInput, std::to_string(mInputTimestamp));
+      qo->addMetadata(repository::metadata_keys::traceCheckDone, std::to_string(checkDone));
+    }
+  }
 
   auto now = getCurrentTimestamp();
   store(qualityObjects, now);
   store(mMonitorObjectStoreVector, now);
+  if (mConfig.latencyTracing) {
+    traceLatencies(qualityObjects, checkDone);
+  }
 
   send(qualityObjects, ctx.outputs());
 
@@ -225,6 +249,8 @@ void CheckRunner::run(framework::ProcessingContext& ctx)
 void CheckRunner::prepareCacheData(framework::InputRecord& inputRecord)
 {
   mMonitorObjectStoreVector.clear();
+  mInputTimestamp = latency_tracing::getCurrentTimestamp();
+  mTracedFirstDataTimestamps.clear();
 
   for (const auto& input : mInputs) {
     auto dataRef = inputRecord.get(input.binding.c_str());
@@ -243,18 +269,21 @@ void CheckRunner::prepareCacheData(framework::InputRecord& inputRecord)
                            << " entries from " << input.binding << ENDM;
       } else {
         // it is just a TObject not embedded in a TObjArray. We build a TObjArray for it.
-        auto* newArray = new TObjArray();    // we cannot use `array` to add an object as it is const
-        TObject* newTObject = tobj->Clone(); // we need a copy to avoid that it gets deleted behind our back.
-        newArray->Add(newTObject);
-        array.reset(newArray); // now that the array is ready we can adopt it.
         ILOG(Debug, Devel) << "CheckRunner " << mDeviceName
                            << " received a tobject named " << tobj->GetName()
                            << " from " << input.binding << ENDM;
+        // The deserialized object belongs only to us, thus we can take it over instead of cloning it.
+        // Its ownership is passed to the MonitorObject created below, the array only references it.
+        auto* newArray = new TObjArray();
+        newArray->SetOwner(false);
+        newArray->Add(tobj.release());
+        array.reset(newArray);
       }
 
       // for each item of the array, check whether it is a MonitorObject. If not, create one and encapsulate.
       // Then, store the MonitorObject in the various maps and vectors we will use later.
       bool store = mInputStoreSet.count(DataSpecUtils::label(input)) > 0; // Check if this CheckRunner stores this input
+      std::optional<std::map<std::string, std::string>> trace;             // the objects of one input share their trace
       for (const auto tObject : *array) {
         std::shared_ptr<MonitorObject> mo{ dynamic_cast<MonitorObject*>(tObject) };
 
@@ -267,6 +296,12 @@ void CheckRunner::prepareCacheData(framework::InputRecord& inputRecord)
         }
 
         if (mo) {
+          if (mConfig.latencyTracing) {
+            mo->addOrUpdateMetadata(repository::metadata_keys::traceCheckRunnerInput, std::to_string(mInputTimestamp));
+            if (!trace.has_value() && mo->getMetadataMap().count(repository::metadata_keys::traceFirstData) > 0) {
+              trace = mo->getMetadataMap();
+            }
+          }
           mo->setIsOwner(true);
           mMonitorObjects[mo->getFullName()] = mo;
           updatePolicyManager.updateObjectRevision(mo->getFullName());
@@ -277,6 +312,30 @@ void CheckRunner::prepareCacheData(framework::InputRecord& inputRecord)
           }
         }
       }
+
+      if (trace.has_value()) {
+        latency_tracing::fillLatencies(trace.value(), mLatencies);
+        if (auto firstData = latency_tracing::getTimestamp(trace.value(), repository::metadata_keys::traceFirstData)) {
+          mTracedFirstDataTimestamps.push_back(firstData.value());
+        }
+      }
+
+      // A task publishing only the changed objects lists those it omitted. We consider that the cached versions
+      // were received again, so that the Checks which depend on them are not blocked by their update policies.
+      if (auto collection = dynamic_cast<MonitorObjectCollection*>(array.get())) {
+        for (const auto& unchangedName : collection->getUnchangedObjects()) {
+          auto fullName = collection->getTaskName() + "/" + unchangedName;
+          if (mMonitorObjects.count(fullName) > 0) {
+            updatePolicyManager.updateObjectRevision(fullName);
+          }
+        }
+        if (!collection->getMergeStatistics().empty()) {
+          // the collections carry totals, we report only the merges done since the previous collection of the task
+          auto& lastStatistics = mLastMergeStatistics[collection->getTaskName()];
+          core::addMergeStatistics(mMergeStatistics[collection->getTaskName()], core::getNewMergeStatistics(collection->getMergeStatistics(), lastStatistics));
+          lastStatistics = collection->getMergeStatistics();
+        }
+      }
     }
   }
 }
@@ -298,8 +357,67 @@ void CheckRunner::sendPeriodicMonitoring()
                        .addValue(rateQOs, "qos_per_second"));
     mCollector->send({ mTotalQOSent, "qc_checkrunner_qo_sent" });
     mCollector->send({ mTimerTotalDurationActivity.getTime(), "qc_checkrunner_duration" });
+    if (auto asyncDatabase = std::dynamic_pointer_cast<AsyncDatabase>(mDatabase)) {
+      auto stats = asyncDatabase->getAndResetStats();
+      mCollector->send(Metric{ "qc_checkrunner_async_store" }
+                         .addValue(stats.queueDepth, "queue_depth")
+                         .addValue(stats.stored, "uploaded")
+                         .addValue(stats.dropped, "dropped")
+                         .addValue(stats.coalesced, "coalesced")
+                         .addValue(stats.failed, "failed")
+                         .addValue(stats.meanUploadLatencyMs, "mean_latency_ms")
+                         .addValue(stats.maxUploadLatencyMs, "max_latency_ms"));
+    }
+    if (!mCheckDurationsMs.empty()) {
+      Metric checkDurations{ "qc_checkrunner_check_duration_ms" };
+      for (const auto& [checkName, duration] : mCheckDurationsMs) {
+        checkDurations.addValue(duration, checkName);
+      }
+      mCollector->send(checkDurations);
+    }
+    if (!mMergeStatistics.empty()) {
+      Metric mergeDurations{ "qc_merge_duration_ms" };
+      Metric mergeCounts{ "qc_merge_count" };
+      Metric fastMergeCounts{ "qc_merge_fast_count" };
+      for (const auto& [taskName, statistics] : mMergeStatistics) {
+        for (const auto& classStatistics : statistics) {
+          const auto name = taskName + "/" + classStatistics.className;
+          mergeDurations.addValue(classStatistics.durationMs, name);
+          mergeCounts.addValue(static_cast<uint64_t>(classStatistics.merges), name);
+          fastMergeCounts.addValue(static_cast<uint64_t>(classStatistics.fastMerges), name);
+        }
+      }
+      mCollector->send(mergeDurations);
+      mCollector->send(mergeCounts);
+      mCollector->send(fastMergeCounts);
+    }
+    for (const auto& [latencyName, latencies] : mLatencies) {
+      mCollector->send(latencies.toMetric("qc_latency_" + latencyName + "_ms"));
+    }
     mNumberQOStored = 0;
     mNumberMOStored = 0;
+    mLatencies.clear();
+    mCheckDurationsMs.clear();
+    mMergeStatistics.clear();
+  }
+}
+
+void CheckRunner::traceLatencies(const QualityObjectsType& qualityObjects, uint64_t checkDone)
+{
+  if (mTracedFirstDataTimestamps.empty()) {
+    return;
+  }
+  if (!qualityObjects.empty()) {
+    mLatencies["check"].fill(static_cast<double>(checkDone) - static_cast<double>(mInputTimestamp));
+  }
+  if (!mDatabase->storesSynchronously()) {
+    // the objects have been only queued, the upload latency is reported by AsyncDatabase
+    return;
+  }
+  const auto storeDone = latency_tracing::getCurrentTimestamp();
+  mLatencies["store"].fill(static_cast<double>(storeDone) - static_cast<double>(checkDone));
+  for (auto firstData : mTracedFirstDataTimestamps) {
+    mLatencies["total"].fill(static_cast<double>(storeDone) - static_cast<double>(firstData));
   }
 }
 
@@ -308,21 +426,57 @@ QualityObjectsType CheckRunner::check()
   ILOG(Debug, Devel) << "Trying " << mChecks.size() << " checks for " << mMonitorObjects.size() << " monitor objects"
                      << ENDM;
 
+  // only the Checks whose objects were updated are evaluated, the others are not ready for sure
+  std::vector<Check*> readyChecks;
+  for (const auto& checkName : updatePolicyManager.getReadyActors()) {
+    ILOG(Debug, Support) << "Monitor Objects for the check '" << checkName << "' are ready --> check()" << ENDM;
+    readyChecks.push_back(&mChecks.at(checkName));
+  }
+
+  // The results are kept per Check, so that they are merged in the same order regardless of the execution order.
+  std::vector<QualityObjectsType> qosPerCheck(readyChecks.size());
+  std::vector<double> durationsMs(readyChecks.size());
+  const bool parallel = mCheckThreadPool != nullptr && readyChecks.size() > 1;
+  auto runCheck = [&](size_t i) {
+    AliceO2::Common::Timer timer;
+    // beautification modifies the MOs, which might be read by other Checks at the same time, thus we postpone it
+    qosPerCheck[i] = readyChecks[i]->check(mMonitorObjects, !parallel);
+    durationsMs[i] = timer.getTime() * 1000.0;
+  };
+
+  if (parallel) {
+    std::vector<std::future<void>> results;
+    for (size_t i = 0; i < readyChecks.size(); i++) {
+      auto task = std::make_shared<std::packaged_task<void()>>([&runCheck, i]() { runCheck(i); });
+      results.emplace_back(task->get_future());
+      boost::asio::post(*mCheckThreadPool, [task]() { (*task)(); });
+    }
+    for (auto& result : results) {
+      result.wait();
+    }
+    for (auto& result : results) {
+      result.get(); // rethrows the exceptions thrown by the Checks, if any
+    }
+  } else {
+    for (size_t i = 0; i < readyChecks.size(); i++) {
+      runCheck(i);
+    }
+  }
+
   QualityObjectsType allQOs;
-  for (auto& [checkName, check] : mChecks) {
-    if (updatePolicyManager.isReady(check.getName())) {
-      ILOG(Debug, Support) << "Monitor Objects for the check '" << checkName << "' are ready --> check()" << ENDM;
-      auto newQOs = check.check(mMonitorObjects);
-      mTotalNumberCheckExecuted += newQOs.size();
-
-      allQOs.insert(allQOs.end(), std::make_move_iterator(newQOs.begin()), std::make_move_iterator(newQOs.end()));
-      newQOs.clear();
-
-      // Was checked, update latest revision
-      updatePolicyManager.updateActorRevision(checkName);
-    } else {
-      ILOG(Debug, Support) << "Monitor Objects for the check '" << checkName << "' are not ready, ignoring" << ENDM;
+  for (size_t i = 0; i < readyChecks.size(); i++) {
+    auto& check = *readyChecks[i];
+    if (parallel) {
+      check.beautify(mMonitorObjects, qosPerCheck[i]);
     }
+    mTotalNumberCheckExecuted += qosPerCheck[i].size();
+    auto& longestDuration = mCheckDurationsMs[check.getName()];
+    longestDuration = std::max(longestDuration, durationsMs[i]);
+
+    allQOs.insert(allQOs.end(), std::make_move_iterator(qosPerCheck[i].begin()), std::make_move_iterator(qosPerCheck[i].end()));
+
+    // Was checked, update latest revision
+    updatePolicyManager.updateActorRevision(check.getName());
   }
   return allQOs;
 }
@@ -412,9 +566,19 @@ void CheckRunner::updateServiceDiscovery(const QualityObjectsType& qualityObject
 
 void CheckRunner::initDatabase()
 {
-  mDatabase = DatabaseFactory::create(mConfig.database.at("implementation"));
+  const auto& implementation = mConfig.database.at("implementation");
+  if (mConfig.database.count("asyncUpload") && decodeBool(mConfig.database.at("asyncUpload"))) {
+    size_t workers = mConfig.database.count("asyncUploadWorkers") ? std::stoul(mConfig.database.at("asyncUploadWorkers")) : 1;
+    size_t queueSize = mConfig.database.count("asyncUploadQueueSize") ? std::stoul(mConfig.database.at("asyncUploadQueueSize")) : 1000;
+    ILOG(Info, Devel) << "Objects will be uploaded asynchronously with " << workers << " worker(s) and a queue of " << queueSize << " objects" << ENDM;
+    // the objects are serialized in the upload threads, while the main thread keeps using ROOT
+    ROOT::EnableThreadSafety();
+    mDatabase = std::make_shared<AsyncDatabase>([&implementation]() { return DatabaseFactory::create(implementation); }, workers, queueSize);
+  } else {
+    mDatabase = DatabaseFactory::create(implementation);
+  }
   mDatabase->connect(mConfig.database);
-  ILOG(Info, Devel) << "Database that is going to be used > Implementation : " << mConfig.database.at("implementation") << " / Host : " << mConfig.database.at("host") << ENDM;
+  ILOG(Info, Devel) << "Database that is going to be used > Implementation : " << implementation << " / Host : " << mConfig.database.at("host") << ENDM;
 }
 
 void CheckRunner::initMonitoring()
@@ -440,6 +604,10 @@ void CheckRunner::initLibraries()
 void CheckRunner::endOfStream(framework::EndOfStreamContext& eosContext)
 {
   mReceivedEOS = true;
+  if (auto asyncDatabase = std::dynamic_pointer_cast<AsyncDatabase>(mDatabase)) {
+    // we make sure that the last objects of the run are in the repository before we declare we are done
+    asyncDatabase->flush();
+  }
 }
 
 void CheckRunner::start(ServiceRegistryRef services)
@@ -451,6 +619,7 @@ void CheckRunner::start(ServiceRegistryRef services)
   mTimerTotalDurationActivity.reset();
   mCollector->setRunNumber(mActivity->mId);
   mReceivedEOS = false;
+  mLastMergeStatistics.clear();
   for (auto& [checkName, check] : mChecks) {
     check.startOfActivity(*mActivity);
   }
@@ -471,6 +640,9 @@ void CheckRunner::stop()
   for (auto& [checkName, check] : mChecks) {
     check.endOfActivity(*mActivity);
   }
+  if (auto asyncDatabase = std::dynamic_pointer_cast<AsyncDatabase>(mDatabase)) {
+    asyncDatabase->flush();
+  }
 }
 
 void CheckRunner::reset()
@@ -98,7 +98,9 @@ CheckRunnerConfig CheckRunnerFactory::extractConfig(const CommonSpec& commonSpec
     commonSpec.bookkeepingUrl,
     commonSpec.infologgerDiscardParameters,
     fallbackActivity,
-    options
+    options,
+    commonSpec.checkRunnerThreads,
+    commonSpec.latencyTracing
   };
 }
 
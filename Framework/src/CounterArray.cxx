@@ -0,0 +1,197 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CounterArray.cxx
+///
+
+#include "QualityControl/CounterArray.h"
+
+#include <TDirectory.h>
+#include <TH1D.h>
+#include <TH1F.h>
+#include <TH2D.h>
+#include <TH2F.h>
+#include <array>
+#include <cassert>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+namespace o2::quality_control::core
+{
+
+namespace
+{
+// the bins of a batch are computed first into a small buffer, so that the two loops can be optimized separately
+constexpr size_t BatchSize = 256;
+} // namespace
+
+template <typename T>
+CounterArray<T>::CounterArray(const char* name, const char* title, int nbinsx, double xmin, double xmax)
+  : TNamed(name, title),
+    mNBinsX(nbinsx),
+    mXMin(xmin),
+    mXMax(xmax),
+    mCounters(static_cast<size_t>(nbinsx + 2), 0)
+{
+  if (nbinsx <= 0 || !(xmin < xmax)) {
+    throw std::invalid_argument(std::string("Invalid binning of the CounterArray '") + name + "'");
+  }
+}
+
+template <typename T>
+CounterArray<T>::CounterArray(const char* name, const char* title, int nbinsx, double xmin, double xmax, int nbinsy, double ymin, double ymax)
+  : TNamed(name, title),
+    mNBinsX(nbinsx),
+    mNBinsY(nbinsy),
+    mXMin(xmin),
+    mXMax(xmax),
+    mYMin(ymin),
+    mYMax(ymax),
+    mCounters(static_cast<size_t>(nbinsx + 2) * static_cast<size_t>(nbinsy + 2), 0)
+{
+  if (nbinsx <= 0 || nbinsy <= 0 || !(xmin < xmax) || !(ymin < ymax)) {
+    throw std::invalid_argument(std::string("Invalid binning of the CounterArray '") + name + "'");
+  }
+}
+
+template <typename T>
+void CounterArray<T>::fill(std::span<const double> x)
+{
+  assert(getDimension() == 1);
+  std::array<size_t, BatchSize> indices;
+  for (size_t start = 0; start < x.size(); start += BatchSize) {
+    const size_t count = std::min(BatchSize, x.size() - start);
+    for (size_t i = 0; i < count; i++) {
+      indices[i] = findBin(x[start + i], mXMin, mXMax, mNBinsX);
+    }
+    for (size_t i = 0; i < count; i++) {
+      mCounters[indices[i]] += 1;
+    }
+  }
+  mEntries += x.size();
+}
+
+template <typename T>
+void CounterArray<T>::fill(std::span<const double> x, std::span<const double> y)
+{
+  assert(getDimension() == 2);
+  const size_t size = std::min(x.size(), y.size());
+  const size_t stride = mNBinsX + 2;
+  std::array<size_t, BatchSize> indices;
+  for (size_t start = 0; start < size; start += BatchSize) {
+    const size_t count = std::min(BatchSize, size - start);
+    for (size_t i = 0; i < count; i++) {
+      const size_t binx = findBin(x[start + i], mXMin, mXMax, mNBinsX);
+      const size_t biny = findBin(y[start + i], mYMin, mYMax, mNBinsY);
+      indices[i] = binx + stride * biny;
+    }
+    for (size_t i = 0; i < count; i++) {
+      mCounters[indices[i]] += 1;
+    }
+  }
+  mEntries += size;
+}
+
+template <typename T>
+void CounterArray<T>::fillBins(std::span<const int> binsX)
+{
+  assert(getDimension() == 1);
+  for (auto binx : binsX) {
+    mCounters[binx] += 1;
+  }
+  mEntries += binsX.size();
+}
+
+template <typename T>
+void CounterArray<T>::fillBins(std::span<const int> binsX, std::span<const int> binsY)
+{
+  assert(getDimension() == 2);
+  const size_t size = std::min(binsX.size(), binsY.size());
+  for (size_t i = 0; i < size; i++) {
+    mCounters[getIndex(binsX[i], binsY[i])] += 1;
+  }
+  mEntries += size;
+}
+
+template <typename T>
+double CounterArray<T>::getSum() const
+{
+  return std::accumulate(mCounters.begin(), mCounters.end(), 0.);
+}
+
+template <typename T>
+void CounterArray<T>::reset()
+{
+  std::fill(mCounters.begin(), mCounters.end(), 0);
+  mEntries = 0;
+}
+
+template <typename T>
+std::unique_ptr<TH1> CounterArray<T>::materialize() const
+{
+  using Histogram1D = std::conditional_t<std::is_same_v<T, Float_t>, TH1F, TH1D>;
+  using Histogram2D = std::conditional_t<std::is_same_v<T, Float_t>, TH2F, TH2D>;
+
+  // we do not want the histogram to be owned by the current directory
+  TDirectory::TContext context(nullptr);
+  std::unique_ptr<TH1> histogram;
+  if (getDimension() == 1) {
+    histogram = std::make_unique<Histogram1D>(GetName(), GetTitle(), mNBinsX, mXMin, mXMax);
+  } else {
+    histogram = std::make_unique<Histogram2D>(GetName(), GetTitle(), mNBinsX, mXMin, mXMax, mNBinsY, mYMin, mYMax);
+  }
+  fillHistogram(histogram.get());
+  return histogram;
+}
+
+template <typename T>
+void CounterArray<T>::fillHistogram(TH1* histogram) const
+{
+  if (histogram == nullptr) {
+    return;
+  }
+  if (histogram->GetDimension() != getDimension() || histogram->GetNbinsX() != mNBinsX || (getDimension() == 2 && histogram->GetNbinsY() != mNBinsY)) {
+    throw std::runtime_error(std::string("The binning of the histogram '") + histogram->GetName() + "' does not match the CounterArray '" + GetName() + "'");
+  }
+  const double previousEntries = histogram->GetEntries();
+  // the global bin numbers of ROOT histograms follow the same order as the counters
+  for (size_t bin = 0; bin < mCounters.size(); bin++) {
+    if (mCounters[bin] != 0) {
+      histogram->AddBinContent(static_cast<Int_t>(bin), mCounters[bin]);
+    }
+  }
+  // AddBinContent does not update the statistics, so that the mean and RMS would be the ones before adding the counters
+  histogram->ResetStats();
+  histogram->SetEntries(previousEntries + mEntries);
+}
+
+template <typename T>
+void CounterArray<T>::merge(o2::mergers::MergeInterface* const other)
+{
+  auto otherArray = dynamic_cast<CounterArray<T>*>(other);
+  if (otherArray == nullptr) {
+    throw std::runtime_error("The other object is not a CounterArray of the same type");
+  }
+  if (otherArray->mNBinsX != mNBinsX || otherArray->mNBinsY != mNBinsY || otherArray->mXMin != mXMin || otherArray->mXMax != mXMax || otherArray->mYMin != mYMin || otherArray->mYMax != mYMax) {
+    throw std::runtime_error(std::string("Cannot merge CounterArrays '") + GetName() + "' with different binnings");
+  }
+  std::transform(mCounters.begin(), mCounters.end(), otherArray->mCounters.begin(), mCounters.begin(), std::plus<T>());
+  mEntries += otherArray->mEntries;
+}
+
+template class CounterArray<UInt_t>;
+template class CounterArray<ULong64_t>;
+template class CounterArray<Float_t>;
+
+} // namespace o2::quality_control::core
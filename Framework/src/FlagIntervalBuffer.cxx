@@ -0,0 +1,153 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   FlagIntervalBuffer.cxx
+///
+
+#include "QualityControl/FlagIntervalBuffer.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace o2::quality_control::core
+{
+
+namespace
+{
+using Intervals = std::map<validity_time_t, validity_time_t>;
+
+// returns the first interval which ends after the provided time (or at it, if inclusive), as the ends are sorted
+Intervals::const_iterator firstEndingAfter(const Intervals& intervals, validity_time_t time, bool inclusive)
+{
+  auto it = intervals.upper_bound(time);
+  if (it != intervals.begin()) {
+    auto previous = std::prev(it);
+    if (previous->second > time || (inclusive && previous->second == time)) {
+      return previous;
+    }
+  }
+  return it;
+}
+} // namespace
+
+FlagIntervalBuffer::Kind FlagIntervalBuffer::getKind(const FlagType& flagType, const std::string& comment)
+{
+  auto [commentIt, _] = mComments.emplace(comment, mComments.size());
+  auto [kindIt, inserted] = mKindLookup.emplace(std::make_pair(flagType.getID(), commentIt->second), mKinds.size());
+  if (inserted) {
+    mKinds.push_back({ flagType, comment });
+    mIntervals.emplace_back();
+  }
+  return kindIt->second;
+}
+
+void FlagIntervalBuffer::insert(Kind kind, ValidityInterval interval)
+{
+  mIntervals.at(kind).emplace(interval.getMin(), interval.getMax());
+}
+
+ValidityInterval FlagIntervalBuffer::takeConnecting(Kind kind, ValidityInterval interval)
+{
+  auto& intervals = mIntervals.at(kind);
+  auto it = firstEndingAfter(intervals, interval.getMin(), true);
+  while (it != intervals.end() && it->first <= interval.getMax()) {
+    interval.update(it->first);
+    interval.update(it->second);
+    it = intervals.erase(it);
+  }
+  return interval;
+}
+
+void FlagIntervalBuffer::exclude(Kind kind, ValidityInterval interval)
+{
+  auto& intervals = mIntervals.at(kind);
+  std::vector<std::pair<validity_time_t, validity_time_t>> remainders;
+  auto it = firstEndingAfter(intervals, interval.getMin(), false);
+  while (it != intervals.end() && it->first < interval.getMax()) {
+    if (it->first < interval.getMin()) {
+      remainders.emplace_back(it->first, interval.getMin());
+    }
+    if (it->second > interval.getMax()) {
+      remainders.emplace_back(interval.getMax(), it->second);
+    }
+    it = intervals.erase(it);
+  }
+  intervals.insert(remainders.begin(), remainders.end());
+}
+
+std::vector<ValidityInterval> FlagIntervalBuffer::getOverlapping(Kind kind, ValidityInterval interval) const
+{
+  const auto& intervals = mIntervals.at(kind);
+  std::vector<ValidityInterval> result;
+  for (auto it = firstEndingAfter(intervals, interval.getMin(), false); it != intervals.end() && it->first < interval.getMax(); ++it) {
+    result.emplace_back(it->first, it->second);
+  }
+  return result;
+}
+
+void FlagIntervalBuffer::intersect(ValidityInterval interval)
+{
+  for (auto& intervals : mIntervals) {
+    Intervals trimmed;
+    for (auto it = firstEndingAfter(intervals, interval.getMin(), false); it != intervals.end() && it->first < interval.getMax(); ++it) {
+      trimmed.emplace(std::max(it->first, interval.getMin()), std::min(it->second, interval.getMax()));
+    }
+    intervals.swap(trimmed);
+  }
+}
+
+std::vector<ValidityInterval> FlagIntervalBuffer::takeEndingBefore(Kind kind, validity_time_t time)
+{
+  auto& intervals = mIntervals.at(kind);
+  std::vector<ValidityInterval> result;
+  auto it = intervals.begin();
+  for (; it != intervals.end() && it->second < time; ++it) {
+    result.emplace_back(it->first, it->second);
+  }
+  intervals.erase(intervals.begin(), it);
+  return result;
+}
+
+void FlagIntervalBuffer::erase(Kind kind)
+{
+  mIntervals.at(kind).clear();
+}
+
+void FlagIntervalBuffer::clear()
+{
+  for (auto& intervals : mIntervals) {
+    intervals.clear();
+  }
+}
+
+size_t FlagIntervalBuffer::size() const
+{
+  size_t size = 0;
+  for (const auto& intervals : mIntervals) {
+    size += intervals.size();
+  }
+  return size;
+}
+
+std::vector<QualityControlFlag> FlagIntervalBuffer::getFlags(const std::string& source) const
+{
+  std::vector<QualityControlFlag> flags;
+  flags.reserve(size());
+  for (Kind kind = 0; kind < mKinds.size(); kind++) {
+    for (const auto& [start, end] : mIntervals[kind]) {
+      flags.emplace_back(start, end, mKinds[kind].flagType, mKinds[kind].comment, source);
+    }
+  }
+  return flags;
+}
+
+} // namespace o2::quality_control::core
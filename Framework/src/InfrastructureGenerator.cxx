@@ -794,7 +794,11 @@ void InfrastructureGenerator::generateBookkeepingQualitySink(WorkflowSpec& workf
     .outputs = Outputs{},
     .algorithm = adaptFromTask<quality_control::core::BookkeepingQualitySink>(
       infrastructureSpec.common.bookkeepingUrl,
-      core::toEnum(infrastructureSpec.common.activityProvenance)),
+      core::toEnum(infrastructureSpec.common.activityProvenance),
+      BookkeepingQualitySink::send,
+      BookkeepingQualitySink::StreamingConfig{
+        .flushPeriodSeconds = infrastructureSpec.common.bookkeepingFlagsFlushPeriodSeconds,
+        .maxBufferedFlags = infrastructureSpec.common.bookkeepingMaxBufferedFlags }),
     .labels = { { "resilient" }, BookkeepingQualitySink::getLabel() }
   };
   workflow.emplace_back(std::move(sinkDataProcessor));
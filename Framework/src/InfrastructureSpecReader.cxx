@@ -73,6 +73,7 @@ CommonSpec InfrastructureSpecReader::readSpecEntry<CommonSpec>(const std::string
   spec.activityFillNumber = commonTree.get<int>("Activity.fillNumber", spec.activityFillNumber);
   spec.activityOriginalNumber = commonTree.get<int>("Activity.originalNumber", spec.activityOriginalNumber);
   spec.monitoringUrl = commonTree.get<std::string>("monitoring.url", spec.monitoringUrl);
+  spec.latencyTracing = commonTree.get<bool>("monitoring.latencyTracing", spec.latencyTracing);
   spec.consulUrl = commonTree.get<std::string>("consul.url", spec.consulUrl);
   spec.conditionDBUrl = commonTree.get<std::string>("conditionDB.url", spec.conditionDBUrl);
   spec.infologgerDiscardParameters = {
@@ -85,8 +86,11 @@ CommonSpec InfrastructureSpecReader::readSpecEntry<CommonSpec>(const std::string
   };
   spec.postprocessingPeriod = commonTree.get<double>("postprocessing.periodSeconds", spec.postprocessingPeriod);
   spec.bookkeepingUrl = commonTree.get<std::string>("bookkeeping.url", spec.bookkeepingUrl);
+  spec.bookkeepingFlagsFlushPeriodSeconds = commonTree.get<double>("bookkeeping.flagsFlushPeriodSeconds", spec.bookkeepingFlagsFlushPeriodSeconds);
+  spec.bookkeepingMaxBufferedFlags = commonTree.get<size_t>("bookkeeping.maxBufferedFlags", spec.bookkeepingMaxBufferedFlags);
   spec.kafkaBrokersUrl = commonTree.get<std::string>("kafka.url", spec.kafkaBrokersUrl);
   spec.kafkaTopicAliECSRun = commonTree.get<std::string>("kafka.topicAliecsRun", spec.kafkaTopicAliECSRun);
+  spec.checkRunnerThreads = commonTree.get<size_t>("checkRunner.threads", spec.checkRunnerThreads);
 
   return spec;
 }
@@ -128,6 +132,8 @@ TaskSpec InfrastructureSpecReader::readSpecEntry<TaskSpec>(const std::string& ta
   ts.maxNumberCycles = taskTree.get<int>("maxNumberCycles", ts.maxNumberCycles);
   ts.resetAfterCycles = taskTree.get<size_t>("resetAfterCycles", ts.resetAfterCycles);
   ts.saveObjectsToFile = taskTree.get<std::string>("saveObjectsToFile", ts.saveObjectsToFile);
+  ts.publishChangedObjectsOnly = taskTree.get<bool>("publishChangedObjectsOnly", ts.publishChangedObjectsOnly);
+  ts.parallelWorkers = taskTree.get<size_t>("parallelWorkers", ts.parallelWorkers);
   if (taskTree.count("extendedTaskParameters") > 0 && taskTree.count("taskParameters") > 0) {
     ILOG(Warning, Devel) << "Both taskParameters and extendedTaskParameters are defined in the QC config file. We will use only extendedTaskParameters. " << ENDM;
   }
@@ -0,0 +1,100 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   LatencyTracing.cxx
+///
+
+#include "QualityControl/LatencyTracing.h"
+#include "QualityControl/ObjectMetadataKeys.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+
+namespace o2::quality_control::core::latency_tracing
+{
+
+namespace
+{
+// the stages in the order in which the objects go through them, with the name of the latency which they end
+constexpr std::array<std::pair<const char*, const char*>, 5> Stages{ {
+  { repository::metadata_keys::traceFirstData, nullptr },
+  { repository::metadata_keys::traceCycleEnd, "cycle" },
+  { repository::metadata_keys::traceSnapshot, "publication" },
+  { repository::metadata_keys::traceCheckRunnerInput, "transport" },
+  { repository::metadata_keys::traceCheckDone, "check" },
+} };
+} // namespace
+
+void LatencyHistogram::fill(double latencyMs)
+{
+  latencyMs = std::max(latencyMs, 0.); // the clocks of different machines might not be perfectly synchronized
+  const auto bucket = std::lower_bound(BucketEdgesMs.begin(), BucketEdgesMs.end(), latencyMs) - BucketEdgesMs.begin();
+  mBuckets[bucket]++;
+  mCount++;
+  mSum += latencyMs;
+  mMax = std::max(mMax, latencyMs);
+}
+
+void LatencyHistogram::reset()
+{
+  mBuckets.fill(0);
+  mCount = 0;
+  mSum = 0;
+  mMax = 0;
+}
+
+o2::monitoring::Metric LatencyHistogram::toMetric(const std::string& name) const
+{
+  o2::monitoring::Metric metric{ name };
+  metric.addValue(mCount, "count");
+  metric.addValue(getMean(), "mean");
+  metric.addValue(mMax, "max");
+  for (size_t i = 0; i < BucketEdgesMs.size(); i++) {
+    metric.addValue(mBuckets[i], "le_" + std::to_string(BucketEdgesMs[i]));
+  }
+  metric.addValue(mBuckets.back(), "le_inf");
+  return metric;
+}
+
+uint64_t getCurrentTimestamp()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::optional<uint64_t> getTimestamp(const std::map<std::string, std::string>& metadata, const std::string& key)
+{
+  auto it = metadata.find(key);
+  if (it == metadata.end()) {
+    return std::nullopt;
+  }
+  uint64_t timestamp{};
+  const auto& value = it->second;
+  if (auto result = std::from_chars(value.data(), value.data() + value.size(), timestamp); result.ec != std::errc{}) {
+    return std::nullopt;
+  }
+  return timestamp;
+}
+
+void fillLatencies(const std::map<std::string, std::string>& metadata, std::map<std::string, LatencyHistogram>& latencies)
+{
+  std::optional<uint64_t> previous;
+  for (const auto& [key, latencyName] : Stages) {
+    auto current = getTimestamp(metadata, key);
+    if (previous.has_value() && current.has_value() && latencyName != nullptr) {
+      latencies[latencyName].fill(static_cast<double>(*current) - static_cast<double>(*previous));
+    }
+    previous = current;
+  }
+}
+
+} // namespace o2::quality_control::core::latency_tracing
@@ -0,0 +1,213 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ListingPoller.cxx
+///
+
+#include "QualityControl/ListingPoller.h"
+#include "QualityControl/CcdbDatabase.h"
+#include "QualityControl/ObjectMetadataKeys.h"
+#include "QualityControl/ObjectMetadataHelpers.h"
+#include "QualityControl/QcInfoLogger.h"
+
+using namespace std::chrono;
+using namespace o2::quality_control::core;
+using namespace o2::quality_control::repository;
+
+namespace o2::quality_control::postprocessing
+{
+
+ListingPoller::ListingPoller(ListingFunction listing, milliseconds maxListingAge, milliseconds maxCompletenessWait)
+  : mListing(std::move(listing)), mMaxListingAge(maxListingAge), mMaxCompletenessWait(maxCompletenessWait)
+{
+}
+
+std::shared_ptr<ListingPoller> ListingPoller::getInstance(const std::string& databaseUrl)
+{
+  static std::mutex instancesMutex;
+  static std::unordered_map<std::string, std::weak_ptr<ListingPoller>> instances;
+
+  std::lock_guard<std::mutex> lock(instancesMutex);
+  if (auto instance = instances[databaseUrl].lock()) {
+    return instance;
+  }
+  auto db = std::make_shared<CcdbDatabase>();
+  db->connect(databaseUrl, "", "", "");
+  auto instance = std::make_shared<ListingPoller>([db](const std::string& path, const std::map<std::string, std::string>& metadata, bool latestOnly) {
+    return db->getListingAsPtree(path, metadata, latestOnly);
+  });
+  instances[databaseUrl] = instance;
+  return instance;
+}
+
+std::shared_ptr<ListingPoller::Subscription> ListingPoller::subscribe(const std::string& objectPath, const std::map<std::string, std::string>& metadata)
+{
+  // an object outside any directory is listed alone
+  const auto separator = objectPath.find_last_of('/');
+  auto listingPath = separator == std::string::npos ? objectPath : objectPath.substr(0, separator) + "/.*";
+  auto groupKey = listingPath;
+  for (const auto& [key, value] : metadata) {
+    groupKey += "/" + key + "=" + value;
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto subscription = std::make_shared<Subscription>();
+  subscription->mPath = objectPath;
+  subscription->mGroupKey = groupKey;
+
+  auto [groupIt, inserted] = mGroups.try_emplace(groupKey);
+  auto& group = groupIt->second;
+  if (inserted || steady_clock::now() - group.lastRefresh > mMaxListingAge) {
+    group.listingPath = listingPath;
+    group.metadata = metadata;
+    refresh(group);
+  }
+  // the versions existing before subscribing are not reported
+  if (auto object = group.objects.find(objectPath); object != group.objects.end()) {
+    subscription->mLastModified = object->second.lastModified;
+    subscription->mCycle = object->second.cycle;
+  }
+  subscription->mConsumedRefreshes = group.refreshes;
+  mStats.subscriptions++;
+  return subscription;
+}
+
+void ListingPoller::refresh(Group& group)
+{
+  // one listing with the latest version of each object in the directory serves all the subscriptions of the group
+  auto listing = mListing(group.listingPath, group.metadata, true);
+  mStats.listings++;
+  group.lastRefresh = steady_clock::now();
+  group.refreshes++;
+  if (listing.count("objects") == 0) {
+    ILOG(Warning, Support) << "Could not get a valid listing for '" << group.listingPath << "'" << ENDM;
+    return;
+  }
+
+  std::unordered_map<std::string, ListedObject> objects;
+  for (const auto& [_, object] : listing.get_child("objects")) {
+    ListedObject listed;
+    listed.lastModified = object.get<uint64_t>(metadata_keys::lastModified, 0);
+    listed.validity = { object.get<uint64_t>(metadata_keys::validFrom, 0), object.get<uint64_t>(metadata_keys::validUntil, 0) };
+    if (auto cycle = object.get_optional<std::string>(metadata_keys::cycleNumber)) {
+      listed.cycle = parseCycle(cycle.value());
+    }
+    auto path = object.get<std::string>("path", "");
+    if (auto existing = objects.find(path); existing == objects.end() || existing->second.lastModified < listed.lastModified) {
+      objects[path] = listed;
+    }
+  }
+
+  bool changed = objects.size() != group.objects.size();
+  for (auto it = objects.begin(); !changed && it != objects.end(); ++it) {
+    auto previous = group.objects.find(it->first);
+    changed = previous == group.objects.end() || previous->second.lastModified != it->second.lastModified;
+  }
+  if (changed) {
+    group.revision++;
+  }
+  group.objects = std::move(objects);
+}
+
+ValidityInterval ListingPoller::poll(Subscription& subscription)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  dropExpiredFullListings();
+  auto& group = mGroups.at(subscription.mGroupKey);
+  // the listing is refreshed only if this subscription has already seen it, so that all the triggers checked
+  // one after another share the same listing
+  if (subscription.mConsumedRefreshes == group.refreshes || steady_clock::now() - group.lastRefresh > mMaxListingAge) {
+    refresh(group);
+  }
+  subscription.mConsumedRefreshes = group.refreshes;
+
+  if (auto object = group.objects.find(subscription.mPath); object != group.objects.end()) {
+    const auto& listed = object->second;
+    if (listed.lastModified > subscription.mLastModified) {
+      // a new version, it replaces the one we were possibly waiting for
+      subscription.mPending = Subscription::PendingVersion{ listed.validity, listed.cycle, subscription.mCycle, group.revision, group.refreshes, steady_clock::now() };
+      subscription.mLastModified = listed.lastModified;
+      subscription.mCycle = listed.cycle;
+    }
+  } else {
+    // We don't make a fuss over it, because we might be just waiting for the first version of such object.
+    ILOG(Debug, Devel) << "Could not find the object '" << subscription.mPath << "' in the listing of its directory" << ENDM;
+  }
+
+  if (subscription.mPending.has_value() && isComplete(group, subscription.mPending.value())) {
+    auto validity = subscription.mPending->validity;
+    subscription.mPending.reset();
+    return validity;
+  }
+  return gInvalidValidityInterval;
+}
+
+bool ListingPoller::isComplete(const Group& group, const Subscription::PendingVersion& pending) const
+{
+  if (getenv("QC_DISABLE_NEWOBJECT_DELAY") != nullptr || !pending.cycle.has_value()) {
+    return true;
+  }
+  // The objects of the directory which are still at an older cycle of the same series (i.e. not older than the
+  // previous version of our object) are probably about to be published.
+  auto cycle = pending.cycle.value();
+  auto oldestCycleOfSeries = pending.previousCycle.has_value() && pending.previousCycle.value() < cycle ? pending.previousCycle.value() : 0;
+  bool waitingForSiblings = false;
+  for (const auto& [_, object] : group.objects) {
+    if (object.cycle.has_value() && object.cycle.value() < cycle && object.cycle.value() >= oldestCycleOfSeries) {
+      waitingForSiblings = true;
+      break;
+    }
+  }
+  if (!waitingForSiblings) {
+    return true;
+  }
+  // some objects are not updated in each cycle, we do not wait for them forever
+  bool directoryStable = group.refreshes > pending.groupRefreshes && group.revision == pending.groupRevision;
+  bool waitedTooLong = steady_clock::now() - pending.detected > mMaxCompletenessWait;
+  return directoryStable || waitedTooLong;
+}
+
+boost::property_tree::ptree ListingPoller::getFullListing(const std::string& objectPath)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    dropExpiredFullListings();
+    if (auto fullListing = mFullListings.find(objectPath); fullListing != mFullListings.end()) {
+      return fullListing->second.listing;
+    }
+  }
+
+  // the other triggers should not wait for this request, even if they might request the same listing meanwhile
+  auto listing = mListing(objectPath, {}, false);
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  mFullListings[objectPath] = FullListing{ listing, steady_clock::now() };
+  mStats.listings++;
+  return listing;
+}
+
+void ListingPoller::dropExpiredFullListings()
+{
+  // the full listings may be large, we keep them only as long as they can be shared
+  const auto now = steady_clock::now();
+  std::erase_if(mFullListings, [&](const auto& entry) { return now - entry.second.retrieved > mMaxListingAge; });
+}
+
+ListingPoller::Stats ListingPoller::getStats() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  Stats stats = mStats;
+  stats.groups = mGroups.size();
+  return stats;
+}
+
+} // namespace o2::quality_control::postprocessing
@@ -0,0 +1,133 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   MergeHelpers.cxx
+///
+
+#include "QualityControl/MergeHelpers.h"
+
+#include <TArrayD.h>
+#include <TArrayF.h>
+#include <TH1.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+#include <TProfile3D.h>
+#include <algorithm>
+#include <array>
+
+namespace o2::quality_control::core::merge_helpers
+{
+
+namespace
+{
+bool haveSameAxis(const TAxis* a, const TAxis* b)
+{
+  if (a->GetNbins() != b->GetNbins() || a->GetXmin() != b->GetXmin() || a->GetXmax() != b->GetXmax()) {
+    return false;
+  }
+  // ROOT matches labelled bins by their labels, which may be in a different order
+  if (a->GetLabels() != nullptr || b->GetLabels() != nullptr) {
+    return false;
+  }
+  // the statistics would be computed only in the range
+  if (a->TestBit(TAxis::kAxisRange) || b->TestBit(TAxis::kAxisRange)) {
+    return false;
+  }
+  const auto* edgesA = a->GetXbins();
+  const auto* edgesB = b->GetXbins();
+  return edgesA->GetSize() == edgesB->GetSize() && std::equal(edgesA->GetArray(), edgesA->GetArray() + edgesA->GetSize(), edgesB->GetArray());
+}
+
+bool isProfile(const TH1* histogram)
+{
+  return histogram->InheritsFrom(TProfile::Class()) || histogram->InheritsFrom(TProfile2D::Class()) || histogram->InheritsFrom(TProfile3D::Class());
+}
+
+// histograms inherit their storage from one of the TArray classes
+template <typename Array>
+bool addBinArrays(TH1* target, const TH1* other)
+{
+  auto targetArray = dynamic_cast<Array*>(target);
+  auto otherArray = dynamic_cast<const Array*>(other);
+  if (targetArray == nullptr || otherArray == nullptr) {
+    return false;
+  }
+  auto* targetBins = targetArray->GetArray();
+  const auto* otherBins = otherArray->GetArray();
+  const Int_t size = std::min(targetArray->GetSize(), otherArray->GetSize());
+  // a plain loop over contiguous arrays, which the compiler vectorizes
+  for (Int_t i = 0; i < size; i++) {
+    targetBins[i] += otherBins[i];
+  }
+  return true;
+}
+} // namespace
+
+bool mergeHistograms(TObject* target, const TObject* other)
+{
+  auto targetHistogram = dynamic_cast<TH1*>(target);
+  auto otherHistogram = dynamic_cast<const TH1*>(other);
+  if (targetHistogram == nullptr || otherHistogram == nullptr || targetHistogram->IsA() != otherHistogram->IsA()) {
+    return false;
+  }
+  if (isProfile(targetHistogram)) {
+    return false;
+  }
+  // averaged histograms are merged by ROOT as weighted means, not sums
+  if (targetHistogram->TestBit(TH1::kIsAverage) || otherHistogram->TestBit(TH1::kIsAverage)) {
+    return false;
+  }
+  if (targetHistogram->GetNcells() != otherHistogram->GetNcells() || targetHistogram->GetBuffer() != nullptr || otherHistogram->GetBuffer() != nullptr) {
+    return false;
+  }
+  if ((targetHistogram->GetSumw2N() > 0) != (otherHistogram->GetSumw2N() > 0)) {
+    return false;
+  }
+  const TAxis* targetAxes[] = { targetHistogram->GetXaxis(), targetHistogram->GetYaxis(), targetHistogram->GetZaxis() };
+  const TAxis* otherAxes[] = { otherHistogram->GetXaxis(), otherHistogram->GetYaxis(), otherHistogram->GetZaxis() };
+  for (int i = 0; i < targetHistogram->GetDimension(); i++) {
+    if (!haveSameAxis(targetAxes[i], otherAxes[i])) {
+      return false;
+    }
+  }
+
+  // the statistics are read before modifying the bins, because ROOT may compute them from the bin contents
+  std::array<double, TH1::kNstat> targetStats{};
+  std::array<double, TH1::kNstat> otherStats{};
+  targetHistogram->GetStats(targetStats.data());
+  otherHistogram->GetStats(otherStats.data());
+  const double entries = targetHistogram->GetEntries() + otherHistogram->GetEntries();
+
+  // Integer bins are left to ROOT, which caps them at the maximum of their type instead of letting them overflow.
+  const bool added = addBinArrays<TArrayF>(targetHistogram, otherHistogram) ||
+                     addBinArrays<TArrayD>(targetHistogram, otherHistogram);
+  if (!added) {
+    return false;
+  }
+  if (targetHistogram->GetSumw2N() > 0) {
+    auto* targetSumw2 = targetHistogram->GetSumw2()->GetArray();
+    const auto* otherSumw2 = otherHistogram->GetSumw2()->GetArray();
+    const Int_t size = std::min(targetHistogram->GetSumw2N(), otherHistogram->GetSumw2N());
+    for (Int_t i = 0; i < size; i++) {
+      targetSumw2[i] += otherSumw2[i];
+    }
+  }
+
+  for (size_t i = 0; i < targetStats.size(); i++) {
+    targetStats[i] += otherStats[i];
+  }
+  targetHistogram->PutStats(targetStats.data());
+  targetHistogram->SetEntries(entries);
+  return true;
+}
+
+} // namespace o2::quality_control::core::merge_helpers
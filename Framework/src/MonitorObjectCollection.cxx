@@ -19,9 +19,13 @@
 #include "QualityControl/ObjectMetadataKeys.h"
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/ObjectMetadataHelpers.h"
+#include "QualityControl/MergeHelpers.h"
+#include "QualityControl/LatencyTracing.h"
 
 #include <Mergers/MergerAlgorithm.h>
 #include <TNamed.h>
+#include <algorithm>
+#include <chrono>
 #include <optional>
 #include <string>
 
@@ -30,6 +34,162 @@ using namespace o2::mergers;
 namespace o2::quality_control::core
 {
 
+MonitorObjectCollection::MonitorObjectCollection(const MonitorObjectCollection& other)
+  : TObjArray(other),
+    MergeInterface(other),
+    mDetector(other.mDetector),
+    mTaskName(other.mTaskName),
+    mUnchangedObjects(other.mUnchangedObjects),
+    mMergeStatistics(other.mMergeStatistics)
+{
+  // the index is rebuilt on the first lookup, so that copies which are never searched remain cheap
+}
+
+void MonitorObjectCollection::buildIndex() const
+{
+  mIndex.clear();
+  mIndex.reserve(GetEntriesFast());
+  for (auto obj : *this) {
+    mIndex.emplace(obj->GetName(), obj);
+  }
+  mIndexValid = true;
+}
+
+void MonitorObjectCollection::invalidateIndex()
+{
+  mIndex.clear();
+  mIndexValid = false;
+}
+
+void MonitorObjectCollection::addToIndex(TObject* obj)
+{
+  // emplace does not overwrite, so adding the same object twice is harmless
+  if (mIndexValid && obj != nullptr) {
+    mIndex.emplace(obj->GetName(), obj);
+  }
+}
+
+TObject* MonitorObjectCollection::slotContent(Int_t idx) const
+{
+  return (idx >= LowerBound() && idx - LowerBound() < GetEntriesFast()) ? UncheckedAt(idx) : nullptr;
+}
+
+TObject* MonitorObjectCollection::FindObject(const char* name) const
+{
+  if (name == nullptr) {
+    return nullptr;
+  }
+  if (!mIndexValid) {
+    buildIndex();
+  }
+  auto it = mIndex.find(name);
+  return it != mIndex.end() ? it->second : nullptr;
+}
+
+void MonitorObjectCollection::Add(TObject* obj)
+{
+  AddLast(obj);
+}
+
+void MonitorObjectCollection::AddFirst(TObject* obj)
+{
+  TObjArray::AddFirst(obj);
+  invalidateIndex();
+}
+
+void MonitorObjectCollection::AddLast(TObject* obj)
+{
+  TObjArray::AddLast(obj);
+  addToIndex(obj);
+}
+
+void MonitorObjectCollection::AddAt(TObject* obj, Int_t idx)
+{
+  bool replacing = slotContent(idx) != nullptr;
+  TObjArray::AddAt(obj, idx);
+  if (replacing) {
+    invalidateIndex();
+  } else {
+    addToIndex(obj);
+  }
+}
+
+void MonitorObjectCollection::AddAtAndExpand(TObject* obj, Int_t idx)
+{
+  bool replacing = slotContent(idx) != nullptr;
+  TObjArray::AddAtAndExpand(obj, idx);
+  if (replacing) {
+    invalidateIndex();
+  } else {
+    addToIndex(obj);
+  }
+}
+
+Int_t MonitorObjectCollection::AddAtFree(TObject* obj)
+{
+  auto idx = TObjArray::AddAtFree(obj);
+  addToIndex(obj);
+  return idx;
+}
+
+TObject* MonitorObjectCollection::Remove(TObject* obj)
+{
+  invalidateIndex();
+  return TObjArray::Remove(obj);
+}
+
+TObject* MonitorObjectCollection::RemoveAt(Int_t idx)
+{
+  invalidateIndex();
+  return TObjArray::RemoveAt(idx);
+}
+
+void MonitorObjectCollection::RemoveRange(Int_t idx1, Int_t idx2)
+{
+  invalidateIndex();
+  TObjArray::RemoveRange(idx1, idx2);
+}
+
+void MonitorObjectCollection::Clear(Option_t* option)
+{
+  invalidateIndex();
+  TObjArray::Clear(option);
+}
+
+void MonitorObjectCollection::Delete(Option_t* option)
+{
+  invalidateIndex();
+  TObjArray::Delete(option);
+}
+
+namespace
+{
+MergeStatistics& findMergeStatistics(std::vector<MergeStatistics>& statistics, const std::string& className)
+{
+  // there are only a few classes per collection, a linear search is the fastest
+  auto it = std::find_if(statistics.begin(), statistics.end(), [&](const MergeStatistics& entry) { return entry.className == className; });
+  if (it != statistics.end()) {
+    return *it;
+  }
+  return statistics.emplace_back(MergeStatistics{ className });
+}
+
+// The merged object is as late as its latest input, thus we keep the latest timestamp of each stage.
+void mergeTraceTimestamps(MonitorObject* targetMO, const MonitorObject* otherMO)
+{
+  for (const auto* key : { repository::metadata_keys::traceFirstData, repository::metadata_keys::traceCycleEnd, repository::metadata_keys::traceSnapshot }) {
+    const auto otherTimestamp = latency_tracing::getTimestamp(otherMO->getMetadataMap(), key);
+    if (!otherTimestamp.has_value()) {
+      continue;
+    }
+    const auto targetTimestamp = latency_tracing::getTimestamp(targetMO->getMetadataMap(), key);
+    if (!targetTimestamp.has_value() || targetTimestamp.value() < otherTimestamp.value()) {
+      targetMO->addOrUpdateMetadata(key, std::to_string(otherTimestamp.value()));
+    }
+  }
+}
+} // namespace
+
 void mergeCycles(MonitorObject* targetMO, MonitorObject* otherMO)
 {
   const auto otherCycle = otherMO->getMetadata(repository::metadata_keys::cycleNumber);
@@ -90,6 +250,7 @@ void MonitorObjectCollection::merge(mergers::MergeInterface* const other)
       }
 
       mergeCycles(targetMO, otherMO);
+      mergeTraceTimestamps(targetMO, otherMO);
 
       if (!reportedMismatchingRunNumbers && otherMO->getActivity().mId < targetMO->getActivity().mId) {
         ILOG(Error, Ops) << "The run number of the input object '" << otherMO->GetName() << "' ("
@@ -103,8 +264,15 @@ void MonitorObjectCollection::merge(mergers::MergeInterface* const other)
         continue;
       }
 
-      // That might be another collection or a concrete object to be merged, we walk on the collection recursively.
-      algorithm::merge(targetMO->getObject(), otherMO->getObject());
+      // Histograms with the same binning are added directly, anything else is merged by Mergers,
+      // which walk recursively on collections.
+      const auto mergeStart = std::chrono::steady_clock::now();
+      const bool fastMerge = merge_helpers::mergeHistograms(targetMO->getObject(), otherMO->getObject());
+      if (!fastMerge) {
+        algorithm::merge(targetMO->getObject(), otherMO->getObject());
+      }
+      const std::chrono::duration<double, std::milli> mergeDuration = std::chrono::steady_clock::now() - mergeStart;
+      recordMerge(targetMO->getObject()->ClassName(), fastMerge, mergeDuration.count());
       if (otherMO->getValidity().isValid()) {
         if (targetMO->getValidity().isInvalid()) {
           targetMO->setValidity(otherMO->getValidity());
@@ -120,6 +288,57 @@ void MonitorObjectCollection::merge(mergers::MergeInterface* const other)
     }
   }
   delete otherIterator;
+
+  // The objects which the other side did not send because they did not change remain as they are in the target.
+  // We keep listing as unchanged only those which the merged collection does not contain at all.
+  for (const auto& unchangedName : otherCollection->getUnchangedObjects()) {
+    if (std::find(mUnchangedObjects.begin(), mUnchangedObjects.end(), unchangedName) == mUnchangedObjects.end()) {
+      mUnchangedObjects.push_back(unchangedName);
+    }
+  }
+  std::erase_if(mUnchangedObjects, [this](const std::string& name) { return this->FindObject(name.c_str()) != nullptr; });
+
+  addMergeStatistics(mMergeStatistics, otherCollection->mMergeStatistics);
+}
+
+void addMergeStatistics(std::vector<MergeStatistics>& target, const std::vector<MergeStatistics>& other)
+{
+  for (const auto& otherStatistics : other) {
+    auto& statistics = findMergeStatistics(target, otherStatistics.className);
+    statistics.merges += otherStatistics.merges;
+    statistics.fastMerges += otherStatistics.fastMerges;
+    statistics.durationMs += otherStatistics.durationMs;
+  }
+}
+
+std::vector<MergeStatistics> getNewMergeStatistics(const std::vector<MergeStatistics>& current, const std::vector<MergeStatistics>& previous)
+{
+  std::vector<MergeStatistics> newStatistics;
+  for (const auto& currentStatistics : current) {
+    auto it = std::find_if(previous.begin(), previous.end(), [&](const MergeStatistics& entry) { return entry.className == currentStatistics.className; });
+    if (it == previous.end() || it->merges > currentStatistics.merges || it->fastMerges > currentStatistics.fastMerges) {
+      newStatistics.push_back(currentStatistics);
+    } else if (it->merges < currentStatistics.merges) {
+      newStatistics.push_back(MergeStatistics{ currentStatistics.className,
+                                               currentStatistics.merges - it->merges,
+                                               currentStatistics.fastMerges - it->fastMerges,
+                                               std::max(0.0, currentStatistics.durationMs - it->durationMs) });
+    }
+  }
+  return newStatistics;
+}
+
+const std::vector<MergeStatistics>& MonitorObjectCollection::getMergeStatistics() const
+{
+  return mMergeStatistics;
+}
+
+void MonitorObjectCollection::recordMerge(const std::string& className, bool fastMerge, double durationMs)
+{
+  auto& statistics = findMergeStatistics(mMergeStatistics, className);
+  statistics.merges++;
+  statistics.fastMerges += fastMerge ? 1 : 0;
+  statistics.durationMs += durationMs;
 }
 
 void MonitorObjectCollection::postDeserialization()
@@ -146,6 +365,7 @@ void MonitorObjectCollection::postDeserialization()
   }
   this->SetOwner(true);
   delete it;
+  buildIndex();
 }
 
 void MonitorObjectCollection::setDetector(const std::string& detector)
@@ -168,6 +388,16 @@ const std::string& MonitorObjectCollection::getTaskName() const
   return mTaskName;
 }
 
+void MonitorObjectCollection::setUnchangedObjects(std::vector<std::string> names)
+{
+  mUnchangedObjects = std::move(names);
+}
+
+const std::vector<std::string>& MonitorObjectCollection::getUnchangedObjects() const
+{
+  return mUnchangedObjects;
+}
+
 void MonitorObjectCollection::addOrUpdateMetadata(const std::string& key, const std::string& value)
 {
   for (auto obj : *this) {
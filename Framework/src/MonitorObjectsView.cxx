@@ -0,0 +1,42 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   MonitorObjectsView.cxx
+///
+
+#include "QualityControl/MonitorObjectsView.h"
+#include "QualityControl/MonitorObject.h"
+
+#include <algorithm>
+
+namespace o2::quality_control::core
+{
+
+MonitorObject* MonitorObjectsView::get(std::string_view name) const
+{
+  auto entry = std::ranges::lower_bound(mEntries, name, {}, [](const Entry* e) { return std::string_view{ e->first }; });
+  if (entry != mEntries.end() && (*entry)->first == name) {
+    return (*entry)->second.get();
+  }
+  return nullptr;
+}
+
+std::map<std::string, std::shared_ptr<MonitorObject>> MonitorObjectsView::toMap() const
+{
+  std::map<std::string, std::shared_ptr<MonitorObject>> result;
+  for (const auto& [name, mo] : *this) {
+    result.emplace_hint(result.end(), name, mo);
+  }
+  return result;
+}
+
+} // namespace o2::quality_control::core
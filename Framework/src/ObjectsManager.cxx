@@ -18,12 +18,25 @@
 
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/CounterArray.h"
 #include <Common/Exceptions.h>
+#include <Mergers/MergerAlgorithm.h>
+#include <TArrayC.h>
+#include <TArrayD.h>
+#include <TArrayF.h>
+#include <TArrayI.h>
+#include <TArrayL64.h>
+#include <TArrayS.h>
+#include <TDirectory.h>
 #include <TObjArray.h>
+#include <TH1.h>
+#include <THnBase.h>
 
 #include <utility>
 #include <algorithm>
+#include <functional>
 #include <ranges>
+#include <string_view>
 
 using namespace o2::quality_control::core;
 using namespace AliceO2::Common;
@@ -32,6 +45,72 @@ using namespace std;
 namespace o2::quality_control::core
 {
 
+namespace
+{
+template <typename T>
+size_t hashValues(const T* values, size_t size, size_t seed = 0)
+{
+  const auto hash = std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(values), size * sizeof(T)));
+  return seed ^ (hash + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+// histograms inherit their storage from one of the TArray classes
+template <typename Array>
+std::optional<size_t> hashBinArray(const TH1* histogram)
+{
+  auto array = dynamic_cast<const Array*>(histogram);
+  if (array == nullptr) {
+    return std::nullopt;
+  }
+  return hashValues(array->GetArray(), array->GetSize());
+}
+
+std::optional<size_t> hashBins(const TH1* histogram)
+{
+  for (auto hash : { hashBinArray<TArrayF>(histogram), hashBinArray<TArrayD>(histogram), hashBinArray<TArrayI>(histogram),
+                     hashBinArray<TArrayS>(histogram), hashBinArray<TArrayC>(histogram), hashBinArray<TArrayL64>(histogram) }) {
+    if (hash.has_value()) {
+      return hash;
+    }
+  }
+  return std::nullopt;
+}
+
+// the types which can be filled by several workers and merged back, checked before any copy is made
+bool isShardable(const TObject* object)
+{
+  return dynamic_cast<const TH1*>(object) != nullptr || dynamic_cast<const THnBase*>(object) != nullptr ||
+         dynamic_cast<const CounterArrayI*>(object) != nullptr || dynamic_cast<const CounterArrayL*>(object) != nullptr ||
+         dynamic_cast<const CounterArrayF*>(object) != nullptr;
+}
+
+// returns false for the types which are not supported as shards
+bool resetShard(TObject* shard)
+{
+  if (auto histogram = dynamic_cast<TH1*>(shard)) {
+    histogram->Reset();
+    return true;
+  }
+  if (auto histogram = dynamic_cast<THnBase*>(shard)) {
+    histogram->Reset();
+    return true;
+  }
+  if (auto counters = dynamic_cast<CounterArrayI*>(shard)) {
+    counters->reset();
+    return true;
+  }
+  if (auto counters = dynamic_cast<CounterArrayL*>(shard)) {
+    counters->reset();
+    return true;
+  }
+  if (auto counters = dynamic_cast<CounterArrayF*>(shard)) {
+    counters->reset();
+    return true;
+  }
+  return false;
+}
+} // namespace
+
 const std::string ObjectsManager::gDrawOptionsKey = "drawOptions";
 const std::string ObjectsManager::gDisplayHintsKey = "displayHints";
 
@@ -72,6 +151,9 @@ void ObjectsManager::startPublishingImpl(TObject* object, PublicationPolicy publ
   newObject->setCreateMovingWindow(std::find(mMovingWindowsList.begin(), mMovingWindowsList.end(), object->GetName()) != mMovingWindowsList.end());
   mMonitorObjects->Add(newObject);
   mPublicationPoliciesForMOs[newObject] = publicationPolicy;
+  if (mNumberOfShards > 1) {
+    createShards(object);
+  }
 }
 
 void ObjectsManager::stopPublishing(TObject* object)
@@ -90,8 +172,10 @@ void ObjectsManager::stopPublishing(TObject* object)
       continue;
     }
   }
+  mShards.erase(object);
   if (moToRemove) {
     mPublicationPoliciesForMOs.erase(moToRemove);
+    mLastPublishedMarkers.erase(moToRemove);
     mMonitorObjects->Remove(moToRemove);
     mMonitorObjects->Compress();
   }
@@ -100,7 +184,9 @@ void ObjectsManager::stopPublishing(TObject* object)
 void ObjectsManager::stopPublishing(const string& objectName)
 {
   auto* mo = dynamic_cast<MonitorObject*>(getMonitorObject(objectName));
+  mShards.erase(mo->getObject());
   mPublicationPoliciesForMOs.erase(mo);
+  mLastPublishedMarkers.erase(mo);
   mMonitorObjects->Remove(mo);
   mMonitorObjects->Compress();
 }
@@ -123,6 +209,8 @@ void ObjectsManager::stopPublishingAll()
 {
   mMonitorObjects->Clear();
   mPublicationPoliciesForMOs.clear();
+  mLastPublishedMarkers.clear();
+  mShards.clear();
 }
 
 bool ObjectsManager::isBeingPublished(const string& name)
@@ -156,6 +244,76 @@ MonitorObjectCollection* ObjectsManager::getNonOwningArray() const
   return new MonitorObjectCollection(*mMonitorObjects);
 }
 
+std::optional<ObjectsManager::ChangeMarker> ObjectsManager::computeChangeMarker(const TObject* obj)
+{
+  if (obj == nullptr) {
+    return std::nullopt;
+  }
+  if (auto histogram = dynamic_cast<const TH1*>(obj)) {
+    // The bin contents are hashed, so that a histogram reset and refilled by the task with the same number of entries
+    // is not taken as unchanged. Histograms without a bin array (e.g. TH2Poly) are always considered as changed.
+    auto contentHash = hashBins(histogram);
+    if (!contentHash.has_value()) {
+      return std::nullopt;
+    }
+    if (histogram->GetSumw2N() > 0) {
+      contentHash = hashValues(histogram->GetSumw2()->GetArray(), histogram->GetSumw2N(), contentHash.value());
+    }
+    return ChangeMarker{ histogram->GetEntries(), histogram->GetSumOfWeights(), contentHash.value() };
+  }
+  auto counterArrayMarker = [](const auto* counters) {
+    return ChangeMarker{ static_cast<double>(counters->getEntries()), counters->getSum(), hashValues(counters->getCounters().data(), counters->getCounters().size()) };
+  };
+  if (auto counters = dynamic_cast<const CounterArrayI*>(obj)) {
+    return counterArrayMarker(counters);
+  }
+  if (auto counters = dynamic_cast<const CounterArrayL*>(obj)) {
+    return counterArrayMarker(counters);
+  }
+  if (auto counters = dynamic_cast<const CounterArrayF*>(obj)) {
+    return counterArrayMarker(counters);
+  }
+  return std::nullopt;
+}
+
+MonitorObjectCollection* ObjectsManager::getNonOwningArrayOfChangedObjects()
+{
+  auto* collection = new MonitorObjectCollection();
+  collection->SetOwner(false);
+  collection->SetName(mMonitorObjects->GetName());
+  collection->setDetector(mMonitorObjects->getDetector());
+  collection->setTaskName(mMonitorObjects->getTaskName());
+
+  std::vector<std::string> unchangedObjects;
+  for (auto tobj : *mMonitorObjects) {
+    auto* mo = dynamic_cast<MonitorObject*>(tobj);
+    if (mo == nullptr) {
+      continue;
+    }
+    auto marker = computeChangeMarker(mo->getObject());
+    if (marker.has_value()) {
+      auto lastMarker = mLastPublishedMarkers.find(mo);
+      if (lastMarker != mLastPublishedMarkers.end() && lastMarker->second == marker.value()) {
+        unchangedObjects.emplace_back(mo->GetName());
+        continue;
+      }
+      mLastPublishedMarkers[mo] = marker.value();
+    }
+    collection->Add(mo);
+  }
+  collection->setUnchangedObjects(std::move(unchangedObjects));
+  return collection;
+}
+
+void ObjectsManager::notifyObjectsReset()
+{
+  // Objects are compared to their state just after the reset, thus those which stay empty are still skipped,
+  // since sending them would not change a delta merging.
+  for (auto& [mo, marker] : mLastPublishedMarkers) {
+    marker = computeChangeMarker(mo->getObject()).value_or(ChangeMarker{});
+  }
+}
+
 void ObjectsManager::addMetadata(const std::string& objectName, const std::string& key, const std::string& value)
 {
   MonitorObject* mo = getMonitorObject(objectName);
@@ -239,6 +397,7 @@ const Activity& ObjectsManager::getActivity() const
 void ObjectsManager::setActivity(const Activity& activity)
 {
   mActivity = activity;
+  mLastPublishedMarkers.clear();
   // update the activity of all the objects
   for (auto tobj : *mMonitorObjects) {
     auto* mo = dynamic_cast<MonitorObject*>(tobj);
@@ -256,4 +415,61 @@ const std::vector<std::string>& ObjectsManager::getMovingWindowsList() const
   return mMovingWindowsList;
 }
 
+void ObjectsManager::setNumberOfShards(size_t numberOfShards)
+{
+  mNumberOfShards = std::max<size_t>(numberOfShards, 1);
+  mShards.clear();
+  if (mNumberOfShards > 1) {
+    for (auto tobj : *mMonitorObjects) {
+      createShards(dynamic_cast<MonitorObject*>(tobj)->getObject());
+    }
+  }
+}
+
+size_t ObjectsManager::getNumberOfShards() const
+{
+  return mNumberOfShards;
+}
+
+void ObjectsManager::createShards(TObject* object)
+{
+  // canvases, trees and other unsupported objects may be large, thus we check the type before cloning anything
+  if (!isShardable(object)) {
+    ILOG(Debug, Devel) << "Object '" << object->GetName() << "' of type '" << object->ClassName() << "' cannot be filled by several workers, no shards are created for it" << ENDM;
+    return;
+  }
+  // we do not want the copies to be owned by the current directory
+  TDirectory::TContext context(nullptr);
+  std::vector<std::unique_ptr<TObject>> shards;
+  for (size_t worker = 1; worker < mNumberOfShards; worker++) {
+    std::unique_ptr<TObject> shard(object->Clone());
+    resetShard(shard.get());
+    shards.emplace_back(std::move(shard));
+  }
+  mShards[object] = std::move(shards);
+}
+
+TObject* ObjectsManager::getShardImpl(TObject* object, size_t worker)
+{
+  if (worker == 0) {
+    return object;
+  }
+  auto it = mShards.find(object);
+  if (it == mShards.end() || worker > it->second.size()) {
+    string name = (object ? object->GetName() : "nullptr") + string(" (shard ") + to_string(worker) + ")";
+    BOOST_THROW_EXCEPTION(ObjectNotFoundError() << errinfo_object_name(name));
+  }
+  return it->second[worker - 1].get();
+}
+
+void ObjectsManager::mergeShards()
+{
+  for (auto& [object, shards] : mShards) {
+    for (auto& shard : shards) {
+      mergers::algorithm::merge(object, shard.get());
+      resetShard(shard.get());
+    }
+  }
+}
+
 } // namespace o2::quality_control::core
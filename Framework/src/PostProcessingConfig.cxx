@@ -71,6 +71,10 @@ PostProcessingConfig::PostProcessingConfig(const std::string& id, const boost::p
     }
   }
   validityFromLastTriggerOnly = ppTree.get<bool>("validityFromLastTriggerOnly", false);
+  backfillWorkers = ppTree.get<size_t>("backfillWorkers", 1);
+  eventDrivenTriggers = ppTree.get<bool>("eventDrivenTriggers", false);
+  triggerBackoffInitialSeconds = ppTree.get<double>("triggerBackoffInitialSeconds", 1.0);
+  triggerBackoffMaxSeconds = ppTree.get<double>("triggerBackoffMaxSeconds", 10.0);
 }
 
 } // namespace o2::quality_control::postprocessing
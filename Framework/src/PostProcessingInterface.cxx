@@ -14,10 +14,20 @@
 /// \author Piotr Konopka
 ///
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <utility>
 
 #include "QualityControl/PostProcessingInterface.h"
 #include "QualityControl/ObjectsManager.h"
+#include "QualityControl/QcInfoLogger.h"
+#include "QualityControl/WorkerPool.h"
+
+#include <Monitoring/Monitoring.h>
+#include <TROOT.h>
+
+using namespace o2::monitoring;
 
 namespace o2::quality_control::postprocessing
 {
@@ -42,9 +52,62 @@ void PostProcessingInterface::setObjectsManager(std::shared_ptr<core::ObjectsMan
   mObjectsManager = std::move(objectsManager);
 }
 
+void PostProcessingInterface::setMonitoring(const std::shared_ptr<o2::monitoring::Monitoring>& monitoring)
+{
+  mMonitoring = monitoring;
+}
+
 std::shared_ptr<core::ObjectsManager> PostProcessingInterface::getObjectsManager()
 {
   return mObjectsManager;
 }
 
+void PostProcessingInterface::backfill(const std::vector<Trigger>& triggers, framework::ServiceRegistryRef services, size_t)
+{
+  for (const auto& trigger : triggers) {
+    update(trigger, services);
+  }
+}
+
+void PostProcessingInterface::processInParallel(const std::vector<Trigger>& triggers, size_t workers, const std::function<bool(size_t trigger, size_t worker)>& process)
+{
+  if (workers > 1) {
+    ROOT::EnableThreadSafety();
+  }
+  core::WorkerPool pool(workers);
+  // roughly every 10%, but only by the calling thread, so that the messages are not mixed
+  const size_t progressStep = std::max<size_t>(triggers.size() / 10, 1);
+  std::atomic<size_t> processed = 0;
+  std::atomic<size_t> failed = 0;
+  size_t lastReported = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  pool.run(triggers.size(), [&](size_t trigger, size_t worker) {
+    if (!process(trigger, worker)) {
+      failed++;
+    }
+    const size_t done = ++processed;
+    if (worker == 0 && done - lastReported >= progressStep && done < triggers.size()) {
+      lastReported = done;
+      ILOG(Info, Support) << "Backfilling the task '" << getName() << "': " << done << "/" << triggers.size() << " triggers processed" << ENDM;
+    }
+  });
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  const double rate = seconds > 0 ? triggers.size() / seconds : 0;
+
+  ILOG(Info, Support) << "Backfilled the task '" << getName() << "' with " << triggers.size() << " triggers in " << seconds
+                      << " s (" << rate << " triggers/s) using " << pool.getNumberOfWorkers() << " workers" << ENDM;
+  if (failed > 0) {
+    ILOG(Warning, Support) << failed << " triggers could not be fully processed during the backfill" << ENDM;
+  }
+  if (mMonitoring) {
+    Metric metric{ "qc_postprocessing_backfill" };
+    metric.addValue(static_cast<uint64_t>(triggers.size()), "triggers");
+    metric.addValue(static_cast<uint64_t>(failed), "failed");
+    metric.addValue(seconds, "duration_s");
+    metric.addValue(rate, "rate");
+    mMonitoring->send(std::move(metric));
+  }
+}
+
 } // namespace o2::quality_control::postprocessing
@@ -17,6 +17,7 @@
 #include "QualityControl/PostProcessingTaskSpec.h"
 #include "QualityControl/TriggerHelpers.h"
 #include "QualityControl/DatabaseFactory.h"
+#include "QualityControl/CachingDatabase.h"
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/CommonSpec.h"
 #include "QualityControl/InfrastructureSpecReader.h"
@@ -24,23 +25,46 @@
 #include "QualityControl/RootClassFactory.h"
 #include "QualityControl/runnerUtils.h"
 #include "QualityControl/ConfigParamGlo.h"
+#include "QualityControl/MonitorObject.h"
 #include "QualityControl/MonitorObjectCollection.h"
 #include "QualityControl/Bookkeeping.h"
 #include "QualityControl/ActivityHelpers.h"
+#include "QualityControl/stringUtils.h"
 
+#include <optional>
 #include <utility>
 #include <Framework/DataAllocator.h>
 #include <CommonUtils/ConfigurableParam.h>
+#include <Monitoring/MonitoringFactory.h>
+#include <Monitoring/Monitoring.h>
 #include <TSystem.h>
 
 using namespace o2::quality_control::core;
 using namespace o2::quality_control::repository;
+using namespace o2::monitoring;
 
 namespace o2::quality_control::postprocessing
 {
 
 constexpr long objectValidity = 1000l * 60 * 60 * 24 * 365 * 10;
 
+namespace
+{
+// the triggers which iterate over existing objects, thus the following ones are known in advance
+bool iteratesOverObjects(const Trigger& trigger)
+{
+  return trigger == TriggerType::ForEachObject || trigger == TriggerType::ForEachLatest;
+}
+
+// the following object is evaluated as soon as the previous trigger is taken, so it is expected quickly
+constexpr auto iteratedObjectTimeout = std::chrono::seconds(1);
+
+std::chrono::milliseconds toMilliseconds(double seconds)
+{
+  return std::chrono::milliseconds(static_cast<long>(seconds * 1000));
+}
+} // namespace
+
 PostProcessingRunner::PostProcessingRunner(std::string id) //
   : mID(std::move(id))
 {
@@ -69,6 +93,14 @@ void PostProcessingRunner::init(const boost::property_tree::ptree& config, core:
 std::unique_ptr<DatabaseInterface> PostProcessingRunner::configureDatabase(std::unordered_map<std::string, std::string>& dbConfig, const std::string& name)
 {
   auto database = DatabaseFactory::create(dbConfig.at("implementation"));
+  if (dbConfig.count("cache") && decodeBool(dbConfig.at("cache"))) {
+    auto timeToLive = dbConfig.count("cacheTimeToLiveSeconds") ? std::stod(dbConfig.at("cacheTimeToLiveSeconds")) : 60.0;
+    size_t maxSizeMB = dbConfig.count("cacheMaxSizeMB") ? std::stoul(dbConfig.at("cacheMaxSizeMB")) : 512;
+    // the cache is shared by all the tasks in the process, the last configuration applies to all of them
+    RetrievalCache::getInstance().setLimits(std::chrono::milliseconds(static_cast<long>(timeToLive * 1000)), maxSizeMB * 1024 * 1024);
+    database = std::make_unique<CachingDatabase>(std::move(database));
+    ILOG(Info, Devel) << name << " database retrievals are cached for " << timeToLive << " s, up to " << maxSizeMB << " MB" << ENDM;
+  }
   database->connect(dbConfig);
   ILOG(Info, Devel) << name << " database that is going to be used > Implementation : " << dbConfig.at("implementation") << " / "
                     << " Host : " << dbConfig.at("host") << ENDM;
@@ -93,6 +125,11 @@ void PostProcessingRunner::init(const PostProcessingRunnerConfig& runnerConfig,
   // configuration of the database
   mSourceDatabase = configureDatabase(mRunnerConfig.sourceDatabase, "Source");
   mDestinationDatabase = configureDatabase(mRunnerConfig.destinationDatabase, "Destination");
+  if (!mRunnerConfig.monitoringUrl.empty()) {
+    mCollector = MonitoringFactory::Get(mRunnerConfig.monitoringUrl);
+    mCollector->addGlobalTag(tags::Key::Subsystem, tags::Value::QC);
+    mCollector->addGlobalTag("TaskName", mTaskConfig.taskName);
+  }
 
   mObjectManager = std::make_shared<ObjectsManager>(mTaskConfig.taskName, mTaskConfig.className, mTaskConfig.detectorName);
   mObjectManager->setActivity(mActivity);
@@ -109,8 +146,15 @@ void PostProcessingRunner::init(const PostProcessingRunnerConfig& runnerConfig,
   if (mTask) {
     ILOG(Debug, Devel) << "The user task '" << mTaskConfig.taskName << "' has been successfully created" << ENDM;
 
+    if (mTaskConfig.eventDrivenTriggers) {
+      mTriggerQueue = std::make_unique<TriggerQueue>(TriggerQueue::Backoff{ toMilliseconds(mTaskConfig.triggerBackoffInitialSeconds), toMilliseconds(mTaskConfig.triggerBackoffMaxSeconds) });
+      ILOG(Info, Devel) << "The triggers are evaluated in the background, with backoff from " << mTaskConfig.triggerBackoffInitialSeconds
+                        << " s to " << mTaskConfig.triggerBackoffMaxSeconds << " s" << ENDM;
+    }
+
     mTaskState = TaskState::Created;
     mTask->setObjectsManager(mObjectManager);
+    mTask->setMonitoring(mCollector);
     mTask->setID(mTaskConfig.id);
     mTask->setName(mTaskConfig.taskName);
     mTask->setCustomParameters(mTaskConfig.customParameters);
@@ -126,20 +170,24 @@ bool PostProcessingRunner::run()
   ILOG(Debug, Devel) << "Checking triggers of the task '" << mTask->getName() << "' (det " << mTaskConfig.detectorName << ")" << ENDM;
 
   if (mTaskState == TaskState::Created) {
-    if (Trigger trigger = trigger_helpers::tryTrigger(mInitTriggers)) {
+    if (Trigger trigger = tryTrigger(TriggerQueue::Group::Init)) {
       doInitialize(trigger);
       return true;
     }
   }
   if (mTaskState == TaskState::Running) {
-    if (Trigger trigger = trigger_helpers::tryTrigger(mUpdateTriggers)) {
-      doUpdate(trigger);
+    if (Trigger trigger = tryTrigger(TriggerQueue::Group::Update)) {
+      if (mTaskConfig.backfillWorkers > 1 && mTask->supportsBackfill() && iteratesOverObjects(trigger)) {
+        backfillIteratedObjects(std::move(trigger));
+      } else {
+        doUpdate(trigger);
+      }
       return true;
     }
-    if (mUpdateTriggers.empty()) {
+    if (isExhausted(TriggerQueue::Group::Update)) {
       doFinalize({ TriggerType::UserOrControl, true, mActivity });
       return false;
-    } else if (Trigger trigger = trigger_helpers::tryTrigger(mStopTriggers)) {
+    } else if (Trigger trigger = tryTrigger(TriggerQueue::Group::Stop)) {
       doFinalize(trigger);
       return false;
     }
@@ -167,8 +215,16 @@ void PostProcessingRunner::runOverTimestamps(const std::vector<uint64_t>& timest
   ILOG(Info, Support) << "Running the task '" << mTask->getName() << "' (det " << mRunnerConfig.detectorName << ") over " << timestamps.size() << " timestamps." << ENDM;
 
   doInitialize({ TriggerType::UserOrControl, false, mTaskConfig.activity, timestamps.front() });
+  std::vector<Trigger> updateTriggers;
   for (size_t i = 1; i < timestamps.size() - 1; i++) {
-    doUpdate({ TriggerType::UserOrControl, i == timestamps.size() - 2, mTaskConfig.activity, timestamps[i] });
+    updateTriggers.emplace_back(TriggerType::UserOrControl, i == timestamps.size() - 2, mTaskConfig.activity, timestamps[i]);
+  }
+  if (mTaskConfig.backfillWorkers > 1 && mTask->supportsBackfill() && !updateTriggers.empty()) {
+    doBackfill(updateTriggers);
+  } else {
+    for (const auto& trigger : updateTriggers) {
+      doUpdate(trigger);
+    }
   }
   doFinalize({ TriggerType::UserOrControl, false, mTaskConfig.activity, timestamps.back() });
 }
@@ -196,7 +252,7 @@ void PostProcessingRunner::start(framework::ServiceRegistryRef dplServices)
     auto taskConfigWithCorrectActivity = mTaskConfig;
     taskConfigWithCorrectActivity.activity = activityFromDriver;
     taskConfigWithCorrectActivity.activity.mValidity = gFullValidityInterval;
-    mInitTriggers = trigger_helpers::createTriggers(mTaskConfig.initTriggers, taskConfigWithCorrectActivity);
+    setTriggers(TriggerQueue::Group::Init, trigger_helpers::createTriggers(mTaskConfig.initTriggers, taskConfigWithCorrectActivity));
     if (trigger_helpers::hasUserOrControlTrigger(mTaskConfig.initTriggers)) {
       doInitialize({ TriggerType::UserOrControl, false, activityFromDriver, activityFromDriver.mValidity.getMin() });
     }
@@ -237,12 +293,60 @@ void PostProcessingRunner::reset()
   mTask.reset();
   mSourceDatabase.reset();
   mDestinationDatabase.reset();
+  mCollector.reset();
   mServices = framework::ServiceRegistry();
   mObjectManager.reset();
 
   mInitTriggers.clear();
   mUpdateTriggers.clear();
   mStopTriggers.clear();
+  mTriggerQueue.reset();
+}
+
+void PostProcessingRunner::waitForTrigger(std::chrono::milliseconds timeout)
+{
+  if (mTriggerQueue == nullptr) {
+    throw std::runtime_error("Waiting for triggers requires evaluating them in the background");
+  }
+  mTriggerQueue->waitForAny(timeout);
+}
+
+std::vector<TriggerFcn>& PostProcessingRunner::getTriggers(TriggerQueue::Group group)
+{
+  switch (group) {
+    case TriggerQueue::Group::Init:
+      return mInitTriggers;
+    case TriggerQueue::Group::Update:
+      return mUpdateTriggers;
+    case TriggerQueue::Group::Stop:
+      return mStopTriggers;
+  }
+  throw std::runtime_error("Unknown trigger group");
+}
+
+void PostProcessingRunner::setTriggers(TriggerQueue::Group group, std::vector<TriggerFcn> triggerFcns)
+{
+  if (mTriggerQueue) {
+    mTriggerQueue->setTriggers(group, std::move(triggerFcns));
+  } else {
+    getTriggers(group) = std::move(triggerFcns);
+  }
+}
+
+Trigger PostProcessingRunner::tryTrigger(TriggerQueue::Group group, std::chrono::milliseconds timeout)
+{
+  if (mTriggerQueue) {
+    return mTriggerQueue->take(group, timeout);
+  }
+  return trigger_helpers::tryTrigger(getTriggers(group));
+}
+
+bool PostProcessingRunner::isExhausted(TriggerQueue::Group group)
+{
+  if (mTriggerQueue) {
+    return mTriggerQueue->isExhausted(group);
+  }
+  return getTriggers(group).empty();
 }
 
 void PostProcessingRunner::updateValidity(const Trigger& trigger)
@@ -289,8 +393,9 @@ void PostProcessingRunner::doInitialize(const Trigger& trigger)
   auto taskConfigWithCorrectActivity = mTaskConfig;
   taskConfigWithCorrectActivity.activity = mActivity;
   taskConfigWithCorrectActivity.activity.mValidity = gFullValidityInterval;
-  mUpdateTriggers = trigger_helpers::createTriggers(mTaskConfig.updateTriggers, taskConfigWithCorrectActivity);
-  mStopTriggers = trigger_helpers::createTriggers(mTaskConfig.stopTriggers, taskConfigWithCorrectActivity);
+  setTriggers(TriggerQueue::Group::Init, {});
+  setTriggers(TriggerQueue::Group::Update, trigger_helpers::createTriggers(mTaskConfig.updateTriggers, taskConfigWithCorrectActivity));
+  setTriggers(TriggerQueue::Group::Stop, trigger_helpers::createTriggers(mTaskConfig.stopTriggers, taskConfigWithCorrectActivity));
 }
 
 void PostProcessingRunner::doUpdate(const Trigger& trigger)
@@ -298,15 +403,84 @@ void PostProcessingRunner::doUpdate(const Trigger& trigger)
   ILOG(Info, Support) << "Updating the user task due to trigger '" << trigger << "'" << ENDM;
   mTask->update(trigger, mServices);
   updateValidity(trigger);
+  sendMonitoring();
+  publishUpdate();
+}
+
+void PostProcessingRunner::doBackfill(const std::vector<Trigger>& triggers)
+{
+  ILOG(Info, Support) << "Backfilling the user task with " << triggers.size() << " triggers, from '" << triggers.front()
+                      << "' to '" << triggers.back() << "'" << ENDM;
+  mTask->backfill(triggers, mServices, mTaskConfig.backfillWorkers);
+  for (const auto& trigger : triggers) {
+    updateValidity(trigger);
+  }
+  sendMonitoring();
+  publishUpdate();
+}
 
+void PostProcessingRunner::backfillIteratedObjects(Trigger first)
+{
+  // ForEachObject and ForEachLatest know the list of objects in advance, thus we can take all the remaining ones now
+  std::vector<Trigger> triggers{ std::move(first) };
+  std::optional<Trigger> otherTrigger;
+  while (!triggers.back().last) {
+    Trigger trigger = tryTrigger(TriggerQueue::Group::Update, iteratedObjectTimeout);
+    if (!trigger) {
+      break;
+    }
+    if (!iteratesOverObjects(trigger)) {
+      otherTrigger = std::move(trigger);
+      break;
+    }
+    triggers.push_back(std::move(trigger));
+  }
+  doBackfill(triggers);
+  if (otherTrigger.has_value()) {
+    doUpdate(*otherTrigger);
+  }
+}
+
+void PostProcessingRunner::publishUpdate()
+{
   if (mActivity.mValidity.isValid()) {
-    mPublicationCallback(mObjectManager->getNonOwningArray());
+    std::unique_ptr<MonitorObjectCollection> collection(mObjectManager->getNonOwningArray());
+    mPublicationCallback(collection.get());
     mObjectManager->stopPublishing(PublicationPolicy::Once);
   } else {
     ILOG(Warning, Support) << "Objects will not be published because their validity is invalid. This should not happen." << ENDM;
   }
 }
 
+void PostProcessingRunner::sendMonitoring()
+{
+  if (mCollector == nullptr) {
+    return;
+  }
+  if (std::dynamic_pointer_cast<CachingDatabase>(mSourceDatabase)) {
+    auto stats = RetrievalCache::getInstance().getStats();
+    mCollector->send(Metric{ "qc_postprocessing_retrieval_cache" }
+                       .addValue(stats.hits, "hits")
+                       .addValue(stats.misses, "misses")
+                       .addValue(stats.deduplicated, "deduplicated")
+                       .addValue(stats.evicted, "evicted")
+                       .addValue(stats.expired, "expired")
+                       .addValue(stats.entries, "entries")
+                       .addValue(stats.sizeBytes, "size_bytes"));
+  }
+  if (mTriggerQueue) {
+    auto stats = mTriggerQueue->getStats();
+    mCollector->send(Metric{ "qc_postprocessing_triggers" }
+                       .addValue(stats.evaluations, "evaluations")
+                       .addValue(stats.fired, "fired")
+                       .addValue(stats.taken, "taken")
+                       .addValue(stats.evaluations > 0 ? stats.evaluationSeconds / stats.evaluations : 0.0, "evaluation_s_mean")
+                       .addValue(stats.maxEvaluationSeconds, "evaluation_s_max")
+                       .addValue(stats.taken > 0 ? stats.waitingSeconds / stats.taken : 0.0, "waiting_s_mean")
+                       .addValue(stats.maxWaitingSeconds, "waiting_s_max"));
+  }
+}
+
 void PostProcessingRunner::doFinalize(const Trigger& trigger)
 {
   if (mTaskState != TaskState::Running) {
@@ -316,14 +490,20 @@ void PostProcessingRunner::doFinalize(const Trigger& trigger)
   ILOG(Info, Support) << "Finalizing the user task due to trigger '" << trigger << "'" << ENDM;
   mTask->finalize(trigger, mServices);
   updateValidity(trigger);
+  sendMonitoring();
 
   if (mActivity.mValidity.isValid()) {
-    mPublicationCallback(mObjectManager->getNonOwningArray());
+    std::unique_ptr<MonitorObjectCollection> collection(mObjectManager->getNonOwningArray());
+    mPublicationCallback(collection.get());
   } else {
     // TODO: we could consider using SOR, EOR as validity in such case, so empty objects are still stored in the QCDB.
     ILOG(Warning, Devel) << "Objects will not be published because their validity is invalid. Most likely the task's update() method was never triggered." << ENDM;
   }
   mTaskState = TaskState::Finished;
+  if (mTriggerQueue) {
+    // the triggers are not checked anymore, there is no reason to keep evaluating them
+    mTriggerQueue->clear();
+  }
   mObjectManager->stopPublishing(PublicationPolicy::Once);
   mObjectManager->stopPublishing(PublicationPolicy::ThroughStop);
 }
@@ -348,7 +528,8 @@ PostProcessingRunnerConfig PostProcessingRunner::extractConfig(const CommonSpec&
     commonSpec.infologgerDiscardParameters,
     commonSpec.postprocessingPeriod,
     "",
-    ppTaskSpec.tree
+    ppTaskSpec.tree,
+    commonSpec.monitoringUrl
   };
 }
 
@@ -363,12 +544,23 @@ MOCPublicationCallback publishToDPL(framework::DataAllocator& allocator, std::st
 
 MOCPublicationCallback publishToRepository(o2::quality_control::repository::DatabaseInterface& repository)
 {
-  return [&](const MonitorObjectCollection* collection) {
+  return [&repository](const MonitorObjectCollection* collection) {
     ILOG(Debug, Support) << "Publishing " << collection->GetEntries() << " MonitorObjects" << ENDM;
-    for (const TObject* mo : *collection) {
-      // We have to copy the object so we can pass a shared_ptr.
-      // This is not ideal, but MySQL interface requires shared ptrs to queue the objects.
-      repository.storeMO(std::shared_ptr<MonitorObject>(dynamic_cast<MonitorObject*>(mo->Clone())));
+    const bool copyObjects = !repository.storesSynchronously();
+    for (const TObject* obj : *collection) {
+      auto mo = dynamic_cast<const MonitorObject*>(obj);
+      if (mo == nullptr) {
+        ILOG(Warning, Devel) << "The object '" << obj->GetName() << "' is not a MonitorObject, it will not be stored" << ENDM;
+        continue;
+      }
+      if (copyObjects) {
+        // the object will be uploaded later, when the task might be already modifying it
+        repository.storeMO(std::shared_ptr<const MonitorObject>(dynamic_cast<MonitorObject*>(mo->Clone())));
+      } else {
+        // The object is stored before storeMO returns and it is owned by the ObjectsManager until then,
+        // thus we can avoid copying large canvases or trees and pass a non-owning pointer.
+        repository.storeMO(std::shared_ptr<const MonitorObject>(mo, [](const MonitorObject*) {}));
+      }
     }
   };
 }
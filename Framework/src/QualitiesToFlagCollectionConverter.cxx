@@ -19,8 +19,8 @@
 #include <DataFormatsQualityControl/QualityControlFlagCollection.h>
 #include <DataFormatsQualityControl/FlagTypeFactory.h>
 
+#include <algorithm>
 #include <utility>
-#include <ranges>
 #include "fmt/core.h"
 #include "QualityControl/QualityObject.h"
 // #include "QualityControl/ObjectMetadataKeys.h"
@@ -38,7 +38,8 @@ const char* toBeRemovedComment = "This flag should be removed before returning t
 QualitiesToFlagCollectionConverter::QualitiesToFlagCollectionConverter(
   std::unique_ptr<QualityControlFlagCollection> qcfc, std::string qoPath)
   : mQOPath(std::move(qoPath)),
-    mConverted(std::move(qcfc))
+    mConverted(std::move(qcfc)),
+    mNoQOKind(mFlagBuffer.getKind(FlagTypeFactory::UnknownQuality(), noQOComment))
 {
   if (mConverted == nullptr) {
     throw std::runtime_error("nullptr QualityControlFlagCollection provided to QualitiesToFlagCollectionConverter");
@@ -57,8 +58,7 @@ QualitiesToFlagCollectionConverter::QualitiesToFlagCollectionConverter(
 
   /// Timespans not covered by a given QO are filled with Flag 1 (Unknown Quality)
   // This flag will be removed or trimmed by any other Flags received as input.
-  mFlagBuffer.insert({ mConverted->getInterval().getMin(), mConverted->getInterval().getMax(),
-                       FlagTypeFactory::UnknownQuality(), noQOComment, mQOPath });
+  mFlagBuffer.insert(mNoQOKind, mConverted->getInterval());
 }
 
 std::vector<QualityControlFlag> QO2Flags(const QualityObject& qo)
@@ -130,7 +130,17 @@ void QualitiesToFlagCollectionConverter::operator()(const QualityObject& newQO)
     return;
   }
 
+  if (!mReportedLateQO && newQO.getValidity().getMin() < mFinalizedWatermark) {
+    ILOG(Warning, Support) << fmt::format(
+                                "The QO '{}' starts at {}, before the flags finalized until {}. The flags which were already sent are not corrected, "
+                                "the QOs should come in chronological order. Will not report more such QOs for this path.",
+                                newQO.GetName(), newQO.getValidity().getMin(), mFinalizedWatermark)
+                           << ENDM;
+    mReportedLateQO = true;
+  }
+
   mQOsIncluded++;
+  mNewestQOStart = std::max(mNewestQOStart, newQO.getValidity().getMin());
   if (newQO.getQuality().isWorseThan(Quality::Good)) {
     mWorseThanGoodQOs++;
   }
@@ -140,37 +150,38 @@ void QualitiesToFlagCollectionConverter::operator()(const QualityObject& newQO)
   }
 }
 
-void QualitiesToFlagCollectionConverter::trimBufferWithInterval(ValidityInterval interval, const std::function<bool(const QualityControlFlag&)>& predicate)
+void QualitiesToFlagCollectionConverter::trimUnknownQualityWithInterval(ValidityInterval interval)
 {
-  auto toTrimPredicate = [&](const QualityControlFlag& flag) {
-    return flag_helpers::intervalsOverlap(flag.getInterval(), interval) && predicate(flag);
-  };
-
-  auto flagsToTrim = mFlagBuffer | std::views::filter(toTrimPredicate);
-  for (const auto& flagToTrimOrRemove : flagsToTrim) {
-    auto trimmedFlags = flag_helpers::excludeInterval(flagToTrimOrRemove, interval);
-    mFlagBuffer.insert(std::make_move_iterator(trimmedFlags.begin()), std::make_move_iterator(trimmedFlags.end()));
+  for (FlagIntervalBuffer::Kind kind = 0; kind < mFlagBuffer.getNumberOfKinds(); kind++) {
+    if (mFlagBuffer.getFlagType(kind) == FlagTypeFactory::UnknownQuality()) {
+      mFlagBuffer.exclude(kind, interval);
+    }
   }
-  // we have inserted any trimmed flags which remained, we remove the old ones.
-  std::erase_if(mFlagBuffer, toTrimPredicate);
 }
 
-std::vector<QualityControlFlag> QualitiesToFlagCollectionConverter::trimFlagAgainstBuffer(const QualityControlFlag& newFlag, const std::function<bool(const QualityControlFlag&)>& predicate)
+void QualitiesToFlagCollectionConverter::insertUnknownQualityNotCovered(FlagIntervalBuffer::Kind newKind, ValidityInterval interval)
 {
-  auto trimmerPredicate = [&](const QualityControlFlag& flag) {
-    return flag_helpers::intervalsOverlap(flag.getInterval(), newFlag.getInterval()) && predicate(flag);
-  };
-  std::vector<QualityControlFlag> trimmedNewFlags{ newFlag };
-  for (const auto& overlappingFlag : mFlagBuffer | std::views::filter(trimmerPredicate)) {
-    std::vector<QualityControlFlag> updatedTrimmedFlags;
-    for (const auto& trimmedFlag : trimmedNewFlags) {
-      auto result = flag_helpers::excludeInterval(trimmedFlag, overlappingFlag.getInterval());
-      updatedTrimmedFlags.insert(updatedTrimmedFlags.end(), std::make_move_iterator(result.begin()), std::make_move_iterator(result.end()));
+  std::vector<ValidityInterval> covered;
+  for (FlagIntervalBuffer::Kind kind = 0; kind < mFlagBuffer.getNumberOfKinds(); kind++) {
+    if (mFlagBuffer.getFlagType(kind) != FlagTypeFactory::UnknownQuality()) {
+      auto overlapping = mFlagBuffer.getOverlapping(kind, interval);
+      covered.insert(covered.end(), overlapping.begin(), overlapping.end());
     }
-    trimmedNewFlags = std::move(updatedTrimmedFlags);
   }
-
-  return trimmedNewFlags;
+  std::sort(covered.begin(), covered.end(), [](const auto& a, const auto& b) { return a.getMin() < b.getMin(); });
+
+  // the gaps between the covered intervals are the parts to insert.
+  // a flag interval split in the middle becomes two flags.
+  auto gapStart = interval.getMin();
+  for (const auto& coveredInterval : covered) {
+    if (coveredInterval.getMin() > gapStart) {
+      mFlagBuffer.insert(newKind, { gapStart, coveredInterval.getMin() });
+    }
+    gapStart = std::max(gapStart, coveredInterval.getMax());
+  }
+  if (gapStart < interval.getMax()) {
+    mFlagBuffer.insert(newKind, { gapStart, interval.getMax() });
+  }
 }
 
 void QualitiesToFlagCollectionConverter::insert(QualityControlFlag&& newFlag)
@@ -186,42 +197,33 @@ void QualitiesToFlagCollectionConverter::insert(QualityControlFlag&& newFlag)
   // Existing flags: [-----)      [---------)
   // New flag:           [--------)
   // Correct result: [----------------------)
-  auto canBeMergedWithNewFlag = [&](const QualityControlFlag& other) {
-    return newFlag.getFlag() == other.getFlag() &&
-           newFlag.getComment() == other.getComment() &&
-           flag_helpers::intervalsConnect(newFlag.getInterval(), other.getInterval());
-  };
-
-  auto flagsToMerge = mFlagBuffer | std::views::filter(canBeMergedWithNewFlag);
-  for (const auto& flag : flagsToMerge) {
-    newFlag.getInterval().update(flag.getStart());
-    newFlag.getInterval().update(flag.getEnd());
-  }
-  std::erase_if(mFlagBuffer, canBeMergedWithNewFlag);
+  // Flags of the same type and comment are never adjacent nor overlapping in the buffer, so only these are visited.
+  const auto kind = mFlagBuffer.getKind(newFlag.getFlag(), newFlag.getComment());
+  const auto interval = mFlagBuffer.takeConnecting(kind, { newFlag.getStart(), newFlag.getEnd() });
 
   if (newFlag.getFlag() != FlagTypeFactory::UnknownQuality()) {
     // We trim any UnknownQuality flags which become obsolete due to the presence of the new flag
-    trimBufferWithInterval(newFlag.getInterval(),
-                           [](const auto& f) { return f.getFlag() == FlagTypeFactory::UnknownQuality(); });
-    mFlagBuffer.insert(newFlag);
+    trimUnknownQualityWithInterval(interval);
+    mFlagBuffer.insert(kind, interval);
   } else {
     // If the new Flag is UnknownQuality, we will apply it only for intervals not covered by other types of Flags
-    auto trimmedNewFlags = trimFlagAgainstBuffer(newFlag, [](const auto& f) { return f.getFlag() != FlagTypeFactory::UnknownQuality(); });
-    mFlagBuffer.insert(std::make_move_iterator(trimmedNewFlags.begin()), std::make_move_iterator(trimmedNewFlags.end()));
+    insertUnknownQualityNotCovered(kind, interval);
 
     // And then, we trim also the default UnknownQuality flag (no QO).
-    if (newFlag.getComment() != noQOComment) {
-      trimBufferWithInterval(newFlag.getInterval(), [](const auto& f) {
-        return f.getFlag() == FlagTypeFactory::UnknownQuality() && f.getComment() == noQOComment;
-      });
+    if (kind != mNoQOKind) {
+      mFlagBuffer.exclude(mNoQOKind, interval);
     }
   }
 }
 
 std::unique_ptr<QualityControlFlagCollection> QualitiesToFlagCollectionConverter::getResult()
 {
-  std::erase_if(mFlagBuffer, [](const QualityControlFlag& flag) { return flag.getComment() == toBeRemovedComment; });
-  for (const auto& flag : mFlagBuffer) {
+  for (FlagIntervalBuffer::Kind kind = 0; kind < mFlagBuffer.getNumberOfKinds(); kind++) {
+    if (mFlagBuffer.getComment(kind) == toBeRemovedComment) {
+      mFlagBuffer.erase(kind);
+    }
+  }
+  for (const auto& flag : mFlagBuffer.getFlags(mQOPath)) {
     mConverted->insert(flag);
   }
 
@@ -234,13 +236,34 @@ std::unique_ptr<QualityControlFlagCollection> QualitiesToFlagCollectionConverter
   result.swap(mConverted);
 
   mFlagBuffer.clear();
-  mFlagBuffer.insert({ mConverted->getInterval().getMin(), mConverted->getInterval().getMax(), FlagTypeFactory::UnknownQuality(), noQOComment, mQOPath });
+  mFlagBuffer.insert(mNoQOKind, mConverted->getInterval());
   mQOsIncluded = 0;
   mWorseThanGoodQOs = 0;
+  mNewestQOStart = 0;
+  mFinalizedWatermark = 0;
+  mReportedLateQO = false;
 
   return result;
 }
 
+std::unique_ptr<QualityControlFlagCollection> QualitiesToFlagCollectionConverter::takeFinalizedFlags(validity_time_t watermark)
+{
+  auto result = std::make_unique<QualityControlFlagCollection>(
+    mConverted->getName(), mConverted->getDetector(), mConverted->getInterval(),
+    mConverted->getRunNumber(), mConverted->getPeriodName(), mConverted->getPassName(), mConverted->getProvenance());
+  mFinalizedWatermark = std::max(mFinalizedWatermark, watermark);
+  for (FlagIntervalBuffer::Kind kind = 0; kind < mFlagBuffer.getNumberOfKinds(); kind++) {
+    auto intervals = mFlagBuffer.takeEndingBefore(kind, watermark);
+    if (mFlagBuffer.getComment(kind) == toBeRemovedComment) {
+      continue;
+    }
+    for (const auto& interval : intervals) {
+      result->insert({ interval.getMin(), interval.getMax(), mFlagBuffer.getFlagType(kind), mFlagBuffer.getComment(kind), mQOPath });
+    }
+  }
+  return result;
+}
+
 size_t QualitiesToFlagCollectionConverter::getQOsIncluded() const
 {
   return mQOsIncluded;
@@ -262,13 +285,7 @@ void QualitiesToFlagCollectionConverter::updateValidityInterval(const ValidityIn
 
   // trimming existing flags
   if (mConverted->getStart() < interval.getMin() || mConverted->getEnd() > interval.getMax()) {
-    std::set<QualityControlFlag> trimmedFlags;
-    for (const auto& flag : mFlagBuffer) {
-      if (auto&& trimmedFlag = flag_helpers::intersection(flag, interval); trimmedFlag.has_value()) {
-        trimmedFlags.insert(std::move(trimmedFlag.value()));
-      }
-    }
-    mFlagBuffer.swap(trimmedFlags);
+    mFlagBuffer.intersect(interval);
   }
 
   // adding UnknownQuality to new intervals
@@ -34,21 +34,9 @@ bool updateReductorImpl(Reductor* r, const Trigger& t, const std::string& path,
     return false;
   }
 
-  if (type == "repository") {
-    auto mo = qcdb.retrieveMO(path, name, t.timestamp, t.activity, t.metadata);
-    TObject* obj = mo ? mo->getObject() : nullptr;
-    auto reductorTObject = dynamic_cast<ReductorTObject*>(r);
-    if (obj && reductorTObject) {
-      reductorTObject->update(obj);
-      return true;
-    }
-  } else if (type == "repository-quality") {
-    auto qo = qcdb.retrieveQO(path + "/" + name, t.timestamp, t.activity, t.metadata);
-    auto reductorTObject = dynamic_cast<ReductorTObject*>(r);
-    if (qo && reductorTObject) {
-      reductorTObject->update(qo.get());
-      return true;
-    }
+  if (isRepositoryDataSourceType(type)) {
+    auto input = retrieveReductorInputImpl(t, path, name, type, qcdb);
+    return updateReductorWithInput(r, input.get());
   } else if (type == "condition") {
     auto reductorConditionAny = dynamic_cast<ReductorConditionAny*>(r);
     if (reductorConditionAny) {
@@ -60,4 +48,40 @@ bool updateReductorImpl(Reductor* r, const Trigger& t, const std::string& path,
   return false;
 }
 
+std::shared_ptr<TObject> retrieveReductorInputImpl(const Trigger& t, const std::string& path, const std::string& name, const std::string& type,
+                                                   repository::DatabaseInterface& qcdb)
+{
+  if (type == "repository") {
+    auto mo = qcdb.retrieveMO(path, name, t.timestamp, t.activity, t.metadata);
+    if (mo == nullptr || mo->getObject() == nullptr) {
+      return nullptr;
+    }
+    // the returned pointer keeps the whole MonitorObject alive
+    return std::shared_ptr<TObject>(mo, mo->getObject());
+  } else if (type == "repository-quality") {
+    return qcdb.retrieveQO(path + "/" + name, t.timestamp, t.activity, t.metadata);
+  }
+  return nullptr;
+}
+
 } // namespace o2::quality_control::postprocessing::reductor_helpers::implementation
+
+namespace o2::quality_control::postprocessing::reductor_helpers
+{
+
+bool isRepositoryDataSourceType(const std::string& type)
+{
+  return type == "repository" || type == "repository-quality";
+}
+
+bool updateReductorWithInput(Reductor* r, TObject* input)
+{
+  auto reductorTObject = dynamic_cast<ReductorTObject*>(r);
+  if (input && reductorTObject) {
+    reductorTObject->update(input);
+    return true;
+  }
+  return false;
+}
+
+} // namespace o2::quality_control::postprocessing::reductor_helpers
@@ -64,10 +64,16 @@ TH1* RepositoryBenchmark::createHisto(uint64_t sizeObjects, string name)
     case 5000:
       myHisto = new TH2F(name.c_str(), "h", 12500, 0, 99, 100, 0, 99); // 5MB
       break;
+    case 10000:
+      myHisto = new TH2F(name.c_str(), "h", 25000, 0, 99, 100, 0, 99); // 10MB
+      break;
+    case 50000:
+      myHisto = new TH2F(name.c_str(), "h", 125000, 0, 99, 100, 0, 99); // 50MB
+      break;
     default:
       BOOST_THROW_EXCEPTION(
         FatalException() << errinfo_details(
-          "size of histo must be 1, 10, 100, 500, 1000, 2500 or 5000 (was: " + to_string(mSizeObjects) + ")"));
+          "size of histo must be 1, 10, 100, 500, 1000, 2500, 5000, 10000 or 50000 (was: " + to_string(mSizeObjects) + ")"));
   }
   return myHisto;
 }
@@ -97,6 +103,7 @@ void RepositoryBenchmark::InitTask()
   mNumberObjects = fConfig->GetValue<uint64_t>("number-objects");
   mSizeObjects = fConfig->GetValue<uint64_t>("size-objects");
   mDeletionMode = static_cast<bool>(fConfig->GetValue<int>("delete"));
+  mReuseSerialized = static_cast<bool>(fConfig->GetValue<int>("reuse-serialized"));
   mObjectName = fConfig->GetValue<string>("object-name");
   auto numberTasks = fConfig->GetValue<uint64_t>("number-tasks");
 
@@ -108,6 +115,7 @@ void RepositoryBenchmark::InitTask()
   mMonitoring->addGlobalTag("taskName", mTaskName);
   mMonitoring->addGlobalTag("numberObject", to_string(mNumberObjects));
   mMonitoring->addGlobalTag("sizeObject", to_string(mSizeObjects));
+  mMonitoring->addGlobalTag("reuseSerialized", to_string(mReuseSerialized));
   if (mTaskName == "benchmarkTask_0") { // send these parameters to monitoring only once per benchmark run
     mMonitoring->send(Metric{ "ccdb_benchmark" }
                         .addValue(mNumberObjects, "number_objects")
@@ -128,6 +136,19 @@ void RepositoryBenchmark::InitTask()
     mMyObjects.push_back(mo);
   }
 
+  // serialize the objects only once, so that we measure the upload alone
+  if (mReuseSerialized) {
+    if (dynamic_cast<CcdbDatabase*>(mDatabase.get()) == nullptr) {
+      BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Reusing serialized objects is supported only by the CCDB backend"));
+    }
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    for (const auto& mo : mMyObjects) {
+      mMySerializedObjects.push_back(CcdbDatabase::serialize(mo->getObject()));
+    }
+    long duration = duration_cast<milliseconds>(high_resolution_clock::now() - t1).count();
+    mMonitoring->send({ duration / mNumberObjects, "ccdb_benchmark_serialization_duration_for_one_object_ms" });
+  }
+
   // start a timer in a thread to send monitoring metrics, if needed
   if (mThreadedMonitoring) {
     mTimer = new boost::asio::system_timer(io, seconds(mThreadedMonitoringInterval));
@@ -155,7 +176,11 @@ bool RepositoryBenchmark::ConditionalRun()
 
   // Store the object
   for (unsigned int i = 0; i < mNumberObjects; i++) {
-    mDatabase->storeMO(mMyObjects[i]);
+    if (mReuseSerialized) {
+      dynamic_cast<CcdbDatabase*>(mDatabase.get())->storeMO(mMyObjects[i], mMySerializedObjects[i]);
+    } else {
+      mDatabase->storeMO(mMyObjects[i]);
+    }
     mTotalNumberObjects++;
   }
   if (!mThreadedMonitoring) {
@@ -18,6 +18,7 @@
 #define QC_REPOSITORYBENCHMARK_H
 
 #include "QualityControl/DatabaseInterface.h"
+#include "QualityControl/CcdbDatabase.h"
 #include <fairmq/Device.h>
 #include <TH1.h>
 #include <Monitoring/MonitoringFactory.h>
@@ -51,6 +52,7 @@ class RepositoryBenchmark : public fair::mq::Device
   std::string mTaskName;
   std::string mObjectName;
   bool mDeletionMode = false; // todo: is false ok as default?
+  bool mReuseSerialized = false; // objects are serialized once and the same payload is uploaded in each iteration
 
   // monitoring
   std::unique_ptr<o2::monitoring::Monitoring> mMonitoring;
@@ -61,6 +63,7 @@ class RepositoryBenchmark : public fair::mq::Device
   // internal state
   std::unique_ptr<o2::quality_control::repository::DatabaseInterface> mDatabase;
   std::vector<std::shared_ptr<MonitorObject>> mMyObjects;
+  std::vector<o2::quality_control::repository::CcdbDatabase::SerializedObject> mMySerializedObjects;
   //  TH1* mMyHisto;
 
   // variables for the timer
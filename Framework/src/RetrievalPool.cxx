@@ -0,0 +1,114 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   RetrievalPool.cxx
+///
+
+#include "QualityControl/RetrievalPool.h"
+#include "QualityControl/DatabaseInterface.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <TROOT.h>
+#include <algorithm>
+#include <chrono>
+
+namespace o2::quality_control::repository
+{
+
+RetrievalPool::RetrievalPool(DatabaseInterface& database, size_t parallelism)
+  : mDatabase(database)
+{
+  if (parallelism <= 1) {
+    return;
+  }
+  for (size_t i = 0; i < parallelism; i++) {
+    auto copy = database.clone();
+    if (copy == nullptr) {
+      ILOG(Warning, Support) << "The database implementation does not support parallel retrievals, objects will be retrieved one by one" << ENDM;
+      mWorkerDatabases.clear();
+      return;
+    }
+    mWorkerDatabases.emplace_back(std::move(copy));
+  }
+  // objects are deserialized in the worker threads
+  ROOT::EnableThreadSafety();
+  for (auto& workerDatabase : mWorkerDatabases) {
+    mWorkers.emplace_back([this, workerDatabase = workerDatabase.get()]() { workerLoop(*workerDatabase); });
+  }
+}
+
+RetrievalPool::~RetrievalPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mCondition.notify_all();
+  for (auto& worker : mWorkers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+std::shared_future<std::shared_ptr<TObject>> RetrievalPool::submit(Retrieval retrieval)
+{
+  std::packaged_task<std::shared_ptr<TObject>(DatabaseInterface&)> task(std::move(retrieval));
+  auto future = task.get_future().share();
+  if (mWorkers.empty()) {
+    task(mDatabase);
+    return future;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mQueue.emplace_back(std::move(task));
+  }
+  mCondition.notify_one();
+  return future;
+}
+
+size_t RetrievalPool::waitForAny(const std::vector<std::shared_future<std::shared_ptr<TObject>>>& retrievals)
+{
+  auto findReady = [&retrievals]() {
+    return std::find_if(retrievals.begin(), retrievals.end(), [](const auto& retrieval) {
+      return retrieval.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+  };
+  std::unique_lock<std::mutex> lock(mMutex);
+  auto ready = findReady();
+  // the workers notify after setting the result and locking the mutex, so a completion cannot be missed here
+  mCompletionCondition.wait(lock, [&]() { return (ready = findReady()) != retrievals.end(); });
+  return std::distance(retrievals.begin(), ready);
+}
+
+void RetrievalPool::workerLoop(DatabaseInterface& database)
+{
+  while (true) {
+    std::packaged_task<std::shared_ptr<TObject>(DatabaseInterface&)> task;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mCondition.wait(lock, [this]() { return mStopping || !mQueue.empty(); });
+      if (mQueue.empty()) { // stopping and nothing left to retrieve
+        return;
+      }
+      task = std::move(mQueue.front());
+      mQueue.pop_front();
+    }
+    task(database);
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+    }
+    mCompletionCondition.notify_all();
+  }
+}
+
+} // namespace o2::quality_control::repository
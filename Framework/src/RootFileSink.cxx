@@ -63,13 +63,13 @@ void RootFileSink::run(framework::ProcessingContext& pctx)
       }
       ILOG(Info, Support) << "Received MonitorObjectCollection '" << moc->GetName() << "'" << ENDM;
       moc->postDeserialization();
-      auto mwMOC = dynamic_cast<MonitorObjectCollection*>(moc->cloneMovingWindow());
+      std::unique_ptr<MonitorObjectCollection> mwMOC(dynamic_cast<MonitorObjectCollection*>(moc->cloneMovingWindow()));
 
       if (moc->GetEntries() > 0) {
         mStorage.storeIntegralMOC(moc.get());
       }
       if (mwMOC->GetEntries() > 0) {
-        mStorage.storeMovingWindowMOC(mwMOC);
+        mStorage.storeMovingWindowMOC(mwMOC.get());
       }
     }
   } catch (const std::bad_alloc& ex) {
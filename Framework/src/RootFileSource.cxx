@@ -23,6 +23,7 @@
 #include <Framework/DeviceSpec.h>
 #include <TFile.h>
 #include <TKey.h>
+#include <boost/algorithm/string.hpp>
 
 using namespace o2::framework;
 
@@ -61,16 +62,24 @@ void RootFileSource::run(framework::ProcessingContext& ctx)
 {
   if (mIntegralMocWalker->hasNextPath()) {
     const auto& path = mIntegralMocWalker->nextPath();
+    // the path tells the detector and the task, so we can skip the objects which are not requested without reading them
+    if (!isAllowed(outputBindingFromPath(path, false))) {
+      ILOG(Debug, Support) << "The MonitorObjectCollection '" << path << "' is not among declared output bindings, skipping." << ENDM;
+      return;
+    }
     auto moc = mRootFileManager->readMonitorObjectCollection(path);
+    if (moc == nullptr) {
+      return;
+    }
     auto binding = outputBinding(moc->getDetector(), moc->getTaskName(), false);
 
-    if (std::find_if(mAllowedOutputs.begin(), mAllowedOutputs.end(),
-                     [binding](const auto& other) { return other.value == binding.value; }) == mAllowedOutputs.end()) {
+    if (!isAllowed(binding)) {
       ILOG(Error) << "The MonitorObjectCollection '" << binding.value << "' is not among declared output bindings: ";
       for (const auto& output : mAllowedOutputs) {
         ILOG(Error) << output.value << " ";
       }
       ILOG(Error) << ", skipping." << ENDM;
+      delete moc;
       return;
     }
     // snapshot does a shallow copy, so we cannot let it delete elements in MOC when it deletes the MOC
@@ -85,16 +94,24 @@ void RootFileSource::run(framework::ProcessingContext& ctx)
 
   if (mMovingWindowMocWalker->hasNextPath()) {
     const auto& path = mMovingWindowMocWalker->nextPath();
+    // the path tells the detector and the task, so we can skip the objects which are not requested without reading them
+    if (!isAllowed(outputBindingFromPath(path, true))) {
+      ILOG(Debug, Support) << "The MonitorObjectCollection '" << path << "' is not among declared output bindings, skipping." << ENDM;
+      return;
+    }
     auto moc = mRootFileManager->readMonitorObjectCollection(path);
+    if (moc == nullptr) {
+      return;
+    }
     auto binding = outputBinding(moc->getDetector(), moc->getTaskName(), true);
 
-    if (std::find_if(mAllowedOutputs.begin(), mAllowedOutputs.end(),
-                     [binding](const auto& other) { return other.value == binding.value; }) == mAllowedOutputs.end()) {
+    if (!isAllowed(binding)) {
       ILOG(Error) << "The MonitorObjectCollection '" << binding.value << "' is not among declared output bindings: ";
       for (const auto& output : mAllowedOutputs) {
         ILOG(Error) << output.value << " ";
       }
       ILOG(Error) << ", skipping." << ENDM;
+      delete moc;
       return;
     }
     // snapshot does a shallow copy, so we cannot let it delete elements in MOC when it deletes the MOC
@@ -113,6 +130,23 @@ void RootFileSource::run(framework::ProcessingContext& ctx)
   ctx.services().get<ControlService>().readyToQuit(QuitRequest::Me);
 }
 
+bool RootFileSource::isAllowed(const std::optional<framework::OutputLabel>& binding) const
+{
+  return binding.has_value() && std::find_if(mAllowedOutputs.begin(), mAllowedOutputs.end(),
+                                             [&binding](const auto& other) { return other.value == binding->value; }) != mAllowedOutputs.end();
+}
+
+std::optional<framework::OutputLabel> RootFileSource::outputBindingFromPath(const std::string& path, bool movingWindow)
+{
+  // integrated objects are stored in int/DET/TASK, moving windows in mw/DET/TASK/<validFrom>
+  std::vector<std::string> parts;
+  boost::split(parts, path, boost::is_any_of("/"));
+  if (parts.size() < 3) {
+    return std::nullopt;
+  }
+  return outputBinding(parts[1], parts[2], movingWindow);
+}
+
 framework::OutputLabel
   RootFileSource::outputBinding(const std::string& detectorCode, const std::string& taskName, bool movingWindow)
 {
@@ -20,6 +20,7 @@
 #include "QualityControl/MonitorObject.h"
 #include "QualityControl/ValidityInterval.h"
 
+#include <TClass.h>
 #include <TFile.h>
 #include <TKey.h>
 #include <TIterator.h>
@@ -55,6 +56,22 @@ RootFileStorage::RootFileStorage(const std::string& filePath, ReadMode readMode)
   ILOG(Info) << "Output file '" << filePath << "' successfully open." << ENDM;
 }
 
+namespace
+{
+RootFileStorage::MonitorObjectCollectionNode createIndexEntry(TKey* key, const std::string& mocPath, bool movingWindow)
+{
+  RootFileStorage::MonitorObjectCollectionNode node{ mocPath, key->GetName() };
+  if (movingWindow) {
+    try {
+      node.validFrom = std::stoull(key->GetName());
+    } catch (...) {
+      ILOG(Warning, Support) << "Could not deduce the validity start of the moving window '" << mocPath << "'" << ENDM;
+    }
+  }
+  return node;
+}
+} // namespace
+
 RootFileStorage::DirectoryNode RootFileStorage::readStructure(bool loadObjects) const
 {
   return readStructureImpl(mFile, loadObjects);
@@ -70,14 +87,26 @@ RootFileStorage::DirectoryNode RootFileStorage::readStructureImpl(TDirectory* cu
   }
   DirectoryNode currentNode{ pathToPos + 2, currentDir->GetName() };
 
+  // moving windows are stored in mw/DET/TASK/<validFrom>
+  const bool movingWindowDir = currentNode.fullPath.find(std::string(movingWindowsDirectoryName) + "/") == 0;
+
   TIter nextKey(currentDir->GetListOfKeys());
   TKey* key;
   while ((key = (TKey*)nextKey())) {
-    if (!loadObjects && std::strcmp(key->GetClassName(), MonitorObjectCollection::Class_Name()) == 0) {
+    const bool isMOC = std::strcmp(key->GetClassName(), MonitorObjectCollection::Class_Name()) == 0;
+    if (!loadObjects && isMOC) {
       std::string mocPath = currentNode.fullPath + std::filesystem::path::preferred_separator + key->GetName();
-      currentNode.children[key->GetName()] = MonitorObjectCollectionNode{ mocPath, key->GetName() };
+      currentNode.children[key->GetName()] = createIndexEntry(key, mocPath, movingWindowDir);
       continue;
     }
+    if (!loadObjects && !isMOC) {
+      // we avoid reading objects which would be skipped anyway
+      auto keyClass = TClass::GetClass(key->GetClassName());
+      if (keyClass == nullptr || !keyClass->InheritsFrom(TDirectory::Class())) {
+        ILOG(Warning, Support) << "The key '" << key->GetName() << "' of class '" << key->GetClassName() << "' is neither a MonitorObjectCollection nor a TDirectory, skipping." << ENDM;
+        continue;
+      }
+    }
 
     ILOG(Debug, Devel) << "Getting the value for key '" << key->GetName() << "'" << ENDM;
     auto* value = currentDir->Get(key->GetName());
@@ -88,7 +117,9 @@ RootFileStorage::DirectoryNode RootFileStorage::readStructureImpl(TDirectory* cu
     if (auto moc = dynamic_cast<MonitorObjectCollection*>(value)) {
       moc->postDeserialization();
       std::string mocPath = currentNode.fullPath + std::filesystem::path::preferred_separator + key->GetName();
-      currentNode.children[moc->GetName()] = MonitorObjectCollectionNode{ mocPath, key->GetName(), moc };
+      auto mocNode = createIndexEntry(key, mocPath, movingWindowDir);
+      mocNode.moc = moc;
+      currentNode.children[moc->GetName()] = std::move(mocNode);
       ILOG(Debug, Support) << "Read object '" << moc->GetName() << "' in path '" << currentNode.fullPath << "'" << ENDM;
     } else if (auto childDir = dynamic_cast<TDirectory*>(value)) {
       currentNode.children[key->GetName()] = readStructureImpl(childDir, loadObjects);
@@ -345,8 +376,8 @@ MovingWindowMocWalker::MovingWindowMocWalker(const RootFileStorage::DirectoryNod
       stack.push({ childNode, childNode.children.begin() });
     } else if (std::holds_alternative<RootFileStorage::MonitorObjectCollectionNode>(childIt->second)) {
       // move to the next child in the currentNode and return a path
-      auto timestamp = std::stoull(childIt->first);
       auto& childNode = std::get<RootFileStorage::MonitorObjectCollectionNode>(childIt->second);
+      auto timestamp = childNode.validFrom.has_value() ? childNode.validFrom.value() : std::stoull(childIt->first);
       mOrder.emplace(timestamp, childNode.fullPath);
       childIt++;
     } else {
@@ -23,6 +23,7 @@
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/RepoPathUtils.h"
 #include "QualityControl/ActivityHelpers.h"
+#include "QualityControl/TrendPlotHelpers.h"
 
 #include <string>
 #include <TGraphErrors.h>
@@ -35,10 +36,14 @@
 #include <TMultiGraph.h>
 #include <TLegend.h>
 #include <TCanvas.h>
+#include <Monitoring/Monitoring.h>
+#include <algorithm>
+#include <chrono>
 
 using namespace o2::quality_control;
 using namespace o2::quality_control::core;
 using namespace o2::quality_control::postprocessing;
+using namespace o2::monitoring;
 
 void SliceTrendingTask::configure(const boost::property_tree::ptree& config)
 {
@@ -55,6 +60,7 @@ void SliceTrendingTask::initialize(Trigger t, framework::ServiceRegistryRef serv
   }
 
   mPlots.clear();
+  mPlottedEntries.clear();
   mReductors.clear();
   mSources.clear();
 
@@ -133,19 +139,105 @@ void SliceTrendingTask::finalize(Trigger t, framework::ServiceRegistryRef)
   }
 }
 
-void SliceTrendingTask::trendValues(const Trigger& t,
-                                    repository::DatabaseInterface& qcdb)
+void SliceTrendingTask::backfill(const std::vector<Trigger>& triggers, framework::ServiceRegistryRef services, size_t workers)
+{
+  auto& qcdb = services.get<repository::DatabaseInterface>();
+  const bool allFromRepository = std::all_of(mConfig.dataSources.begin(), mConfig.dataSources.end(), [](const auto& dataSource) {
+    return dataSource.type == "repository";
+  });
+
+  // each worker retrieves with its own database and slices with its own reductors
+  struct Worker {
+    std::unique_ptr<repository::DatabaseInterface> qcdb;
+    std::unordered_map<std::string, std::unique_ptr<SliceReductor>> reductors;
+  };
+  std::vector<Worker> backfillWorkers(allFromRepository ? workers : 0);
+  for (auto& worker : backfillWorkers) {
+    worker.qcdb = qcdb.clone();
+    if (worker.qcdb == nullptr) {
+      backfillWorkers.clear();
+      break;
+    }
+  }
+  if (workers <= 1 || backfillWorkers.empty()) {
+    ILOG(Info, Support) << "The trend can be backfilled in parallel only with repository data sources and a database which can be copied, "
+                        << "the triggers are processed one by one" << ENDM;
+    PostProcessingInterface::backfill(triggers, services, workers);
+    return;
+  }
+  for (auto& worker : backfillWorkers) {
+    for (const auto& source : mConfig.dataSources) {
+      worker.reductors[source.name].reset(root_class_factory::create<SliceReductor>(source.moduleName, source.reductorName));
+    }
+  }
+
+  // the slices are kept for each trigger until they are appended to the trend in the triggers order
+  struct Entry {
+    UInt_t time = 0;
+    MetaData metaData;
+    std::unordered_map<std::string, std::vector<SliceInfo>> sources;
+    std::unordered_map<std::string, int> numberPads;
+    bool complete = false;
+  };
+  std::vector<Entry> entries(triggers.size());
+  processInParallel(triggers, workers, [&](size_t trigger, size_t workerIndex) {
+    auto& worker = backfillWorkers[workerIndex];
+    const auto& t = triggers[trigger];
+    auto& entry = entries[trigger];
+    setEntryTime(t, entry.time, entry.metaData);
+    for (const auto& dataSource : mConfig.dataSources) {
+      auto mo = worker.qcdb->retrieveMO(dataSource.path, dataSource.name, t.timestamp, t.activity, t.metadata);
+      TObject* obj = mo ? mo->getObject() : nullptr;
+      if (obj == nullptr) {
+        return false;
+      }
+      auto axisDivision = dataSource.axisDivision; // the reductors take it by non-const reference
+      worker.reductors.at(dataSource.name)->update(obj, entry.sources[dataSource.name], axisDivision, entry.numberPads[dataSource.name]);
+    }
+    entry.complete = true;
+    return true;
+  });
+
+  for (const auto& dataSource : mConfig.dataSources) {
+    mAxisDivision[dataSource.name] = dataSource.axisDivision;
+    mSliceLabel[dataSource.name] = dataSource.sliceLabels;
+  }
+  for (auto& entry : entries) {
+    // as in trendValues, the triggers with missing objects are skipped
+    if (!entry.complete) {
+      continue;
+    }
+    mTime = entry.time;
+    mMetaData = entry.metaData;
+    for (auto& [sourceName, slices] : entry.sources) {
+      mSources[sourceName]->swap(slices);
+      mNumberPads[sourceName] = entry.numberPads[sourceName];
+    }
+    mTrend->Fill();
+  }
+  if (mConfig.producePlotsOnUpdate) {
+    generatePlots();
+  }
+}
+
+void SliceTrendingTask::setEntryTime(const Trigger& t, UInt_t& time, MetaData& metaData) const
 {
   if (mConfig.trendingTimestamp == "trigger") {
     // ROOT expects seconds since epoch.
-    mTime = t.timestamp / 1000;
+    time = t.timestamp / 1000;
   } else if (mConfig.trendingTimestamp == "validFrom") {
-    mTime = t.activity.mValidity.getMin() / 1000;
+    time = t.activity.mValidity.getMin() / 1000;
   } else { // validUntil
-    mTime = t.activity.mValidity.getMax() / 1000;
+    time = t.activity.mValidity.getMax() / 1000;
   }
-  mMetaData.runNumber = t.activity.mId;
-  std::snprintf(mMetaData.runNumberStr, MaxRunNumberStringLength + 1, "%d", t.activity.mId);
+  metaData.runNumber = t.activity.mId;
+  std::snprintf(metaData.runNumberStr, MaxRunNumberStringLength + 1, "%d", t.activity.mId);
+}
+
+void SliceTrendingTask::trendValues(const Trigger& t,
+                                    repository::DatabaseInterface& qcdb)
+{
+  setEntryTime(t, mTime, mMetaData);
 
   for (auto& dataSource : mConfig.dataSources) {
     mNumberPads[dataSource.name] = 0;
@@ -186,7 +278,16 @@ void SliceTrendingTask::generatePlots()
   }
 
   ILOG(Info, Support) << "Generating " << mConfig.plots.size() << " plots." << ENDM;
+  const auto start = std::chrono::steady_clock::now();
+  size_t appendedPlots = 0;
   for (const auto& plot : mConfig.plots) {
+    if (mConfig.incrementalPlots && appendToPlot(plot)) {
+      appendedPlots++;
+      mPlottedEntries[plot.name] = mTrend->GetEntries();
+      getObjectsManager()->startPublishing(mPlots[plot.name], PublicationPolicy::Once);
+      continue;
+    }
+
     // Delete the existing plots before regenerating them.
     if (mPlots.count(plot.name)) {
       delete mPlots[plot.name];
@@ -260,10 +361,95 @@ void SliceTrendingTask::generatePlots()
     }
 
     mPlots[plot.name] = c;
+    mPlottedEntries[plot.name] = mTrend->GetEntries();
     getObjectsManager()->startPublishing(c, PublicationPolicy::Once);
   }
+
+  const double durationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  ILOG(Debug, Devel) << "Plotting took " << durationMs << " ms, " << appendedPlots << " plot(s) updated incrementally" << ENDM;
+  if (mMonitoring) {
+    mMonitoring->send(Metric{ "qc_trending_plotting" }
+                        .addValue(durationMs, "duration_ms")
+                        .addValue(static_cast<uint64_t>(mConfig.plots.size() - appendedPlots), "redrawn_plots")
+                        .addValue(static_cast<uint64_t>(appendedPlots), "appended_plots")
+                        .addValue(static_cast<uint64_t>(mTrend->GetEntries()), "trend_entries"));
+  }
 } // void SliceTrendingTask::generatePlots()
 
+bool SliceTrendingTask::appendToPlot(const SliceTrendingTaskConfig::Plot& plot)
+{
+  auto canvas = dynamic_cast<TCanvas*>(mPlots.count(plot.name) ? mPlots[plot.name] : nullptr);
+  if (canvas == nullptr || mPlottedEntries.count(plot.name) == 0) {
+    return false;
+  }
+  const Long64_t newEntries = mTrend->GetEntries() - mPlottedEntries[plot.name];
+  if (newEntries == 0) {
+    return true; // the trend was not updated, the plot is still valid
+  }
+  // the values of the sources are available only for the entry filled last
+  if (newEntries != 1) {
+    return false;
+  }
+
+  std::string varName, typeName, trendType;
+  getTrendVariables(plot.varexp, varName, typeName, trendType);
+  std::string errXName, errYName;
+  getTrendErrors(plot.graphErrors, errXName, errYName);
+  // slices are drawn out of the last entry only, thus they are always drawn again
+  const bool multigraph = trendType == "multigraphtime" || trendType == "multigraphrun";
+  if (!multigraph && trendType != "time" && trendType != "run") {
+    return false;
+  }
+  const auto& sources = mSources[varName];
+  const int numberPads = mNumberPads[varName];
+  if (sources == nullptr || sources->size() < static_cast<size_t>(numberPads)) {
+    return false;
+  }
+
+  // we find all the graphs and check that the new points fit into their axes before modifying anything
+  std::vector<TGraphErrors*> graphs;
+  std::vector<TH1*> frames;
+  if (multigraph) {
+    auto pad = canvas->GetPad(1);
+    auto multiGraph = pad ? dynamic_cast<TMultiGraph*>(pad->GetPrimitive("MultiGraph")) : nullptr;
+    if (multiGraph == nullptr || multiGraph->GetListOfGraphs() == nullptr || multiGraph->GetListOfGraphs()->GetSize() != numberPads) {
+      return false;
+    }
+    for (auto graph : *multiGraph->GetListOfGraphs()) {
+      graphs.push_back(dynamic_cast<TGraphErrors*>(graph));
+    }
+    frames.assign(graphs.size(), multiGraph->GetHistogram());
+  } else {
+    for (int p = 0; p < numberPads; p++) {
+      auto pad = canvas->GetPad(p + 1);
+      auto graph = pad ? dynamic_cast<TGraphErrors*>(pad->GetPrimitive("Graph")) : nullptr;
+      graphs.push_back(graph);
+      frames.push_back(graph ? graph->GetHistogram() : nullptr);
+    }
+  }
+
+  const double x = (trendType == "time" || trendType == "multigraphtime") ? mTime : mMetaData.runNumber;
+  std::vector<double> ys, errorsX, errorsY;
+  for (int p = 0; p < numberPads; p++) {
+    auto& slice = sources->at(p);
+    ys.push_back(slice.retrieveValue(typeName));
+    errorsX.push_back(plot.graphErrors.empty() ? 0. : slice.retrieveValue(errXName));
+    errorsY.push_back(plot.graphErrors.empty() ? 0. : slice.retrieveValue(errYName));
+    if (graphs[p] == nullptr || !trend_plot_helpers::fitInFrame(frames[p], { &x, 1 }, { &ys[p], 1 }, plot.graphXRange.empty(), plot.graphYRange.empty())) {
+      return false;
+    }
+  }
+
+  for (int p = 0; p < numberPads; p++) {
+    trend_plot_helpers::appendPoints(graphs[p], { &x, 1 }, { &ys[p], 1 }, { &errorsX[p], 1 }, { &errorsY[p], 1 });
+    if (auto pad = canvas->GetPad(multigraph ? 1 : p + 1)) {
+      pad->Modified();
+    }
+  }
+  canvas->Modified();
+  return true;
+}
+
 void SliceTrendingTask::drawCanvasMO(TCanvas* thisCanvas, const std::string& var,
                                      const std::string& name, const std::string& opt, const std::string& err, const std::vector<std::vector<float>>& axis, const std::vector<std::vector<std::string>>& sliceLabels, const TitleSettings& titlesettings)
 {
@@ -16,6 +16,7 @@
 ///
 
 #include "QualityControl/TaskInterface.h"
+#include "QualityControl/WorkerPool.h"
 
 namespace o2::quality_control::core
 {
@@ -46,6 +47,27 @@ const o2::globaltracking::DataRequest* TaskInterface::getGlobalTrackingDataReque
   return mGlobalTrackingDataRequest.get();
 }
 
+void TaskInterface::setWorkerPool(std::shared_ptr<WorkerPool> workerPool)
+{
+  mWorkerPool = std::move(workerPool);
+}
+
+size_t TaskInterface::getNumberOfWorkers() const
+{
+  return mWorkerPool ? mWorkerPool->getNumberOfWorkers() : 1;
+}
+
+void TaskInterface::parallelFor(size_t nItems, const std::function<void(size_t item, size_t worker)>& work)
+{
+  if (mWorkerPool) {
+    mWorkerPool->run(nItems, work);
+  } else {
+    for (size_t item = 0; item < nItems; item++) {
+      work(item, 0);
+    }
+  }
+}
+
 void TaskInterface::finaliseCCDB(framework::ConcreteDataMatcher& matcher, void* obj)
 {
 }
@@ -38,6 +38,7 @@
 #include <DetectorsBase/GRPGeomHelper.h>
 
 #include "QualityControl/ObjectMetadataKeys.h"
+#include "QualityControl/LatencyTracing.h"
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/TaskFactory.h"
 #include "QualityControl/runnerUtils.h"
@@ -49,10 +50,12 @@
 #include "QualityControl/TimekeeperFactory.h"
 #include "QualityControl/ActivityHelpers.h"
 #include "QualityControl/WorkflowType.h"
+#include "QualityControl/WorkerPool.h"
 #include "QualityControl/runnerUtils.h"
 
 #include <string>
 #include <TFile.h>
+#include <TROOT.h>
 #include <boost/property_tree/ptree.hpp>
 #include <TSystem.h>
 
@@ -108,6 +111,7 @@ void TaskRunner::init(InitContext& iCtx)
   // setup publisher
   mObjectsManager = std::make_shared<ObjectsManager>(mTaskConfig.name, mTaskConfig.className, mTaskConfig.detectorName, mTaskConfig.parallelTaskID);
   mObjectsManager->setMovingWindowsList(mTaskConfig.movingWindows);
+  mObjectsManager->setNumberOfShards(mTaskConfig.parallelWorkers);
 
   // setup timekeeping
   mDeploymentMode = DefaultsHelpers::deploymentMode();
@@ -124,6 +128,12 @@ void TaskRunner::init(InitContext& iCtx)
   mTask->setMonitoring(mCollector);
   mTask->setGlobalTrackingDataRequest(mTaskConfig.globalTrackingDataRequest);
   mTask->setDatabase(mTaskConfig.repository);
+  if (mTaskConfig.parallelWorkers > 1) {
+    ILOG(Info, Devel) << "The task may use " << mTaskConfig.parallelWorkers << " parallel workers" << ENDM;
+    // the workers fill separate copies of the objects, but ROOT has global state which must be protected
+    ROOT::EnableThreadSafety();
+    mTask->setWorkerPool(std::make_shared<WorkerPool>(mTaskConfig.parallelWorkers));
+  }
 
   // load config params
   if (!ConfigParamGlo::keyValues.empty()) {
@@ -162,6 +172,7 @@ void TaskRunner::run(ProcessingContext& pCtx)
     finishCycle(pCtx.outputs());
     if (mTaskConfig.resetAfterCycles > 0 && (mCycleNumber % mTaskConfig.resetAfterCycles == 0)) {
       mTask->reset();
+      mObjectsManager->notifyObjectsReset();
       mTimekeeper->reset();
     }
     if (mTaskConfig.maxNumberCycles < 0 || mCycleNumber < mTaskConfig.maxNumberCycles) {
@@ -172,6 +183,9 @@ void TaskRunner::run(ProcessingContext& pCtx)
   }
 
   if (isDataReady(pCtx.inputs())) {
+    if (mTaskConfig.latencyTracing && mCycleFirstDataTimestamp == 0) {
+      mCycleFirstDataTimestamp = latency_tracing::getCurrentTimestamp();
+    }
     mTimekeeper->updateByTimeFrameID(pCtx.services().get<TimingInfo>().tfCounter);
     mTask->monitorData(pCtx);
     updateMonitoringStats(pCtx);
@@ -294,12 +308,14 @@ void TaskRunner::stop(ServiceRegistryRef services)
   try {
     mActivity = o2::quality_control::core::computeActivity(services, mActivity);
     if (mCycleOn) {
+      mergeShards();
       mTask->endOfCycle();
       mCycleNumber++;
       mCycleOn = false;
     }
     endOfActivity();
     mTask->reset();
+    mObjectsManager->notifyObjectsReset();
   } catch (...) {
     // we catch here because we don't know where it will go in DPL's CallbackService
     ILOG(Error, Support) << "Error caught in stop() : "
@@ -399,6 +415,7 @@ void TaskRunner::startCycle()
   mNumberMessagesReceivedInCycle = 0;
   mNumberObjectsPublishedInCycle = 0;
   mDataReceivedInCycle = 0;
+  mCycleFirstDataTimestamp = 0;
   mTimerDurationCycle.reset();
   mCycleOn = true;
 }
@@ -415,12 +432,16 @@ void TaskRunner::registerToBookkeeping()
 void TaskRunner::finishCycle(DataAllocator& outputs)
 {
   ILOG(Debug, Support) << "Finish cycle " << mCycleNumber << ENDM;
+  if (mTaskConfig.latencyTracing) {
+    mCycleEndTimestamp = latency_tracing::getCurrentTimestamp();
+  }
   // in the async context we print only info/ops logs, it's easier to temporarily elevate this log
   ((mDeploymentMode == DeploymentMode::Grid) ? ILOG(Info, Ops) : ILOG(Info, Devel)) //
     << "The objects validity is "
     << "(" << mTimekeeper->getValidity().getMin() << ", " << mTimekeeper->getValidity().getMax() << "), "
     << "(" << mTimekeeper->getSampleTimespan().getMin() << ", " << mTimekeeper->getSampleTimespan().getMax() << "), "
     << "(" << mTimekeeper->getTimerangeIdRange().getMin() << ", " << mTimekeeper->getTimerangeIdRange().getMax() << ")" << ENDM;
+  mergeShards();
   mTask->endOfCycle();
 
   if (mCycleNumber == 0) { // register at the end of the first cycle
@@ -443,6 +464,17 @@ void TaskRunner::finishCycle(DataAllocator& outputs)
   }
 }
 
+void TaskRunner::mergeShards()
+{
+  if (mObjectsManager->getNumberOfShards() <= 1) {
+    return;
+  }
+  AliceO2::Common::Timer mergeDurationTimer;
+  mObjectsManager->mergeShards();
+  mLastShardsMergeDuration = mergeDurationTimer.getTime();
+  ILOG(Debug, Devel) << "Merged the objects of " << mObjectsManager->getNumberOfShards() << " workers in " << mLastShardsMergeDuration << "s" << ENDM;
+}
+
 void TaskRunner::updateMonitoringStats(ProcessingContext& pCtx)
 {
   mNumberMessagesReceivedInCycle++;
@@ -476,6 +508,9 @@ void TaskRunner::publishCycleStats()
                      .addValue(cycleDuration, "module_cycle")
                      .addValue(mLastPublicationDuration, "publication")
                      .addValue(totalDurationActivity, "activity_whole_run"));
+  if (mTaskConfig.parallelWorkers > 1) {
+    mCollector->send(Metric{ "qc_duration" }.addValue(mLastShardsMergeDuration, "shards_merge"));
+  }
 
   mCollector->send(Metric{ "qc_objects_published" }
                      .addValue(mNumberObjectsPublishedInCycle, "in_cycle")
@@ -492,8 +527,17 @@ int TaskRunner::publish(DataAllocator& outputs)
   auto concreteOutput = framework::DataSpecUtils::asConcreteDataMatcher(mTaskConfig.moSpec);
   // getNonOwningArray creates a TObjArray containing the monitoring objects, but not
   // owning them. The array is created by new and must be cleaned up by the caller
-  std::unique_ptr<MonitorObjectCollection> array(mObjectsManager->getNonOwningArray());
+  std::unique_ptr<MonitorObjectCollection> array(mTaskConfig.publishChangedObjectsOnly
+                                                   ? mObjectsManager->getNonOwningArrayOfChangedObjects()
+                                                   : mObjectsManager->getNonOwningArray());
   array->addOrUpdateMetadata(repository::metadata_keys::cycleNumber, std::to_string(mCycleNumber));
+  if (mTaskConfig.latencyTracing) {
+    // without data in the cycle, the previous stamp must be overwritten anyway
+    const auto firstData = mCycleFirstDataTimestamp > 0 ? mCycleFirstDataTimestamp : mCycleEndTimestamp;
+    array->addOrUpdateMetadata(repository::metadata_keys::traceFirstData, std::to_string(firstData));
+    array->addOrUpdateMetadata(repository::metadata_keys::traceCycleEnd, std::to_string(mCycleEndTimestamp));
+    array->addOrUpdateMetadata(repository::metadata_keys::traceSnapshot, std::to_string(latency_tracing::getCurrentTimestamp()));
+  }
   int objectsPublished = array->GetEntries();
 
   outputs.snapshot(
@@ -37,6 +37,8 @@
 
 #include <Framework/TimerParamSpec.h>
 
+#include <algorithm>
+
 namespace o2::quality_control::core
 {
 
@@ -170,6 +172,14 @@ TaskRunnerConfig TaskRunnerFactory::extractConfig(const CommonSpec& globalConfig
 
   o2::globaltracking::RecoContainer rd;
 
+  bool publishChangedObjectsOnly = taskSpec.publishChangedObjectsOnly;
+  if (publishChangedObjectsOnly && taskSpec.mergingMode == "entire") {
+    // Mergers which expect entire objects would replace the complete collection of a task with a partial one
+    ILOG(Warning, Support) << "The option 'publishChangedObjectsOnly' cannot be used with the merging mode 'entire', disabling it for the task '"
+                           << taskSpec.taskName << "'" << ENDM;
+    publishChangedObjectsOnly = false;
+  }
+
   return {
     taskSpec.taskName,
     taskSpec.moduleName,
@@ -198,6 +208,9 @@ TaskRunnerConfig TaskRunnerFactory::extractConfig(const CommonSpec& globalConfig
     globalTrackingDataRequest,
     taskSpec.movingWindows,
     taskSpec.disableLastCycle,
+    publishChangedObjectsOnly,
+    std::max<size_t>(taskSpec.parallelWorkers, 1),
+    globalConfig.latencyTracing,
   };
 }
 
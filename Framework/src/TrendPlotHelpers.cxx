@@ -0,0 +1,78 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    TrendPlotHelpers.cxx
+///
+
+#include "QualityControl/TrendPlotHelpers.h"
+
+#include <TGraphErrors.h>
+#include <TH1.h>
+#include <algorithm>
+
+namespace o2::quality_control::postprocessing::trend_plot_helpers
+{
+
+std::vector<std::string> splitVarexp(const std::string& varexp)
+{
+  std::vector<std::string> expressions(1);
+  for (size_t i = 0; i < varexp.size(); i++) {
+    const bool scopeOperator = (i + 1 < varexp.size() && varexp[i + 1] == ':') || (i > 0 && varexp[i - 1] == ':');
+    if (varexp[i] == ':' && !scopeOperator) {
+      expressions.emplace_back();
+    } else {
+      expressions.back() += varexp[i];
+    }
+  }
+  return expressions;
+}
+
+void appendPoints(TGraph* graph, std::span<const double> x, std::span<const double> y, std::span<const double> ex, std::span<const double> ey)
+{
+  if (graph == nullptr || x.empty()) {
+    return;
+  }
+  // TGraph::SetPoint would make the graph recompute its axes and lose their settings,
+  // so we extend the arrays and write the new points directly.
+  const auto previousSize = graph->GetN();
+  graph->Set(previousSize + static_cast<Int_t>(x.size()));
+  std::copy(x.begin(), x.end(), graph->GetX() + previousSize);
+  std::copy(y.begin(), y.end(), graph->GetY() + previousSize);
+
+  auto graphErrors = dynamic_cast<TGraphErrors*>(graph);
+  if (graphErrors != nullptr && !ex.empty() && !ey.empty()) {
+    std::copy(ex.begin(), ex.end(), graphErrors->GetEX() + previousSize);
+    std::copy(ey.begin(), ey.end(), graphErrors->GetEY() + previousSize);
+  }
+}
+
+bool fitInFrame(const TH1* frame, std::span<const double> x, std::span<const double> y, bool checkX, bool checkY)
+{
+  if (frame == nullptr) {
+    return false;
+  }
+  const double xMin = frame->GetXaxis()->GetXmin();
+  const double xMax = frame->GetXaxis()->GetXmax();
+  // graphs keep their y range in the minimum and maximum of their histogram, TTree::Draw uses the y axis of a TH2
+  const double yMin = frame->GetDimension() > 1 ? frame->GetYaxis()->GetXmin() : frame->GetMinimum();
+  const double yMax = frame->GetDimension() > 1 ? frame->GetYaxis()->GetXmax() : frame->GetMaximum();
+
+  if (checkX && std::any_of(x.begin(), x.end(), [&](double value) { return value < xMin || value > xMax; })) {
+    return false;
+  }
+  if (checkY && std::any_of(y.begin(), y.end(), [&](double value) { return value < yMin || value > yMax; })) {
+    return false;
+  }
+  return true;
+}
+
+} // namespace o2::quality_control::postprocessing::trend_plot_helpers
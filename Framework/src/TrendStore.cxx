@@ -0,0 +1,306 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   TrendStore.cxx
+///
+
+#include "QualityControl/TrendStore.h"
+
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+
+namespace o2::quality_control::postprocessing
+{
+
+namespace
+{
+
+// the sizes of the leaf types, as documented in TTree
+size_t getLeafTypeSize(char type)
+{
+  switch (type) {
+    case 'B':
+    case 'b':
+    case 'O':
+    case 'C':
+      return 1;
+    case 'S':
+    case 's':
+      return 2;
+    case 'I':
+    case 'i':
+    case 'F':
+    case 'f':
+      return 4;
+    case 'D':
+    case 'd':
+    case 'L':
+    case 'l':
+    case 'G':
+    case 'g':
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+template <typename T>
+double read(const char* address)
+{
+  T value;
+  std::memcpy(&value, address, sizeof(T));
+  return static_cast<double>(value);
+}
+
+double readLeafValue(const char* address, char type)
+{
+  switch (type) {
+    case 'B':
+      return read<Char_t>(address);
+    case 'b':
+      return read<UChar_t>(address);
+    case 'O':
+      return read<Bool_t>(address);
+    case 'S':
+      return read<Short_t>(address);
+    case 's':
+      return read<UShort_t>(address);
+    case 'I':
+      return read<Int_t>(address);
+    case 'i':
+      return read<UInt_t>(address);
+    case 'F':
+    case 'f':
+      return read<Float_t>(address);
+    case 'D':
+    case 'd':
+      return read<Double_t>(address);
+    case 'L':
+      return read<Long64_t>(address);
+    case 'l':
+      return read<ULong64_t>(address);
+    case 'G':
+      return read<Long_t>(address);
+    case 'g':
+      return read<ULong_t>(address);
+    default:
+      return 0;
+  }
+}
+
+struct Leaf {
+  std::string name;
+  std::vector<size_t> dimensions;
+  char type = 0;
+  size_t offset = 0;
+};
+
+// Parses a leaf list such as "mean/D:stddev:entries[2][5]/I". The type applies also to the subsequent leaves without
+// an explicit type. The parsing stops at the first leaf which does not allow to know the position of the next ones.
+std::vector<Leaf> parseLeafList(const std::string& leafList)
+{
+  std::vector<std::string> tokens;
+  boost::split(tokens, leafList, boost::is_any_of(":"));
+
+  std::vector<Leaf> leaves;
+  char type = 'F'; // default type in TTree
+  size_t offset = 0;
+  for (const auto& token : tokens) {
+    Leaf leaf;
+    auto nameAndDimensions = token.substr(0, token.find('/'));
+    if (auto typePosition = token.find('/'); typePosition != std::string::npos && typePosition + 1 < token.size()) {
+      type = token[typePosition + 1];
+    }
+    leaf.type = type;
+    leaf.offset = offset;
+    leaf.name = nameAndDimensions.substr(0, nameAndDimensions.find('['));
+
+    size_t position = leaf.name.size();
+    while (position < nameAndDimensions.size() && nameAndDimensions[position] == '[') {
+      auto end = nameAndDimensions.find(']', position);
+      auto dimension = nameAndDimensions.substr(position + 1, end == std::string::npos ? std::string::npos : end - position - 1);
+      if (end == std::string::npos || dimension.empty() || !std::all_of(dimension.begin(), dimension.end(), ::isdigit)) {
+        return leaves; // variable size array, we do not know where the next leaves are
+      }
+      leaf.dimensions.push_back(std::stoul(dimension));
+      position = end + 1;
+    }
+
+    auto typeSize = getLeafTypeSize(type);
+    if (typeSize == 0 || type == 'C') {
+      return leaves; // strings have variable length
+    }
+    size_t length = 1;
+    for (auto dimension : leaf.dimensions) {
+      length *= dimension;
+    }
+    offset += typeSize * length;
+    leaves.push_back(leaf);
+  }
+  return leaves;
+}
+
+} // namespace
+
+TrendStore::TrendStore(std::string name, size_t chunkSize)
+  : mName(std::move(name)), mChunkSize(chunkSize)
+{
+  mTree = createTree(mName);
+  // without chunks, the tail is the complete trend, thus we do not keep a second copy of it
+  if (mChunkSize > 0) {
+    mTail = createTree(mName);
+  }
+}
+
+void TrendStore::addBranch(const std::string& name, void* address, const std::string& leafList)
+{
+  if (getEntries() > 0 || mNumberOfSealedChunks > 0) {
+    throw std::runtime_error("Cannot add the branch '" + name + "' to the trend '" + mName + "' which already has entries");
+  }
+  mBranches.push_back({ name, address, leafList });
+  mTree->Branch(name.c_str(), address, leafList.c_str());
+  if (mTail != nullptr) {
+    mTail->Branch(name.c_str(), address, leafList.c_str());
+  }
+
+  auto leaves = parseLeafList(leafList);
+  const bool singleLeaf = leafList.find(':') == std::string::npos;
+  for (const auto& leaf : leaves) {
+    std::vector<std::string> prefixes{ name + "." + leaf.name };
+    if (singleLeaf) {
+      prefixes.push_back(name);
+    }
+    size_t length = 1;
+    for (auto dimension : leaf.dimensions) {
+      length *= dimension;
+    }
+    for (size_t element = 0; element < length; element++) {
+      // array elements are named like in TTree::Draw, e.g. "source.leaf[1][4]"
+      std::string indices;
+      for (size_t remainder = element, d = leaf.dimensions.size(); d-- > 0;) {
+        indices.insert(0, "[" + std::to_string(remainder % leaf.dimensions[d]) + "]");
+        remainder /= leaf.dimensions[d];
+      }
+      const size_t index = mColumns.size();
+      mColumnSources.push_back({ static_cast<const char*>(address) + leaf.offset + element * getLeafTypeSize(leaf.type), leaf.type });
+      mColumns.emplace_back();
+      for (const auto& prefix : prefixes) {
+        mColumnIndices.emplace(prefix + indices, index);
+      }
+    }
+  }
+}
+
+std::unique_ptr<TTree> TrendStore::createTree(const std::string& name) const
+{
+  auto tree = std::make_unique<TTree>();
+  tree->SetName(name.c_str());
+  for (const auto& branch : mBranches) {
+    tree->Branch(branch.name.c_str(), branch.address, branch.leafList.c_str());
+  }
+  return tree;
+}
+
+void TrendStore::appendColumns()
+{
+  for (size_t i = 0; i < mColumns.size(); i++) {
+    mColumns[i].push_back(readLeafValue(mColumnSources[i].address, mColumnSources[i].type));
+  }
+}
+
+void TrendStore::fill()
+{
+  if (mChunkSize > 0 && static_cast<size_t>(mTail->GetEntries()) >= mChunkSize) {
+    mTail->ResetBranchAddresses();
+    mTail->SetName(getChunkName(mName, mNumberOfSealedChunks).c_str());
+    mNewlySealedChunks.push_back(std::move(mTail));
+    mNumberOfSealedChunks++;
+    mTail = createTree(mName);
+  }
+  mTree->Fill();
+  if (mTail != nullptr) {
+    mTail->Fill();
+  }
+  appendColumns();
+}
+
+void TrendStore::reset()
+{
+  mTree->Reset();
+  if (mTail != nullptr) {
+    mTail->Reset();
+  }
+  mNewlySealedChunks.clear();
+  mNumberOfSealedChunks = 0;
+  for (auto& column : mColumns) {
+    column.clear();
+  }
+}
+
+void TrendStore::loadEntries(TTree& source, bool asNewEntries)
+{
+  for (const auto& branch : mBranches) {
+    source.SetBranchAddress(branch.name.c_str(), branch.address);
+  }
+  for (Long64_t entry = 0; entry < source.GetEntries(); entry++) {
+    source.GetEntry(entry);
+    if (asNewEntries) {
+      fill();
+    } else {
+      mTree->Fill();
+      appendColumns();
+    }
+  }
+  source.ResetBranchAddresses();
+}
+
+void TrendStore::loadSealedChunk(TTree& chunk)
+{
+  loadEntries(chunk, false);
+  mNumberOfSealedChunks++;
+}
+
+void TrendStore::loadTail(TTree& tail)
+{
+  loadEntries(tail, true);
+}
+
+Long64_t TrendStore::getEntries() const
+{
+  return mTree->GetEntries();
+}
+
+std::vector<std::unique_ptr<TTree>> TrendStore::takeNewlySealedChunks()
+{
+  auto chunks = std::move(mNewlySealedChunks);
+  mNewlySealedChunks.clear();
+  return chunks;
+}
+
+std::optional<std::span<const double>> TrendStore::getColumn(std::string_view name) const
+{
+  auto index = mColumnIndices.find(boost::algorithm::trim_copy(std::string(name)));
+  if (index == mColumnIndices.end()) {
+    return std::nullopt;
+  }
+  return std::span<const double>(mColumns[index->second]);
+}
+
+std::string TrendStore::getChunkName(const std::string& trendName, size_t index)
+{
+  return trendName + "_chunk" + std::to_string(index);
+}
+
+} // namespace o2::quality_control::postprocessing
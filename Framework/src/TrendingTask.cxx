@@ -22,28 +22,41 @@
 #include "QualityControl/RootClassFactory.h"
 #include "QualityControl/RepoPathUtils.h"
 #include "QualityControl/ActivityHelpers.h"
+#include "QualityControl/TrendPlotHelpers.h"
 
 #include <TH1.h>
 #include <TCanvas.h>
+#include <TDirectory.h>
 #include <TPaveText.h>
 #include <TGraphErrors.h>
 #include <TPoint.h>
 #include <TStyle.h>
 #include <TLegend.h>
+#include <Monitoring/Monitoring.h>
 
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <set>
 
 using namespace o2::quality_control;
 using namespace o2::quality_control::core;
 using namespace o2::quality_control::postprocessing;
+using namespace o2::monitoring;
 
 void TrendingTask::configure(const boost::property_tree::ptree& config)
 {
   // we clear any existing objects, which would be there only in case of reconfiguration
   // at the time of writing, this not even supported by ECS
   mReductors.clear();
+  mIncrementalPlots.clear();
   mTrend.reset();
+  mPublishedTail = nullptr;
+  mSealedChunks.clear();
+  mPrefetchedTrigger.reset();
+  mPrefetchedInputs.clear();
+  mRetrievalPool.reset();
 
   // configuration
   mConfig = TrendingTaskConfig(getID(), config);
@@ -91,54 +104,91 @@ bool TrendingTask::canContinueTrend(TTree* tree)
 
 void TrendingTask::initializeTrend(o2::quality_control::repository::DatabaseInterface& qcdb)
 {
-  // tree exists and we can reuse it
-  if (canContinueTrend(mTrend.get())) {
+  // trend exists and we can reuse it
+  if (mTrend != nullptr) {
     if (mConfig.resumeTrend == false) {
-      mTrend->Reset();
+      mTrend->reset();
     } else {
       ILOG(Info, Support) << "Will continue the trend from the previous run." << ENDM;
     }
     return;
   }
 
-  // tree is not reusable or does not exist => if we want to reuse the latest, we look for it in QCDB
-  mTrend.reset();
+  mTrend = std::make_unique<TrendStore>(PostProcessingInterface::getName(), mConfig.trendChunkSize);
+  mTrend->addBranch("meta", &mMetaData, mMetaData.getBranchLeafList());
+  mTrend->addBranch("time", &mTime, "time/i");
+  for (const auto& [sourceName, reductor] : mReductors) {
+    mTrend->addBranch(sourceName, reductor->getBranchAddress(), reductor->getBranchLeafList());
+  }
+
+  // if we want to reuse the latest trend, we look for it in QCDB
   if (mConfig.resumeTrend) {
     ILOG(Info, Support) << "Trying to retrieve an existing TTree for this task to continue the trend." << ENDM;
-    auto path = RepoPathUtils::getMoPath(mConfig.detectorName, PostProcessingInterface::getName(), "", "", false);
-    auto mo = qcdb.retrieveMO(path, PostProcessingInterface::getName(), repository::DatabaseInterface::Timestamp::Latest);
-    if (mo && mo->getObject()) {
-      auto tree = dynamic_cast<TTree*>(mo->getObject());
-      if (tree) {
-        mTrend = std::unique_ptr<TTree>(tree);
-        mo->setIsOwner(false);
-      }
-    } else {
-      ILOG(Warning, Support) << "Could not retrieve an existing TTree for this task" << ENDM;
-    }
-    if (canContinueTrend(mTrend.get())) {
-      mTrend->SetBranchAddress("meta", &mMetaData);
-      mTrend->SetBranchAddress("time", &mTime);
-      for (const auto& [sourceName, reductor] : mReductors) {
-        mTrend->SetBranchAddress(sourceName.c_str(), reductor->getBranchAddress());
-      }
+    if (loadStoredTrend(qcdb)) {
       ILOG(Info, Support) << "Will use the latest TTree from QCDB for this task to continue the trend." << ENDM;
-      return;
     } else {
-      mTrend.reset();
+      mTrend->reset();
     }
   }
+}
 
-  // we could not reuse the tree or never had one => we create a new one
-  if (mTrend == nullptr) {
-    mTrend = std::make_unique<TTree>();
-    mTrend->SetName(PostProcessingInterface::getName().c_str());
+bool TrendingTask::loadStoredTrend(repository::DatabaseInterface& qcdb)
+{
+  auto path = RepoPathUtils::getMoPath(mConfig.detectorName, PostProcessingInterface::getName(), "", "", false);
+  auto tailMO = qcdb.retrieveMO(path, PostProcessingInterface::getName(), repository::DatabaseInterface::Timestamp::Latest);
+  auto tail = tailMO ? dynamic_cast<TTree*>(tailMO->getObject()) : nullptr;
+  if (tail == nullptr) {
+    ILOG(Warning, Support) << "Could not retrieve an existing TTree for this task" << ENDM;
+    return false;
+  }
+  if (!canContinueTrend(tail)) {
+    return false;
+  }
 
-    mTrend->Branch("meta", &mMetaData, mMetaData.getBranchLeafList());
-    mTrend->Branch("time", &mTime);
-    for (const auto& [sourceName, reductor] : mReductors) {
-      mTrend->Branch(sourceName.c_str(), reductor->getBranchAddress(), reductor->getBranchLeafList());
+  // trends stored as a single TTree do not have this metadata, they are split into chunks when loaded
+  size_t sealedChunks = 0;
+  if (auto it = tailMO->getMetadataMap().find(TrendStore::SealedChunksMetadataKey); it != tailMO->getMetadataMap().end()) {
+    sealedChunks = std::strtoul(it->second.c_str(), nullptr, 10);
+  }
+  for (size_t index = 0; index < sealedChunks; index++) {
+    const auto chunkName = TrendStore::getChunkName(PostProcessingInterface::getName(), index);
+    auto chunkMO = qcdb.retrieveMO(path, chunkName, repository::DatabaseInterface::Timestamp::Latest);
+    auto chunk = chunkMO ? dynamic_cast<TTree*>(chunkMO->getObject()) : nullptr;
+    if (chunk == nullptr || !canContinueTrend(chunk)) {
+      ILOG(Warning, Support) << "Could not retrieve the chunk '" << chunkName << "' of the existing trend, thus a new trend will be created" << ENDM;
+      return false;
     }
+    mTrend->loadSealedChunk(*chunk);
+  }
+  mTrend->loadTail(*tail);
+  return true;
+}
+
+void TrendingTask::publishTail(PublicationPolicy policy)
+{
+  mPublishedTail = mTrend->getTail();
+  getObjectsManager()->startPublishing(mPublishedTail, policy);
+  getObjectsManager()->addOrUpdateMetadata(PostProcessingInterface::getName(), TrendStore::SealedChunksMetadataKey,
+                                           std::to_string(mTrend->getNumberOfSealedChunks()));
+}
+
+void TrendingTask::publishSealedChunks()
+{
+  // the chunks published before are not needed anymore once they have been stored
+  std::erase_if(mSealedChunks, [this](const auto& chunk) { return !getObjectsManager()->isBeingPublished(chunk->GetName()); });
+
+  auto newlySealedChunks = mTrend->takeNewlySealedChunks();
+  if (newlySealedChunks.empty()) {
+    return;
+  }
+  // the tail has been replaced, we publish the new one instead
+  if (mPublishedTail != nullptr) {
+    getObjectsManager()->stopPublishing(mPublishedTail);
+    publishTail(mConfig.producePlotsOnUpdate ? PublicationPolicy::ThroughStop : PublicationPolicy::Forever);
+  }
+  for (auto& chunk : newlySealedChunks) {
+    getObjectsManager()->startPublishing(chunk.get(), PublicationPolicy::Once);
+    mSealedChunks.push_back(std::move(chunk));
   }
 }
 
@@ -179,13 +229,24 @@ void TrendingTask::applyStyleToGraph(TGraph* graph, const TrendingTaskConfig::Gr
 void TrendingTask::initialize(Trigger, framework::ServiceRegistryRef services)
 {
   // removing leftovers from any previous runs
+  mIncrementalPlots.clear();
   mPlots.clear();
+  mPrefetchedTrigger.reset();
+  mPrefetchedInputs.clear();
+
+  auto& qcdb = services.get<repository::DatabaseInterface>();
+  if (mRetrievalPool == nullptr) {
+    mRetrievalPool = std::make_unique<repository::RetrievalPool>(qcdb, mConfig.parallelRetrievals);
+  }
 
-  initializeTrend(services.get<repository::DatabaseInterface>());
+  initializeTrend(qcdb);
 
+  mPublishedTail = nullptr;
   if (mConfig.producePlotsOnUpdate) {
-    getObjectsManager()->startPublishing(mTrend.get(), PublicationPolicy::ThroughStop);
+    publishTail(PublicationPolicy::ThroughStop);
   }
+  // a trend stored as a single TTree is split into chunks when resumed
+  publishSealedChunks();
 }
 
 // todo: see if OptimizeBaskets() indeed helps after some time
@@ -202,41 +263,183 @@ void TrendingTask::update(Trigger t, framework::ServiceRegistryRef services)
 void TrendingTask::finalize(Trigger, framework::ServiceRegistryRef)
 {
   if (!mConfig.producePlotsOnUpdate) {
-    getObjectsManager()->startPublishing(mTrend.get());
+    publishTail(PublicationPolicy::Forever);
   }
   generatePlots();
 }
 
-bool TrendingTask::trendValues(const Trigger& t, repository::DatabaseInterface& qcdb)
+void TrendingTask::backfill(const std::vector<Trigger>& triggers, framework::ServiceRegistryRef services, size_t workers)
+{
+  auto& qcdb = services.get<repository::DatabaseInterface>();
+  const bool allFromRepository = std::all_of(mConfig.dataSources.begin(), mConfig.dataSources.end(), [](const auto& dataSource) {
+    return reductor_helpers::isRepositoryDataSourceType(dataSource.type);
+  });
+
+  // each worker retrieves with its own database and reduces with its own reductors,
+  // the reduced values are kept as entries of its own tree until they are appended to the trend in the triggers order
+  struct Worker {
+    std::unique_ptr<repository::DatabaseInterface> qcdb;
+    std::unordered_map<std::string, std::unique_ptr<Reductor>> reductors;
+    MetaData metaData;
+    UInt_t time = 0;
+    std::unique_ptr<TTree> entries;
+  };
+  std::vector<Worker> backfillWorkers(allFromRepository ? workers : 0);
+  for (auto& worker : backfillWorkers) {
+    worker.qcdb = qcdb.clone();
+    if (worker.qcdb == nullptr) {
+      backfillWorkers.clear();
+      break;
+    }
+  }
+  if (workers <= 1 || backfillWorkers.empty()) {
+    ILOG(Info, Support) << "The trend can be backfilled in parallel only with data sources from QCDB and a database which can be copied, "
+                        << "the triggers are processed one by one" << ENDM;
+    PostProcessingInterface::backfill(triggers, services, workers);
+    return;
+  }
+
+  for (auto& worker : backfillWorkers) {
+    TDirectory::TContext context(nullptr);
+    worker.entries = std::make_unique<TTree>("entries", "entries");
+    worker.entries->SetDirectory(nullptr);
+    worker.entries->Branch("meta", &worker.metaData, MetaData::getBranchLeafList());
+    worker.entries->Branch("time", &worker.time, "time/i");
+    for (const auto& source : mConfig.dataSources) {
+      auto& reductor = worker.reductors[source.name];
+      reductor.reset(root_class_factory::create<Reductor>(source.moduleName, source.reductorName));
+      reductor->setCustomConfig(source.reductorParameters);
+      worker.entries->Branch(source.name.c_str(), reductor->getBranchAddress(), reductor->getBranchLeafList());
+    }
+  }
+
+  struct Entry {
+    size_t worker = 0;
+    Long64_t index = -1;
+    bool allSourcesInvoked = false;
+  };
+  std::vector<Entry> entries(triggers.size());
+  processInParallel(triggers, workers, [&](size_t trigger, size_t workerIndex) {
+    auto& worker = backfillWorkers[workerIndex];
+    const auto& t = triggers[trigger];
+    setEntryTime(t, worker.time, worker.metaData);
+    bool allSourcesInvoked = true;
+    for (const auto& dataSource : mConfig.dataSources) {
+      auto input = reductor_helpers::retrieveReductorInput(t, dataSource, *worker.qcdb);
+      allSourcesInvoked &= reductor_helpers::updateReductorWithInput(worker.reductors.at(dataSource.name).get(), input.get());
+    }
+    worker.entries->Fill();
+    entries[trigger] = { workerIndex, worker.entries->GetEntries() - 1, allSourcesInvoked };
+    return allSourcesInvoked;
+  });
+
+  // the entries are read back directly into the branches of the trend
+  for (auto& worker : backfillWorkers) {
+    worker.entries->SetBranchAddress("meta", &mMetaData);
+    worker.entries->SetBranchAddress("time", &mTime);
+    for (const auto& [sourceName, reductor] : mReductors) {
+      worker.entries->SetBranchAddress(sourceName.c_str(), reductor->getBranchAddress());
+    }
+  }
+  for (const auto& entry : entries) {
+    if (mConfig.trendIfAllInputs && !entry.allSourcesInvoked) {
+      continue;
+    }
+    backfillWorkers[entry.worker].entries->GetEntry(entry.index);
+    mTrend->fill();
+  }
+  publishSealedChunks();
+  if (mConfig.producePlotsOnUpdate) {
+    generatePlots();
+  }
+}
+
+void TrendingTask::setEntryTime(const Trigger& t, UInt_t& time, MetaData& metaData) const
 {
   if (mConfig.trendingTimestamp == "trigger") {
     // ROOT expects seconds since epoch.
-    mTime = t.timestamp / 1000;
+    time = t.timestamp / 1000;
   } else if (mConfig.trendingTimestamp == "validFrom") {
-    mTime = t.activity.mValidity.getMin() / 1000;
+    time = t.activity.mValidity.getMin() / 1000;
   } else { // validUntil
-    mTime = t.activity.mValidity.getMax() / 1000;
+    time = t.activity.mValidity.getMax() / 1000;
+  }
+  metaData.runNumber = t.activity.mId;
+  std::snprintf(metaData.runNumberStr, MaxRunNumberStringLength + 1, "%d", t.activity.mId);
+}
+
+bool TrendingTask::trendValues(const Trigger& t, repository::DatabaseInterface& qcdb)
+{
+  setEntryTime(t, mTime, mMetaData);
+
+  if (mRetrievalPool == nullptr) {
+    mRetrievalPool = std::make_unique<repository::RetrievalPool>(qcdb, mConfig.parallelRetrievals);
+  }
+  ReductorInputs inputs;
+  if (mPrefetchedTrigger.has_value() && mPrefetchedTrigger->timestamp == t.timestamp && mPrefetchedTrigger->activity == t.activity && mPrefetchedTrigger->metadata == t.metadata) {
+    inputs = std::move(mPrefetchedInputs);
+  } else {
+    inputs = retrieveInputs(t);
+  }
+  mPrefetchedTrigger.reset();
+  mPrefetchedInputs.clear();
+  // if we already know the next trigger (e.g. when iterating over existing objects), we start retrieving its inputs
+  // while the current ones are reduced
+  if (t.next != nullptr && mRetrievalPool->getParallelism() > 1) {
+    mPrefetchedInputs = retrieveInputs(*t.next);
+    mPrefetchedTrigger = *t.next;
   }
-  mMetaData.runNumber = t.activity.mId;
-  std::snprintf(mMetaData.runNumberStr, MaxRunNumberStringLength + 1, "%d", t.activity.mId);
 
   bool wereAllSourcesInvoked = true;
+  auto reportFailure = [&wereAllSourcesInvoked](const TrendingTaskConfig::DataSource& dataSource) {
+    wereAllSourcesInvoked = false;
+    ILOG(Error, Support) << "Failed to update reductor for data sources with path '" << dataSource.path
+                         << "', name '" << dataSource.name
+                         << "', type '" << dataSource.type << "'." << ENDM;
+  };
+
+  std::vector<const TrendingTaskConfig::DataSource*> pendingDataSources;
+  std::vector<std::shared_future<std::shared_ptr<TObject>>> pendingInputs;
   for (auto& dataSource : mConfig.dataSources) {
-    if (!reductor_helpers::updateReductor(mReductors[dataSource.name].get(), t, dataSource, qcdb, *this)) {
-      wereAllSourcesInvoked = false;
-      ILOG(Error, Support) << "Failed to update reductor for data sources with path '" << dataSource.path
-                           << "', name '" << dataSource.name
-                           << "', type '" << dataSource.type << "'." << ENDM;
+    if (reductor_helpers::isRepositoryDataSourceType(dataSource.type)) {
+      pendingDataSources.push_back(&dataSource);
+      pendingInputs.push_back(inputs.at(dataSource.name));
+    } else if (!reductor_helpers::updateReductor(mReductors[dataSource.name].get(), t, dataSource, qcdb, *this)) {
+      reportFailure(dataSource);
     }
   }
+  // we reduce the objects in the order they arrive
+  while (!pendingInputs.empty()) {
+    const size_t ready = mRetrievalPool->waitForAny(pendingInputs);
+    const auto& dataSource = *pendingDataSources[ready];
+    if (!reductor_helpers::updateReductorWithInput(mReductors[dataSource.name].get(), pendingInputs[ready].get().get())) {
+      reportFailure(dataSource);
+    }
+    pendingDataSources.erase(pendingDataSources.begin() + ready);
+    pendingInputs.erase(pendingInputs.begin() + ready);
+  }
 
   if (!mConfig.trendIfAllInputs || wereAllSourcesInvoked) {
-    mTrend->Fill();
+    mTrend->fill();
+    publishSealedChunks();
   }
 
   return wereAllSourcesInvoked;
 }
 
+TrendingTask::ReductorInputs TrendingTask::retrieveInputs(const Trigger& t)
+{
+  ReductorInputs inputs;
+  for (const auto& dataSource : mConfig.dataSources) {
+    if (reductor_helpers::isRepositoryDataSourceType(dataSource.type)) {
+      inputs.emplace(dataSource.name, mRetrievalPool->submit([t, dataSource](repository::DatabaseInterface& qcdb) {
+        return reductor_helpers::retrieveReductorInput(t, dataSource, qcdb);
+      }));
+    }
+  }
+  return inputs;
+}
+
 void TrendingTask::setUserAxesLabels(TAxis* xAxis, TAxis* yAxis, const std::string& graphAxesLabels)
 {
   // todo if we keep adding this method to pp classes we should move it up somewhere
@@ -289,23 +492,166 @@ void TrendingTask::generatePlots()
     return;
   }
 
-  if (mTrend->GetEntries() < 1) {
+  if (mTrend->getEntries() < 1) {
     ILOG(Info, Support) << "No entries in the trend so far, won't generate any plots." << ENDM;
     return;
   }
 
   ILOG(Info, Support) << "Generating " << mConfig.plots.size() << " plots." << ENDM;
+  const auto start = std::chrono::steady_clock::now();
+  size_t appendedPlots = 0;
   for (const auto& plotConfig : mConfig.plots) {
+    if (mConfig.incrementalPlots && appendToPlot(plotConfig)) {
+      appendedPlots++;
+      getObjectsManager()->startPublishing(mPlots[plotConfig.name].get(), PublicationPolicy::Once);
+      continue;
+    }
 
     // Before we generate any new plots, we have to delete existing under the same names.
     // It seems that ROOT cannot handle an existence of two canvases with a common name in the same process.
+    mIncrementalPlots.erase(plotConfig.name);
     if (mPlots.count(plotConfig.name)) {
       mPlots[plotConfig.name].reset();
     }
     auto c = drawPlot(plotConfig);
     mPlots[plotConfig.name].reset(c);
+    if (mConfig.incrementalPlots && !prepareIncrementalPlot(plotConfig, c)) {
+      ILOG(Debug, Devel) << "The plot '" << plotConfig.name << "' cannot be updated incrementally, it will be drawn again at each update" << ENDM;
+    }
     getObjectsManager()->startPublishing(c, PublicationPolicy::Once);
   }
+
+  const double durationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  ILOG(Debug, Devel) << "Plotting took " << durationMs << " ms, " << appendedPlots << " plot(s) updated incrementally" << ENDM;
+  if (mMonitoring) {
+    mMonitoring->send(Metric{ "qc_trending_plotting" }
+                        .addValue(durationMs, "duration_ms")
+                        .addValue(static_cast<uint64_t>(mConfig.plots.size() - appendedPlots), "redrawn_plots")
+                        .addValue(static_cast<uint64_t>(appendedPlots), "appended_plots")
+                        .addValue(static_cast<uint64_t>(mTrend->getEntries()), "trend_entries"));
+  }
+}
+
+std::optional<TrendingTask::CompiledExpression> TrendingTask::compileExpression(const std::string& expression)
+{
+  if (mTrend->getColumn(expression).has_value()) {
+    return CompiledExpression{ expression, nullptr };
+  }
+  auto formula = std::make_unique<TTreeFormula>("trendingFormula", expression.c_str(), mTrend->getTree());
+  // we support only expressions which give one value per entry, as arrays would produce several points
+  if (formula->GetNdim() == 0 || formula->GetMultiplicity() != 0) {
+    return std::nullopt;
+  }
+  return CompiledExpression{ "", std::move(formula) };
+}
+
+bool TrendingTask::prepareIncrementalPlot(const TrendingTaskConfig::Plot& plotConfig, TCanvas* canvas)
+{
+  IncrementalPlot plot;
+  for (const auto& graphConfig : plotConfig.graphs) {
+    auto expressions = trend_plot_helpers::splitVarexp(graphConfig.varexp);
+    if (expressions.size() != 2 || !isGraphOption(graphConfig.option)) {
+      return false;
+    }
+    IncrementalGraph graph;
+    graph.graph = dynamic_cast<TGraph*>(canvas->GetListOfPrimitives()->FindObject(graphConfig.name.c_str()));
+    if (graph.graph == nullptr) {
+      return false;
+    }
+    if (!graphConfig.errors.empty()) {
+      graph.errors = dynamic_cast<TGraphErrors*>(canvas->GetListOfPrimitives()->FindObject((graphConfig.name + "_errors").c_str()));
+      auto errorExpressions = trend_plot_helpers::splitVarexp(graphConfig.errors);
+      if (graph.errors == nullptr || errorExpressions.size() != 2) {
+        return false;
+      }
+      expressions.insert(expressions.end(), errorExpressions.begin(), errorExpressions.end());
+    }
+    for (const auto& expression : expressions) {
+      auto compiled = compileExpression(expression);
+      if (!compiled.has_value()) {
+        return false;
+      }
+      graph.expressions.push_back(std::move(compiled.value()));
+    }
+    if (!graphConfig.selection.empty()) {
+      graph.selection = std::make_unique<TTreeFormula>("trendingSelection", graphConfig.selection.c_str(), mTrend->getTree());
+      if (graph.selection->GetNdim() == 0 || graph.selection->GetMultiplicity() != 0) {
+        return false;
+      }
+    }
+    plot.graphs.push_back(std::move(graph));
+  }
+
+  // the axes are drawn either by the histogram of TTree::Draw, or by the first graph
+  plot.frame = dynamic_cast<TH1*>(canvas->GetListOfPrimitives()->FindObject("background"));
+  if (plot.frame == nullptr && !plot.graphs.empty()) {
+    plot.frame = plot.graphs.front().graph->GetHistogram();
+  }
+  plot.entries = mTrend->getEntries();
+  mIncrementalPlots[plotConfig.name] = std::move(plot);
+  return true;
+}
+
+bool TrendingTask::appendToPlot(const TrendingTaskConfig::Plot& plotConfig)
+{
+  auto incrementalPlot = mIncrementalPlots.find(plotConfig.name);
+  if (incrementalPlot == mIncrementalPlots.end() || mPlots.count(plotConfig.name) == 0) {
+    return false;
+  }
+  auto& plot = incrementalPlot->second;
+  const Long64_t entries = mTrend->getEntries();
+  if (entries < plot.entries) {
+    return false; // the trend has been reset
+  }
+
+  // we evaluate the new entries for all the graphs first, in case that the plot has to be drawn again anyway
+  TTree* tree = mTrend->getTree();
+  std::vector<std::vector<std::vector<double>>> newValues; // graph -> expression -> values
+  for (auto& graph : plot.graphs) {
+    std::vector<std::span<const double>> columns;
+    for (const auto& expression : graph.expressions) {
+      columns.push_back(expression.formula ? std::span<const double>{} : mTrend->getColumn(expression.column).value());
+    }
+    auto& values = newValues.emplace_back(graph.expressions.size());
+    for (Long64_t entry = plot.entries; entry < entries; entry++) {
+      tree->LoadTree(entry);
+      if (graph.selection && (graph.selection->GetNdata() < 1 || graph.selection->EvalInstance(0) == 0)) {
+        continue;
+      }
+      for (size_t i = 0; i < graph.expressions.size(); i++) {
+        auto& formula = graph.expressions[i].formula;
+        if (formula == nullptr) {
+          values[i].push_back(columns[i][entry]);
+        } else if (formula->GetNdata() > 0) {
+          values[i].push_back(formula->EvalInstance(0));
+        } else {
+          values[i].push_back(0);
+        }
+      }
+    }
+  }
+
+  // new points outside of the drawn axes require drawing the plot again with new ranges
+  const bool checkY = plotConfig.graphYRange.empty();
+  for (const auto& values : newValues) {
+    if (!trend_plot_helpers::fitInFrame(plot.frame, values[1], values[0], true, checkY)) {
+      return false;
+    }
+  }
+
+  for (size_t g = 0; g < plot.graphs.size(); g++) {
+    auto& graph = plot.graphs[g];
+    const auto& values = newValues[g];
+    trend_plot_helpers::appendPoints(graph.graph, values[1], values[0]);
+    if (graph.errors) {
+      trend_plot_helpers::appendPoints(graph.errors, values[1], values[0], values[2], values[3]);
+    }
+  }
+  plot.entries = entries;
+  if (auto canvas = dynamic_cast<TCanvas*>(mPlots[plotConfig.name].get())) {
+    canvas->Modified();
+  }
+  return true;
 }
 
 std::string TrendingTask::deduceGraphLegendOptions(const TrendingTaskConfig::Graph& graphConfig)
@@ -341,6 +687,57 @@ std::string TrendingTask::deduceGraphLegendOptions(const TrendingTaskConfig::Gra
   return out;
 }
 
+bool TrendingTask::isGraphOption(const std::string& option)
+{
+  // these are the rules used by TTree::Draw to decide whether 2-dimensional data is drawn as a graph or a histogram
+  const auto lowerCaseOption = boost::algorithm::to_lower_copy(option);
+  auto optionHas = [&](std::string_view seq) {
+    return lowerCaseOption.find(seq) != std::string::npos;
+  };
+  for (const auto& histogramOption : { "surf", "lego", "cont", "col", "hist", "scat", "box" }) {
+    if (optionHas(histogramOption)) {
+      return false;
+    }
+  }
+  return lowerCaseOption.empty() || optionHas("p") || optionHas("*") || optionHas("l");
+}
+
+std::optional<std::vector<std::span<const double>>> TrendingTask::getColumns(const std::string& varexp) const
+{
+  std::vector<std::span<const double>> columns;
+  for (const auto& expression : trend_plot_helpers::splitVarexp(varexp)) {
+    auto column = mTrend->getColumn(expression);
+    if (!column.has_value()) {
+      return std::nullopt;
+    }
+    columns.push_back(column.value());
+  }
+  return columns;
+}
+
+TGraph* TrendingTask::drawGraphFromColumns(const TrendingTaskConfig::Graph& graphConfig, const std::string& option, bool firstGraphInPlot) const
+{
+  if (!graphConfig.selection.empty() || !isGraphOption(graphConfig.option)) {
+    return nullptr;
+  }
+  auto columns = getColumns(graphConfig.varexp);
+  if (!columns.has_value() || columns->size() != 2) {
+    return nullptr;
+  }
+  // as in TTree::Draw, the first expression is drawn on the y axis
+  const auto& y = columns->at(0);
+  const auto& x = columns->at(1);
+  auto graph = new TGraph(static_cast<Int_t>(x.size()), x.data(), y.data());
+  graph->SetBit(kCanDelete);
+  // TTree::Draw would draw the axes with an additional histogram, here we let the first graph draw them
+  std::string drawOption = option;
+  if (firstGraphInPlot && boost::algorithm::to_lower_copy(option).find('a') == std::string::npos) {
+    drawOption = "A" + option;
+  }
+  graph->Draw(drawOption.c_str());
+  return graph;
+}
+
 TCanvas* TrendingTask::drawPlot(const TrendingTaskConfig::Plot& plotConfig)
 {
   auto* c = new TCanvas();
@@ -371,8 +768,8 @@ TCanvas* TrendingTask::drawPlot(const TrendingTaskConfig::Plot& plotConfig)
     gStyle->SetPalette(); // default
   }
 
-  // regardless whether we draw a graph or a histogram, a histogram is always used by TTree::Draw to draw axes and title
-  // we attempt to keep it to do some modifications later
+  // regardless whether we draw a graph or a histogram, a histogram is always used to draw axes and title,
+  // either the one of TTree::Draw or the one of the first graph. we attempt to keep it to do some modifications later
   TH1* background = nullptr;
   bool firstGraphInPlot = true;
   // by "graph" we consider anything we can draw, not necessarily TGraph, and we draw all on the same canvas
@@ -383,8 +780,19 @@ TCanvas* TrendingTask::drawPlot(const TrendingTaskConfig::Plot& plotConfig)
     // having "SAME" at the first TTree::Draw() call will not work, we have to add it only in subsequent Draw calls
     std::string option = firstGraphInPlot ? graphConfig.option : "SAME " + graphConfig.option;
 
-    // Draw main series
-    mTrend->Draw(graphConfig.varexp.c_str(), graphConfig.selection.c_str(), option.c_str());
+    // Draw main series. Graphs of one column versus another are built directly out of the stored values,
+    // while anything else is evaluated with TTree::Draw.
+    TTree* tree = mTrend->getTree();
+    TGraph* graph = drawGraphFromColumns(graphConfig, option, firstGraphInPlot);
+    if (graph != nullptr) {
+      // there is no htemp histogram in such case, the axes and title are drawn by the graph
+      if (!background) {
+        background = graph->GetHistogram();
+      }
+    } else {
+      tree->Draw(graphConfig.varexp.c_str(), graphConfig.selection.c_str(), option.c_str());
+      graph = dynamic_cast<TGraph*>(c->FindObject("Graph"));
+    }
 
     // For graphs, we allow to draw errors if they are specified.
     TGraphErrors* graphErrors = nullptr;
@@ -394,9 +802,14 @@ TCanvas* TrendingTask::drawPlot(const TrendingTaskConfig::Plot& plotConfig)
       } else {
         // We generate some 4-D points, where 2 dimensions represent graph points and 2 others are the error bars
         std::string varexpWithErrors(graphConfig.varexp + ":" + graphConfig.errors);
-        mTrend->Draw(varexpWithErrors.c_str(), graphConfig.selection.c_str(), "goff");
-        graphErrors = new TGraphErrors(mTrend->GetSelectedRows(), mTrend->GetVal(1), mTrend->GetVal(0),
-                                       mTrend->GetVal(2), mTrend->GetVal(3));
+        if (auto columns = getColumns(varexpWithErrors); columns.has_value() && graphConfig.selection.empty()) {
+          graphErrors = new TGraphErrors(static_cast<Int_t>(columns->at(0).size()), columns->at(1).data(), columns->at(0).data(),
+                                         columns->at(2).data(), columns->at(3).data());
+        } else {
+          tree->Draw(varexpWithErrors.c_str(), graphConfig.selection.c_str(), "goff");
+          graphErrors = new TGraphErrors(tree->GetSelectedRows(), tree->GetVal(1), tree->GetVal(0),
+                                         tree->GetVal(2), tree->GetVal(3));
+        }
         graphErrors->SetName((graphConfig.name + "_errors").c_str());
         graphErrors->SetTitle((graphConfig.title + " errors").c_str());
         // We draw on the same plotConfig as the main graphConfig, but only error bars
@@ -405,7 +818,7 @@ TCanvas* TrendingTask::drawPlot(const TrendingTaskConfig::Plot& plotConfig)
     }
 
     // Legend entry and styling for graphs
-    if (auto graph = dynamic_cast<TGraph*>(c->FindObject("Graph"))) {
+    if (graph) {
       if (plotOrder >= 2) {
         // Style objects after Draw so we override palette/auto styling when requested
         applyStyleToGraph(graph, graphConfig.style);
@@ -26,7 +26,10 @@ TrendingTaskConfig::TrendingTaskConfig(std::string id, const boost::property_tre
   producePlotsOnUpdate = config.get<bool>("qc.postprocessing." + id + ".producePlotsOnUpdate", true);
   resumeTrend = config.get<bool>("qc.postprocessing." + id + ".resumeTrend", false);
   trendIfAllInputs = config.get<bool>("qc.postprocessing." + id + ".trendIfAllInputs", false);
+  incrementalPlots = config.get<bool>("qc.postprocessing." + id + ".incrementalPlots", false);
   trendingTimestamp = config.get<std::string>("qc.postprocessing." + id + ".trendingTimestamp", "validUntil");
+  parallelRetrievals = config.get<size_t>("qc.postprocessing." + id + ".parallelRetrievals", 1);
+  trendChunkSize = config.get<size_t>("qc.postprocessing." + id + ".trendChunkSize", 0);
 
   for (const auto& [_, plotConfig] : config.get_child("qc.postprocessing." + id + ".plots")) {
     // since QC-1155 we allow for more than one graph in a single plot (canvas). we support both the new and old ways
@@ -0,0 +1,218 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   TriggerQueue.cxx
+///
+
+#include "QualityControl/TriggerQueue.h"
+
+#include <algorithm>
+
+using namespace std::chrono;
+
+namespace o2::quality_control::postprocessing
+{
+
+TriggerQueue::TriggerQueue()
+  : TriggerQueue(Backoff{})
+{
+}
+
+TriggerQueue::TriggerQueue(Backoff backoff)
+  : mBackoff(backoff)
+{
+  mThread = std::thread([this]() { evaluationLoop(); });
+}
+
+TriggerQueue::~TriggerQueue()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mWakeUpEvaluation.notify_all();
+  mTriggerReady.notify_all();
+  if (mThread.joinable()) {
+    mThread.join();
+  }
+}
+
+void TriggerQueue::setTriggers(Group group, std::vector<TriggerFcn> triggerFcns)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto replaced = std::stable_partition(mEntries.begin(), mEntries.end(), [group](const auto& entry) { return entry->group != group; });
+    std::for_each(replaced, mEntries.end(), [](const auto& entry) { entry->removed = true; });
+    mEntries.erase(replaced, mEntries.end());
+
+    const auto now = Clock::now();
+    for (auto& triggerFcn : triggerFcns) {
+      auto entry = std::make_shared<Entry>();
+      entry->fcn = std::move(triggerFcn);
+      entry->group = group;
+      entry->backoff = mBackoff.initial;
+      entry->nextEvaluation = now;
+      mEntries.push_back(std::move(entry));
+    }
+  }
+  mWakeUpEvaluation.notify_all();
+}
+
+void TriggerQueue::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  for (const auto& entry : mEntries) {
+    entry->removed = true;
+  }
+  mEntries.clear();
+  mError = nullptr;
+}
+
+Trigger TriggerQueue::take(Group group, milliseconds timeout)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  std::shared_ptr<Entry> first;
+  auto isReady = [&]() {
+    first.reset();
+    for (const auto& entry : mEntries) {
+      if (entry->group == group && entry->ready.has_value() && (first == nullptr || entry->readySince < first->readySince)) {
+        first = entry;
+      }
+    }
+    return first != nullptr || mError != nullptr || mStopping;
+  };
+  if (!isReady() && timeout.count() > 0) {
+    mTriggerReady.wait_for(lock, timeout, isReady);
+  }
+
+  if (mError != nullptr) {
+    auto error = mError;
+    mError = nullptr;
+    std::rethrow_exception(error);
+  }
+  if (first == nullptr) {
+    return { TriggerType::No };
+  }
+
+  Trigger trigger = std::move(first->ready.value());
+  first->ready.reset();
+  const double waitingSeconds = duration_cast<duration<double>>(Clock::now() - first->readySince).count();
+  mStats.taken++;
+  mStats.waitingSeconds += waitingSeconds;
+  mStats.maxWaitingSeconds = std::max(mStats.maxWaitingSeconds, waitingSeconds);
+
+  if (first->last) {
+    erase(first);
+  } else {
+    // the following trigger might be already known, we do not wait to find out
+    first->nextEvaluation = Clock::now();
+    mWakeUpEvaluation.notify_all();
+  }
+  return trigger;
+}
+
+bool TriggerQueue::waitForAny(milliseconds timeout)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  return mTriggerReady.wait_for(lock, timeout, [this]() {
+    return mError != nullptr || std::any_of(mEntries.begin(), mEntries.end(), [](const auto& entry) { return entry->ready.has_value(); });
+  });
+}
+
+bool TriggerQueue::isExhausted(Group group) const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return std::none_of(mEntries.begin(), mEntries.end(), [group](const auto& entry) { return entry->group == group; });
+}
+
+TriggerQueue::Stats TriggerQueue::getStats() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mStats;
+}
+
+void TriggerQueue::evaluationLoop()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (!mStopping) {
+    // an error is reported before evaluating anything else
+    std::shared_ptr<Entry> next;
+    if (mError == nullptr) {
+      for (const auto& entry : mEntries) {
+        if (!entry->ready.has_value() && (next == nullptr || entry->nextEvaluation < next->nextEvaluation)) {
+          next = entry;
+        }
+      }
+    }
+
+    if (next == nullptr) {
+      mWakeUpEvaluation.wait(lock);
+    } else if (next->nextEvaluation > Clock::now()) {
+      mWakeUpEvaluation.wait_until(lock, next->nextEvaluation);
+    } else {
+      evaluate(next, lock);
+    }
+  }
+}
+
+void TriggerQueue::evaluate(const std::shared_ptr<Entry>& entry, std::unique_lock<std::mutex>& lock)
+{
+  // the trigger functions may block, so the other threads can take triggers or replace them in the meantime
+  lock.unlock();
+  std::optional<Trigger> trigger;
+  std::exception_ptr error;
+  const auto start = Clock::now();
+  try {
+    trigger.emplace(entry->fcn());
+  } catch (...) {
+    error = std::current_exception();
+  }
+  const auto end = Clock::now();
+  lock.lock();
+
+  const double evaluationSeconds = duration_cast<duration<double>>(end - start).count();
+  mStats.evaluations++;
+  mStats.evaluationSeconds += evaluationSeconds;
+  mStats.maxEvaluationSeconds = std::max(mStats.maxEvaluationSeconds, evaluationSeconds);
+
+  if (entry->removed) {
+    return;
+  }
+  if (error != nullptr) {
+    mError = error;
+    erase(entry);
+    mTriggerReady.notify_all();
+    return;
+  }
+
+  entry->last = trigger->last;
+  if (*trigger) {
+    mStats.fired++;
+    entry->ready = std::move(trigger);
+    entry->readySince = end;
+    entry->backoff = mBackoff.initial;
+    mTriggerReady.notify_all();
+  } else if (entry->last) {
+    erase(entry);
+  } else {
+    entry->nextEvaluation = end + entry->backoff;
+    entry->backoff = std::min(entry->backoff * 2, mBackoff.max);
+  }
+}
+
+void TriggerQueue::erase(const std::shared_ptr<Entry>& entry)
+{
+  entry->removed = true;
+  mEntries.erase(std::remove(mEntries.begin(), mEntries.end(), entry), mEntries.end());
+}
+
+} // namespace o2::quality_control::postprocessing
@@ -17,11 +17,10 @@
 #include "QualityControl/Triggers.h"
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/ActivityHelpers.h"
-#include "QualityControl/CcdbDatabase.h"
+#include "QualityControl/ListingPoller.h"
 #include "QualityControl/ObjectMetadataKeys.h"
 #include "QualityControl/KafkaPoller.h"
 
-#include <CCDB/CcdbApi.h>
 #include <Common/Timer.h>
 #include <chrono>
 #include <ostream>
@@ -191,59 +190,27 @@ TriggerFcn Periodic(double seconds, const Activity& activity, std::string config
 
 TriggerFcn NewObject(const std::string& databaseUrl, const std::string& databaseType, const std::string& objectPath, const Activity& activity, const std::string& config)
 {
-  // Key names in the header map.
-  constexpr auto timestampKey = metadata_keys::validFrom;
   auto fullObjectPath = (databaseType == "qcdb" ? activity.mProvenance + "/" : "") + objectPath;
   auto metadata = databaseType == "qcdb" ? activity_helpers::asDatabaseMetadata(activity, false) : std::map<std::string, std::string>();
   auto objectActivity = activity;
 
   ILOG(Debug, Support) << "Initializing newObject trigger for the object '" << fullObjectPath << "' and Activity '" << activity << "'" << ENDM;
   // We support only CCDB here.
-  auto db = std::make_shared<repository::CcdbDatabase>();
-  db->connect(databaseUrl, "", "", "");
-
-  // Returns "Valid-From" of an object if there is a new one, otherwise 0.
-  auto newObjectValidity = [db, fullObjectPath, metadata, databaseUrl, activity, lastModified = validity_time_t{ 0 }]() mutable -> ValidityInterval {
-    const auto listing = db->getListingAsPtree(fullObjectPath, metadata, true);
-    if (listing.count("objects") == 0) {
-      ILOG(Warning, Support) << "Could not get a valid listing from db '" << databaseUrl << "' for object '" << fullObjectPath << "'" << ENDM;
-      return gInvalidValidityInterval;
-    }
-    const auto& objects = listing.get_child("objects");
-    if (objects.empty()) {
-      // We don't make a fuss over it, because we might be just waiting for the first version of such object.
-      // Apparently it happens always for a few iterations at SOR, so Warnings might be too annoying.
-      ILOG(Debug, Devel) << "Could not find the file '" << fullObjectPath << "' in the db '"
-                         << databaseUrl << "' for given Activity settings (" << activity << "). Zeroes and empty strings are treated as wildcards." << ENDM;
-      return gInvalidValidityInterval;
-    } else if (objects.size() > 1) {
-      ILOG(Warning, Support) << "Expected just one metadata entry for object '" << fullObjectPath << "'. Trying to continue by using the first." << ENDM;
-    }
-
-    const auto& object = objects.front().second;
-    validity_time_t newLastModified = object.get<uint64_t>(metadata_keys::lastModified, 0);
-    if (newLastModified > lastModified) {
-      lastModified = newLastModified;
-      return { object.get<uint64_t>(metadata_keys::validFrom, 0), object.get<uint64_t>(metadata_keys::validUntil) };
-    }
-    return gInvalidValidityInterval;
-  };
-  // we execute it once before in order to know about the latest existing object.
-  newObjectValidity();
-
-  return [objectActivity, config, newObjectValidity]() mutable -> Trigger {
-    if (auto validity = newObjectValidity(); validity.isValid()) {
-      if (getenv("QC_DISABLE_NEWOBJECT_DELAY") == nullptr) {
-        // On rare occasions we might run into the following race condition:
-        // 1) A CheckRunner starts to publish a collection of MOs for a QC Task
-        // 2) A PostProcessing task receives a newobject trigger for a just-published object
-        // 3) The PP task tries to retrieve also other objects normally published by the same QC task, it fails
-        //    because not all were published yet.
-        // 4) The CheckRunner finishes publishing the collection of MOs
-        // To avoid this scenario, a small delay is added before returning the trigger. Considerations about other
-        // possible solutions are included in the commit message.
-        std::this_thread::sleep_for(std::chrono::seconds{ 1 });
-      }
+  // The poller is shared by all the triggers in the process, it lists each directory once for all the objects inside.
+  // Subscribing takes note of the latest existing object, so that it is not reported as a new one.
+  auto poller = ListingPoller::getInstance(databaseUrl);
+  auto subscription = poller->subscribe(fullObjectPath, metadata);
+
+  return [objectActivity, config, poller, subscription]() mutable -> Trigger {
+    // On rare occasions we might run into the following race condition:
+    // 1) A CheckRunner starts to publish a collection of MOs for a QC Task
+    // 2) A PostProcessing task receives a newobject trigger for a just-published object
+    // 3) The PP task tries to retrieve also other objects normally published by the same QC task, it fails
+    //    because not all were published yet.
+    // 4) The CheckRunner finishes publishing the collection of MOs
+    // To avoid this scenario, the poller reports a new object only once the other objects of the same directory
+    // reached the same cycle, or the directory stopped changing.
+    if (auto validity = poller->poll(*subscription); validity.isValid()) {
       objectActivity.mValidity = validity;
       auto timestamp = activity_helpers::isLegacyValidity(validity) ? validity.getMin() : (validity.getMax() - 1);
       return { TriggerType::NewObject, false, objectActivity, timestamp, config };
@@ -260,10 +227,8 @@ TriggerFcn ForEachObject(const std::string& databaseUrl, const std::string& data
   auto fullObjectPath = (databaseType == "qcdb" ? activity.mProvenance + "/" : "") + objectPath;
 
   // We support only CCDB here.
-  auto db = std::make_shared<repository::CcdbDatabase>();
-  db->connect(databaseUrl, "", "", "");
-
-  auto objects = db->getListingAsPtree(fullObjectPath).get_child("objects");
+  // Triggers of other tasks in the process which iterate over the same path share the listing.
+  auto objects = ListingPoller::getInstance(databaseUrl)->getFullListing(fullObjectPath).get_child("objects");
   ILOG(Info, Support) << "Got " << objects.size() << " objects for the path '" << fullObjectPath << "'" << ENDM;
   auto filteredObjects = std::make_shared<std::vector<boost::property_tree::ptree>>();
   const auto filter = databaseType == "qcdb" ? activity : Activity();
@@ -288,13 +253,21 @@ TriggerFcn ForEachObject(const std::string& databaseUrl, const std::string& data
               return a.get<int64_t>(timestampSortKey) < b.get<int64_t>(timestampSortKey);
             });
 
-  return [filteredObjects, activity, currentObject = filteredObjects->begin(), config]() mutable -> Trigger {
-    if (currentObject != filteredObjects->end()) {
-      auto currentActivity = activity_helpers::asActivity(*currentObject, activity.mProvenance);
-      bool last = currentObject + 1 == filteredObjects->end();
-      Trigger trigger(TriggerType::ForEachObject, last, currentActivity, currentObject->get<int64_t>(timestampSortKey));
-      if (auto cycle = currentObject->get_optional<std::string>(metadata_keys::cycleNumber); cycle.has_value()) {
-        trigger.metadata.emplace(metadata_keys::cycleNumber, cycle.value());
+  auto makeTrigger = [filteredObjects, activity](std::vector<boost::property_tree::ptree>::const_iterator object) {
+    auto currentActivity = activity_helpers::asActivity(*object, activity.mProvenance);
+    bool last = object + 1 == filteredObjects->cend();
+    Trigger trigger(TriggerType::ForEachObject, last, currentActivity, object->get<int64_t>(timestampSortKey));
+    if (auto cycle = object->get_optional<std::string>(metadata_keys::cycleNumber); cycle.has_value()) {
+      trigger.metadata.emplace(metadata_keys::cycleNumber, cycle.value());
+    }
+    return trigger;
+  };
+
+  return [filteredObjects, activity, makeTrigger, currentObject = filteredObjects->cbegin(), config]() mutable -> Trigger {
+    if (currentObject != filteredObjects->cend()) {
+      Trigger trigger = makeTrigger(currentObject);
+      if (currentObject + 1 != filteredObjects->cend()) {
+        trigger.next = std::make_shared<const Trigger>(makeTrigger(currentObject + 1));
       }
       ++currentObject;
 
@@ -312,10 +285,8 @@ TriggerFcn ForEachLatest(const std::string& databaseUrl, const std::string& data
   auto fullObjectPath = (databaseType == "qcdb" ? activity.mProvenance + "/" : "") + objectPath;
 
   // We support only CCDB here.
-  auto db = std::make_shared<repository::CcdbDatabase>();
-  db->connect(databaseUrl, "", "", "");
-
-  auto objects = db->getListingAsPtree(fullObjectPath).get_child("objects");
+  // Triggers of other tasks in the process which iterate over the same path share the listing.
+  auto objects = ListingPoller::getInstance(databaseUrl)->getFullListing(fullObjectPath).get_child("objects");
   ILOG(Info, Support) << "Got " << objects.size() << " objects for the path '" << fullObjectPath << "'" << ENDM;
   auto filteredObjects = std::make_shared<std::vector<std::pair<Activity, boost::property_tree::ptree>>>();
   const auto filter = databaseType == "qcdb" ? activity : Activity();
@@ -361,6 +332,10 @@ TriggerFcn ForEachLatest(const std::string& databaseUrl, const std::string& data
       const auto& currentPtree = currentObject->second;
       bool last = currentObject + 1 == filteredObjects->end();
       Trigger trigger(TriggerType::ForEachLatest, last, currentActivity, currentPtree.get<int64_t>(metadata_keys::validFrom), config);
+      if (!last) {
+        const auto& [nextActivity, nextPtree] = *(currentObject + 1);
+        trigger.next = std::make_shared<const Trigger>(TriggerType::ForEachLatest, currentObject + 2 == filteredObjects->end(), nextActivity, nextPtree.get<int64_t>(metadata_keys::validFrom), config);
+      }
       ++currentObject;
       return trigger;
     } else {
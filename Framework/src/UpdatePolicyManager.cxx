@@ -14,6 +14,7 @@
 /// \author Barthelemy von Haller
 ///
 
+#include <algorithm>
 #include <utility>
 
 #include "QualityControl/UpdatePolicyManager.h"
@@ -36,6 +37,8 @@ void UpdatePolicyManager::updateGlobalRevision()
     for (auto& actor : mPoliciesByActor) {
       updateActorRevision(actor.second.actorName, 0);
     }
+    // the objects updated before the overflow have now higher revisions than the actors
+    markAllActorsAsCandidates();
   }
 }
 
@@ -45,7 +48,12 @@ void UpdatePolicyManager::updateActorRevision(const std::string& actorName, Revi
     ILOG(Error, Support) << "Cannot update revision for " << actorName << " : object not found" << ENDM;
     BOOST_THROW_EXCEPTION(ObjectNotFoundError() << errinfo_object_name(actorName));
   }
-  mPoliciesByActor.at(actorName).revision = revision;
+  auto& policy = mPoliciesByActor.at(actorName);
+  policy.revision = revision;
+  if (!policy.dependsOnAnyObject && revision == mGlobalRevision) {
+    // it cannot become ready until one of its objects is updated
+    mCandidateActors.erase(actorName);
+  }
 }
 
 void UpdatePolicyManager::updateActorRevision(const std::string& actorName)
@@ -56,6 +64,9 @@ void UpdatePolicyManager::updateActorRevision(const std::string& actorName)
 void UpdatePolicyManager::updateObjectRevision(const std::string& objectName, RevisionType revision)
 {
   mObjectsRevision[objectName] = revision;
+  if (auto actors = mActorsByObject.find(objectName); actors != mActorsByObject.end()) {
+    mCandidateActors.insert(actors->second.begin(), actors->second.end());
+  }
 }
 
 void UpdatePolicyManager::updateObjectRevision(const std::string& objectName)
@@ -175,9 +186,50 @@ void UpdatePolicyManager::addPolicy(const std::string& actorName, UpdatePolicyTy
     }
   }
 
-  mPoliciesByActor[actorName] = { actorName, isReadyFunction, std::move(objectNames), allObjects, policyHelper };
+  bool dependsOnAnyObject = policyType == UpdatePolicyType::OnGlobalAny || (policyType == UpdatePolicyType::OnEachSeparately && allObjects);
+  auto [policy, _] = mPoliciesByActor.insert_or_assign(actorName, UpdatePolicy{ actorName, isReadyFunction, std::move(objectNames), allObjects, policyHelper, 0, dependsOnAnyObject });
+  std::string_view indexedActorName = policy->first;
+
+  // Index the actor by its objects. Some policies ignore the trailing slash of object names, so we add both variants.
+  for (const auto& objectName : policy->second.inputObjects) {
+    std::string_view withoutSlash{ objectName };
+    if (withoutSlash.ends_with('/')) {
+      withoutSlash.remove_suffix(1);
+    }
+    for (auto indexedObjectName : { std::string_view{ objectName }, withoutSlash }) {
+      auto& actors = mActorsByObject[std::string{ indexedObjectName }];
+      if (std::find(actors.begin(), actors.end(), indexedActorName) == actors.end()) {
+        actors.push_back(indexedActorName);
+      }
+    }
+  }
+  // a new actor might be ready with the objects received so far, while the ones depending on any object are always evaluated
+  mCandidateActors.insert(indexedActorName);
+
+  ILOG(Info, Devel) << "Added a policy : " << policy->second << ENDM;
+}
 
-  ILOG(Info, Devel) << "Added a policy : " << mPoliciesByActor[actorName] << ENDM;
+std::vector<std::string> UpdatePolicyManager::getReadyActors()
+{
+  std::vector<std::string> readyActors;
+  for (auto actorName = mCandidateActors.begin(); actorName != mCandidateActors.end();) {
+    if (mPoliciesByActor.find(*actorName)->second.isReady()) {
+      // it stays a candidate until it is triggered
+      readyActors.emplace_back(*actorName);
+      ++actorName;
+    } else {
+      // it cannot become ready until one of its objects is updated
+      actorName = mCandidateActors.erase(actorName);
+    }
+  }
+  return readyActors;
+}
+
+void UpdatePolicyManager::markAllActorsAsCandidates()
+{
+  for (const auto& [actorName, policy] : mPoliciesByActor) {
+    mCandidateActors.insert(actorName);
+  }
 }
 
 bool UpdatePolicyManager::isReady(const std::string& actorName)
@@ -204,6 +256,8 @@ std::ostream& operator<<(std::ostream& out, const UpdatePolicy& updatePolicy) //
 
 void UpdatePolicyManager::reset()
 {
+  mCandidateActors.clear();
+  mActorsByObject.clear();
   mPoliciesByActor.clear();
   mObjectsRevision.clear();
   mGlobalRevision = 1;
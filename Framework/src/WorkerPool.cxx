@@ -0,0 +1,112 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   WorkerPool.cxx
+///
+
+#include "QualityControl/WorkerPool.h"
+
+namespace o2::quality_control::core
+{
+
+WorkerPool::WorkerPool(size_t workers)
+{
+  for (size_t worker = 1; worker < workers; worker++) {
+    mThreads.emplace_back([this, worker]() { workerLoop(worker); });
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mStartCondition.notify_all();
+  for (auto& thread : mThreads) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+void WorkerPool::run(size_t nItems, const Work& work)
+{
+  if (nItems == 0) {
+    return;
+  }
+  if (mThreads.empty() || nItems == 1) {
+    for (size_t item = 0; item < nItems; item++) {
+      work(item, 0);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mWork = &work;
+    mNumberOfItems = nItems;
+    mNextItem = 0;
+    mException = nullptr;
+    mBusyWorkers = mThreads.size();
+    mGeneration++;
+  }
+  mStartCondition.notify_all();
+
+  process(0);
+
+  std::unique_lock<std::mutex> lock(mMutex);
+  mDoneCondition.wait(lock, [this]() { return mBusyWorkers == 0; });
+  mWork = nullptr;
+  if (mException) {
+    std::rethrow_exception(mException);
+  }
+}
+
+void WorkerPool::workerLoop(size_t worker)
+{
+  size_t lastGeneration = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mStartCondition.wait(lock, [&]() { return mStopping || mGeneration != lastGeneration; });
+      if (mStopping) {
+        return;
+      }
+      lastGeneration = mGeneration;
+    }
+    process(worker);
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (--mBusyWorkers == 0) {
+        mDoneCondition.notify_all();
+      }
+    }
+  }
+}
+
+void WorkerPool::process(size_t worker)
+{
+  for (size_t item = mNextItem++; item < mNumberOfItems; item = mNextItem++) {
+    try {
+      (*mWork)(item, worker);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (!mException) {
+        mException = std::current_exception();
+      }
+      mNextItem = mNumberOfItems; // the other workers stop after their current item
+    }
+  }
+}
+
+} // namespace o2::quality_control::core
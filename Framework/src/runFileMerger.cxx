@@ -22,12 +22,22 @@
 #include <unordered_map>
 #include <fstream>
 #include <filesystem>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <future>
+#include <mutex>
+#include <thread>
 #include <boost/program_options.hpp>
 #include <boost/exception/diagnostic_information.hpp>
 #include <TFile.h>
 #include <TKey.h>
 #include <TGrid.h>
+#include <TROOT.h>
 #include <variant>
+#include <sys/resource.h>
+#include <unistd.h>
 
 namespace bpo = boost::program_options;
 using namespace o2::quality_control::core;
@@ -48,6 +58,210 @@ struct Node {
   std::string getFullPath() const { return pathTo + std::filesystem::path::preferred_separator + name; }
 };
 
+using ErrorHandler = std::function<void(const std::string&)>;
+
+namespace
+{
+
+struct MergingProgress {
+  std::atomic<size_t> filesRead = 0;
+  std::atomic<size_t> filesFailed = 0;
+  std::atomic<size_t> bytesRead = 0;
+  std::atomic<size_t> spills = 0;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
+
+constexpr size_t MB = 1024 * 1024;
+
+// the resident set size of this process in bytes, 0 if it could not be read
+size_t getCurrentRSS()
+{
+  std::ifstream statm("/proc/self/statm");
+  size_t totalPages = 0, residentPages = 0;
+  if (!(statm >> totalPages >> residentPages)) {
+    return 0;
+  }
+  return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+// the peak resident set size of this process in bytes
+size_t getPeakRSS()
+{
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<size_t>(usage.ru_maxrss) * 1024; // kilobytes on Linux
+}
+
+void reportProgress(const MergingProgress& progress, size_t totalFiles)
+{
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - progress.start).count();
+  const size_t done = progress.filesRead + progress.filesFailed;
+  ILOG(Info, Support) << "Processed " << done << "/" << totalFiles << " files (" << progress.filesFailed << " failed), read "
+                      << progress.bytesRead / MB << " MB in " << static_cast<size_t>(seconds) << " s ("
+                      << (seconds > 0 ? done / seconds : 0.) << " files/s, "
+                      << (seconds > 0 ? progress.bytesRead / MB / seconds : 0.) << " MB/s), RSS "
+                      << getCurrentRSS() / MB << " MB, peak RSS " << getPeakRSS() / MB << " MB, "
+                      << progress.spills << " early writes to the output file" << ENDM;
+}
+
+void deleteRecursively(Node& node)
+{
+  for (auto& [name, value] : node.children) {
+    std::visit(overloaded{
+                 [](Node& child) { deleteRecursively(child); },
+                 [](MonitorObjectCollection* moc) { delete moc; } },
+               value);
+  }
+  node.children.clear();
+}
+
+// Merges the contents of the source into the target. Source is left empty.
+void mergeNodes(Node& target, Node& source, const ErrorHandler& handleError)
+{
+  for (auto& [name, value] : source.children) {
+    auto targetChild = target.children.find(name);
+    if (targetChild == target.children.end()) {
+      if (std::holds_alternative<Node>(value)) {
+        // the path of the subdirectories stays the same, only the ownership changes
+        target.children.emplace(name, std::move(std::get<Node>(value)));
+      } else {
+        target.children.emplace(name, std::get<MonitorObjectCollection*>(value));
+      }
+      continue;
+    }
+
+    if (std::holds_alternative<Node>(value) && std::holds_alternative<Node>(targetChild->second)) {
+      mergeNodes(std::get<Node>(targetChild->second), std::get<Node>(value), handleError);
+    } else if (std::holds_alternative<MonitorObjectCollection*>(value) && std::holds_alternative<MonitorObjectCollection*>(targetChild->second)) {
+      auto sourceMOC = std::get<MonitorObjectCollection*>(value);
+      try {
+        std::get<MonitorObjectCollection*>(targetChild->second)->merge(sourceMOC);
+      } catch (...) {
+        handleError("Failed to merge the Monitor Object Collection. Exception caught: " + boost::current_exception_diagnostic_information(true));
+      }
+      delete sourceMOC;
+    } else {
+      handleError("'" + source.getFullPath() + "/" + name + "' is a directory in one input and a MonitorObjectCollection in another, skipping.");
+      std::visit(overloaded{
+                   [](Node& child) { deleteRecursively(child); },
+                   [](MonitorObjectCollection* moc) { delete moc; } },
+                 value);
+    }
+  }
+  source.children.clear();
+}
+
+// Merges the contents of the file into the memory node. Returns the uncompressed size of the objects which were not
+// present in the memory node yet, as an estimate of how much the memory node has grown.
+size_t mergeRecursively(TDirectory* fileNode, Node& memoryNode, const std::vector<std::string>& excludedDirectories, const ErrorHandler& handleError)
+{
+  if (fileNode == nullptr) {
+    ILOG(Error) << "Provided parentNode pointer is null, skipping." << ENDM;
+    return 0;
+  }
+  size_t addedSize = 0;
+  TIter next(fileNode->GetListOfKeys());
+  TKey* key;
+  while ((key = (TKey*)next())) {
+    // we look for exact matches here. we skip if there are no subdirectories
+    if (std::find(excludedDirectories.begin(), excludedDirectories.end(), key->GetName()) != excludedDirectories.end()) {
+      ILOG(Info, Support) << "Skipping '" << key->GetName() << "' as requested in the input arguments" << ENDM;
+      continue;
+    }
+    // we check if we have to skip any subdirectories wrt where we are
+    std::vector<std::string> excludedSubdirectories;
+    for (const auto& excludedDirectory : excludedDirectories) {
+      auto match = std::string(key->GetName()) + '/';
+      if (excludedDirectory.find(match) == 0) {
+        if (excludedDirectory.size() < match.size()) {
+          ILOG(Warning, Support) << "Invalid exclusion path '" << excludedDirectory << "'" << ENDM;
+          continue;
+        }
+        excludedSubdirectories.push_back(excludedDirectory.substr(match.size()));
+      }
+    }
+
+    ILOG(Debug, Devel) << "Getting the value for key '" << key->GetName() << "'" << ENDM;
+    auto* value = fileNode->Get(key->GetName());
+    if (value == nullptr) {
+      ILOG(Error) << "Could not get the value '" << key->GetName() << "', skipping." << ENDM;
+      continue;
+    }
+    if (auto inputMOC = dynamic_cast<MonitorObjectCollection*>(value)) {
+      inputMOC->postDeserialization();
+      if (memoryNode.children.count(inputMOC->GetName())) {
+        try {
+          std::get<MonitorObjectCollection*>(memoryNode.children[inputMOC->GetName()])->merge(inputMOC);
+        } catch (...) {
+          handleError("Failed to merge the Monitor Object Collection. Exception caught: " + boost::current_exception_diagnostic_information(true));
+        }
+        delete inputMOC;
+      } else {
+        memoryNode.children[inputMOC->GetName()] = inputMOC;
+        addedSize += key->GetObjlen();
+      }
+    } else if (auto dir = dynamic_cast<TDirectory*>(value)) {
+      auto name = dir->GetName();
+      if (memoryNode.children.count(name) == 0) {
+        memoryNode.children[name] = Node{ memoryNode.getFullPath(), name };
+      }
+      addedSize += mergeRecursively(dir, std::get<Node>(memoryNode.children[name]), excludedSubdirectories, handleError);
+    } else {
+      handleError("Could not cast the node to MonitorObjectCollection nor TDirectory.");
+      delete value;
+      continue;
+    }
+  }
+  return addedSize;
+}
+
+// Stores the objects in the output file, merging them with the ones which are already there. The node is left empty.
+void storeRecursively(TDirectory* fout, Node& memoryNode, const ErrorHandler& handleError)
+{
+  for (auto& [name, value] : memoryNode.children) {
+    std::visit(overloaded{
+                 [&](Node& node) {
+                   auto* dir = fout->GetDirectory(node.name.c_str());
+                   if (dir == nullptr) {
+                     fout->mkdir(node.name.c_str());
+                   }
+                   dir = fout->GetDirectory(node.name.c_str());
+                   if (dir == nullptr) {
+                     handleError("Could not create directory '" + node.name + "' in path '" + node.pathTo + "'");
+                     deleteRecursively(node);
+                   } else {
+                     storeRecursively(dir, node, handleError);
+                   }
+                 },
+                 [&](MonitorObjectCollection* moc) {
+                   // the output file might contain results of previous runs of the merger or objects written early
+                   if (auto mergedTObj = fout->Get(moc->GetName())) {
+                     auto mergedMOC = dynamic_cast<MonitorObjectCollection*>(mergedTObj);
+                     if (mergedMOC == nullptr) {
+                       handleError("Could not cast the merged object to MonitorObjectCollection, skipping.");
+                       delete mergedTObj;
+                       delete moc;
+                       return;
+                     }
+                     mergedMOC->postDeserialization();
+                     try {
+                       mergedMOC->merge(moc);
+                     } catch (...) {
+                       handleError("Failed to merge the Monitor Object Collection. Exception caught: " + boost::current_exception_diagnostic_information(true));
+                     }
+                     delete moc;
+                     moc = mergedMOC;
+                   }
+                   fout->WriteObject(moc, moc->GetName(), "Overwrite");
+                   delete moc;
+                 } },
+               value);
+  }
+  memoryNode.children.clear();
+}
+
+} // namespace
+
 int main(int argc, const char* argv[])
 {
   size_t filesRead = 0;
@@ -60,7 +274,10 @@ int main(int argc, const char* argv[])
       ("output-file", bpo::value<std::string>()->default_value("merged.root"), "File path to store the merged results, if the file exists, it will be merged with new files.") //
       ("input-files-list", bpo::value<std::string>()->default_value(""), "Path to a file containing a list of input files (row by row)")                                       //
       ("input-files", bpo::value<std::vector<std::string>>()->multitoken(), "Space-separated file paths which should be merged.")                                              //
-      ("exclude-directories", bpo::value<std::vector<std::string>>()->multitoken(), "Space-separated directories which should be excluded when merging files.");
+      ("exclude-directories", bpo::value<std::vector<std::string>>()->multitoken(), "Space-separated directories which should be excluded when merging files.")                  //
+      ("threads", bpo::value<size_t>()->default_value(1), "Number of threads which read and merge the input files, 0 means the number of available cores.")                    //
+      ("max-memory", bpo::value<size_t>()->default_value(0), "Size (MB) of the partial results above which they are written to the output file to free memory, 0 means no limit.") //
+      ("progress-interval", bpo::value<size_t>()->default_value(10), "Period (seconds) of the progress reports.");
 
     bpo::variables_map vm;
     store(bpo::command_line_parser(argc, argv).options(desc).run(), vm);
@@ -113,12 +330,12 @@ int main(int argc, const char* argv[])
       ILOG(Info, Support) << ENDM;
     }
 
-    auto handleError = vm["exit-on-error"].as<bool>()
-                         ? [](const std::string& message) { throw std::runtime_error(message); }
-                         : [](const std::string& message) { ILOG(Error, Support) << message << ENDM; };
+    const ErrorHandler handleError = vm["exit-on-error"].as<bool>()
+                                       ? ErrorHandler([](const std::string& message) { throw std::runtime_error(message); })
+                                       : ErrorHandler([](const std::string& message) { ILOG(Error, Support) << message << ENDM; });
 
     auto outputFilePath = vm["output-file"].as<std::string>();
-    auto outputFile = new TFile(outputFilePath.c_str(), "UPDATE");
+    auto outputFile = std::make_unique<TFile>(outputFilePath.c_str(), "UPDATE");
     if (outputFile->IsZombie()) {
       throw std::runtime_error("File '" + outputFilePath + "' is zombie.");
     }
@@ -130,138 +347,116 @@ int main(int argc, const char* argv[])
     }
     ILOG(Debug) << "Output file '" << outputFilePath << "' successfully open." << ENDM;
 
+    size_t threads = vm["threads"].as<size_t>();
+    if (threads == 0) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::max<size_t>(1, std::min(threads, inputFilePaths.size()));
+    if (threads > 1) {
+      ROOT::EnableThreadSafety();
+    }
+    const size_t maxMemory = vm["max-memory"].as<size_t>() * MB;
+    const auto progressInterval = std::chrono::seconds(std::max<size_t>(1, vm["progress-interval"].as<size_t>()));
+    ILOG(Info, Support) << "Merging " << inputFilePaths.size() << " files with " << threads << " thread(s)" << ENDM;
+
     // Unlike in RootFileSink and RootFileSource, where we assume that the latter only supports the output of the first,
     // here we have more relaxed assumptions and try to recursively merge everything, regardless of the directory structure.
     // This is because we might have to change the structure again when we support moving windows, so we might save some work
     // in the future.
-    // We choose to keep the merged file structure in memory and merge everything we can before storing in a file.
-    // If this becomes too memory-hungry, it could be rewritten to store anything merge immediately at the cost of
-    // more I/O operations.
-    Node mergedTree;
-    for (const auto& inputFilePath : inputFilePaths) {
-      auto* file = TFile::Open(inputFilePath.c_str(), "READ");
-      if (file == nullptr) {
-        handleError("File handler for '" + inputFilePath + "' is nullptr.");
-        continue;
-      }
-      if (file->IsZombie()) {
-        handleError("File '" + inputFilePath + "' is zombie.");
-        continue;
-      }
-      if (!file->IsOpen()) {
-        handleError("Failed to open the file: " + inputFilePath);
-        continue;
-      }
-      ILOG(Debug) << "Input file '" << inputFilePath << "' successfully open." << ENDM;
-
-      std::function<void(TDirectory*, Node&, const std::vector<std::string>&)> mergeRecursively;
-      mergeRecursively = [&](TDirectory* fileNode, Node& memoryNode, const std::vector<std::string>& excludedDirectories = {}) {
-        if (fileNode == nullptr) {
-          ILOG(Error) << "Provided parentNode pointer is null, skipping." << ENDM;
-          return;
+    // Each thread takes the next input file from the list and merges it into its own partial result kept in memory.
+    // The size of a partial result is estimated as the uncompressed size of the distinct objects it holds. If it
+    // exceeds the share of the memory limit of its thread, the thread writes its partial result to the output file
+    // (merging with anything which is already there) and starts a new one. We do not use the resident memory of the
+    // process, because it rarely shrinks after freeing objects, so the threads would write after every file.
+    // At the end, the partial results are merged pairwise and the final result is merged with the content of the
+    // output file. With a memory limit, they are instead written one after another to the output file, so that the
+    // memory usage only decreases.
+    MergingProgress progress;
+    std::atomic<size_t> nextFile = 0;
+    std::mutex outputFileMutex;
+    const size_t maxPartialResultSize = maxMemory / threads;
+    auto mergeFilesFromList = [&](Node& partialResult) {
+      size_t partialResultSize = 0;
+      for (size_t i = nextFile++; i < inputFilePaths.size(); i = nextFile++) {
+        const auto& inputFilePath = inputFilePaths[i];
+        std::unique_ptr<TFile> file(TFile::Open(inputFilePath.c_str(), "READ"));
+        if (file == nullptr) {
+          progress.filesFailed++;
+          handleError("File handler for '" + inputFilePath + "' is nullptr.");
+          continue;
         }
-        TIter next(fileNode->GetListOfKeys());
-        TKey* key;
-        while ((key = (TKey*)next())) {
-          // we look for exact matches here. we skip if there are no subdirectories
-          if (std::find(excludedDirectories.begin(), excludedDirectories.end(), key->GetName()) != excludedDirectories.end()) {
-            ILOG(Info, Support) << "Skipping '" << key->GetName() << "' as requested in the input arguments" << ENDM;
-            continue;
-          }
-          // we check if we have to skip any subdirectories wrt where we are
-          std::vector<std::string> excludedSubdirectories;
-          for (const auto& excludedDirectory : excludedDirectories) {
-            auto match = std::string(key->GetName()) + '/';
-            if (excludedDirectory.find(match) == 0) {
-              if (excludedDirectory.size() < match.size()) {
-                ILOG(Warning, Support) << "Invalid exclusion path '" << excludedDirectory << "'" << ENDM;
-                continue;
-              }
-              excludedSubdirectories.push_back(excludedDirectory.substr(match.size()));
-            }
-          }
-
-          ILOG(Debug, Devel) << "Getting the value for key '" << key->GetName() << "'" << ENDM;
-          auto* value = fileNode->Get(key->GetName());
-          if (value == nullptr) {
-            ILOG(Error) << "Could not get the value '" << key->GetName() << "', skipping." << ENDM;
-            continue;
-          }
-          if (auto inputMOC = dynamic_cast<MonitorObjectCollection*>(value)) {
-            inputMOC->postDeserialization();
-
-            if (memoryNode.children.count(inputMOC->GetName()) == 0) {
-              std::string mocPath = memoryNode.getFullPath() + std::filesystem::path::preferred_separator + key->GetName();
-
-              auto mergedTObj = outputFile->Get(mocPath.c_str());
-              if (mergedTObj != nullptr) {
-                auto mergedMOC = dynamic_cast<MonitorObjectCollection*>(mergedTObj);
-                if (mergedMOC == nullptr) {
-                  handleError("Could not cast the merged object to MonitorObjectCollection, skipping.");
-                  delete mergedMOC;
-                  continue;
-                }
-                mergedMOC->postDeserialization();
-                memoryNode.children[mergedMOC->GetName()] = mergedMOC;
-                ILOG(Info) << "Read merged object '" << mergedMOC->GetName() << "'" << ENDM;
-              }
-            }
-
-            if (memoryNode.children.count(inputMOC->GetName())) {
-              try {
-                std::get<MonitorObjectCollection*>(memoryNode.children[inputMOC->GetName()])->merge(inputMOC);
-              } catch (...) {
-                handleError("Failed to merge the Monitor Object Collection. Exception caught: " + boost::current_exception_diagnostic_information(true));
-              }
-              delete inputMOC;
-            } else {
-              memoryNode.children[inputMOC->GetName()] = inputMOC;
-            }
-          } else if (auto dir = dynamic_cast<TDirectory*>(value)) {
-            auto name = dir->GetName();
-            if (memoryNode.children.count(name) == 0) {
-              memoryNode.children[name] = Node{ memoryNode.getFullPath(), name };
-            }
-            mergeRecursively(dir, std::get<Node>(memoryNode.children[name]), excludedSubdirectories);
-          } else {
-            handleError("Could not cast the node to MonitorObjectCollection nor TDirectory.");
-            delete value;
-            continue;
-          }
+        if (file->IsZombie() || !file->IsOpen()) {
+          progress.filesFailed++;
+          auto message = file->IsZombie() ? "File '" + inputFilePath + "' is zombie." : "Failed to open the file: " + inputFilePath;
+          file.reset();
+          handleError(message);
+          continue;
         }
-      };
+        ILOG(Debug) << "Input file '" << inputFilePath << "' successfully open." << ENDM;
 
-      mergeRecursively(file, mergedTree, excludedDirectories);
-      file->Close();
-      delete file;
-      filesRead++;
-    }
+        partialResultSize += mergeRecursively(file.get(), partialResult, excludedDirectories, handleError);
+        progress.bytesRead += file->GetBytesRead();
+        file->Close();
+        file.reset();
+        progress.filesRead++;
 
-    std::function<void(TDirectory*, const Node&)> storeRecursively;
-    storeRecursively = [&](TDirectory* fout, const Node& memoryNode) {
-      for (const auto& [name, value] : memoryNode.children) {
-        std::visit(overloaded{
-                     [&](const Node& node) {
-                       auto* dir = fout->GetDirectory(node.name.c_str());
-                       if (dir == nullptr) {
-                         fout->mkdir(node.name.c_str());
-                       }
-                       dir = fout->GetDirectory(node.name.c_str());
-                       if (dir == nullptr) {
-                         handleError("Could not create directory '" + node.name + "' in path '" + node.pathTo + "'");
-                       } else {
-                         storeRecursively(dir, node);
-                       }
-                     },
-                     [&](const MonitorObjectCollection* moc) {
-                       fout->WriteObject(moc, moc->GetName(), "Overwrite");
-                       delete moc;
-                     } },
-                   value);
+        if (maxMemory > 0 && partialResultSize > maxPartialResultSize) {
+          ILOG(Debug, Support) << "Partial results above the memory limit, writing them to the output file" << ENDM;
+          std::lock_guard lock(outputFileMutex);
+          storeRecursively(outputFile.get(), partialResult, handleError);
+          partialResult = Node{};
+          partialResultSize = 0;
+          progress.spills++;
+        }
+      }
+    };
+    auto mergeFiles = [&](Node& partialResult) {
+      try {
+        mergeFilesFromList(partialResult);
+      } catch (...) {
+        nextFile = inputFilePaths.size(); // the other threads should stop as well
+        throw;
       }
     };
-    storeRecursively(outputFile, mergedTree);
+
+    std::vector<Node> partialResults(threads);
+    std::vector<std::future<void>> workers;
+    for (auto& partialResult : partialResults) {
+      workers.push_back(std::async(std::launch::async, mergeFiles, std::ref(partialResult)));
+    }
+    for (auto& worker : workers) {
+      while (worker.wait_for(progressInterval) != std::future_status::ready) {
+        reportProgress(progress, inputFilePaths.size());
+      }
+    }
+    for (auto& worker : workers) {
+      worker.get(); // rethrows any exception of the workers
+    }
+
+    if (maxMemory > 0) {
+      // the pairwise merges would keep all the partial results in memory at the same time
+      for (auto& partialResult : partialResults) {
+        storeRecursively(outputFile.get(), partialResult, handleError);
+      }
+      partialResults.resize(1);
+    }
+    // tree reduction of the partial results, each round merges pairs of them in parallel
+    while (partialResults.size() > 1) {
+      const size_t half = (partialResults.size() + 1) / 2;
+      std::vector<std::future<void>> merges;
+      for (size_t i = half; i < partialResults.size(); i++) {
+        merges.push_back(std::async(std::launch::async, [&, i]() { mergeNodes(partialResults[i - half], partialResults[i], handleError); }));
+      }
+      for (auto& merge : merges) {
+        merge.get();
+      }
+      partialResults.resize(half);
+    }
+
+    storeRecursively(outputFile.get(), partialResults.front(), handleError);
     outputFile->Close();
+    filesRead = progress.filesRead;
+    reportProgress(progress, inputFilePaths.size());
 
   } catch (const bpo::error& ex) {
     ILOG(Error, Ops) << "Exception caught: " << ex.what() << ENDM;
@@ -90,6 +90,11 @@ int main(int argc, const char* argv[])
       Timer timer;
       timer.reset(periodUs);
       while (runner.run()) {
+        if (runner.hasTriggerQueue()) {
+          // we are woken up as soon as a trigger fires, the period only bounds the time between the checks of the runner
+          runner.waitForTrigger(std::chrono::milliseconds(periodUs / 1000));
+          continue;
+        }
         while (timer.getRemainingTime() < 0) {
           timer.increment();
         }
@@ -170,7 +170,12 @@ class PostProcessingOCCStateMachine : public RuntimeControlledObject
       mRateLimiter.increment();
     }
     if (double sleepForUs = 1000000.0 * mRateLimiter.getRemainingTime(); sleepForUs > 0) {
-      usleep(sleepForUs);
+      if (mRunner->hasTriggerQueue()) {
+        // we are woken up earlier if a trigger fires
+        mRunner->waitForTrigger(std::chrono::milliseconds(static_cast<long>(sleepForUs / 1000)));
+      } else {
+        usleep(sleepForUs);
+      }
     }
 
     return success ? !continueRunning : -1;
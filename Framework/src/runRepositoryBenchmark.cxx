@@ -24,7 +24,9 @@ void addCustomOptions(bpo::options_description& options)
   options.add_options()("number-objects", bpo::value<uint64_t>()->default_value(1),
                         "Number of objects to try to send to the CCDB every second (default : 1)")(
     "size-objects", bpo::value<uint64_t>()->default_value(1),
-    "Size of the objects to send (in kB, 1, 10, 100, 1000, default : 1)")(
+    "Size of the objects to send (in kB, 1, 10, 100, 500, 1000, 2500, 5000, 10000, 50000, default : 1)")(
+    "reuse-serialized", bpo::value<int>()->default_value(0),
+    "Serialize the objects once and upload the same payload in each iteration, only with CCDB (1:true, 0:false)")(
     "max-iterations", bpo::value<uint64_t>()->default_value(3),
     "Maximum number of iterations of Run/ConditionalRun/OnData (0 - infinite, default : 3)")(
     "number-tasks", bpo::value<uint64_t>()->default_value(0),
@@ -0,0 +1,136 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testAsyncDatabase.cxx
+///
+
+#include "QualityControl/AsyncDatabase.h"
+#include "QualityControl/DummyDatabase.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/QualityObject.h"
+
+#include <TH1F.h>
+#include <atomic>
+#include <mutex>
+#include <catch_amalgamated.hpp>
+
+using namespace o2::quality_control::core;
+using namespace o2::quality_control::repository;
+
+namespace
+{
+
+// records what it was asked to store, optionally blocking until it is released
+struct RecordingDatabase : public DummyDatabase {
+  struct Shared {
+    std::mutex mutex;
+    std::vector<std::string> storedTitles;
+    std::atomic<bool> blocked = false;
+  };
+
+  explicit RecordingDatabase(std::shared_ptr<Shared> shared) : mShared(std::move(shared)) {}
+
+  void storeMO(std::shared_ptr<const MonitorObject> mo) override
+  {
+    while (mShared->blocked) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::lock_guard<std::mutex> lock(mShared->mutex);
+    mShared->storedTitles.emplace_back(mo->getObject()->GetTitle());
+  }
+
+  void storeQO(std::shared_ptr<const QualityObject> qo) override
+  {
+    std::lock_guard<std::mutex> lock(mShared->mutex);
+    mShared->storedTitles.emplace_back(qo->getName());
+  }
+
+  std::shared_ptr<Shared> mShared;
+};
+
+std::shared_ptr<MonitorObject> makeMO(const std::string& name, const std::string& title)
+{
+  auto mo = std::make_shared<MonitorObject>(new TH1F(name.c_str(), title.c_str(), 10, 0, 10), "task", "class", "TST");
+  mo->setIsOwner(true);
+  return mo;
+}
+
+} // namespace
+
+TEST_CASE("async_database_stores_everything")
+{
+  auto shared = std::make_shared<RecordingDatabase::Shared>();
+  AsyncDatabase database([shared]() { return std::make_unique<RecordingDatabase>(shared); }, 2, 100);
+
+  for (int i = 0; i < 10; i++) {
+    database.storeMO(makeMO("histo" + std::to_string(i), "v0"));
+  }
+  database.storeQO(std::make_shared<QualityObject>(Quality::Good, "check"));
+  database.flush();
+
+  CHECK(shared->storedTitles.size() == 11);
+  auto stats = database.getAndResetStats();
+  CHECK(stats.stored == 11);
+  CHECK(stats.dropped == 0);
+  CHECK(stats.queueDepth == 0);
+  CHECK(database.getAndResetStats().stored == 0);
+}
+
+TEST_CASE("async_database_coalescing_and_dropping")
+{
+  auto shared = std::make_shared<RecordingDatabase::Shared>();
+  shared->blocked = true;
+  AsyncDatabase database([shared]() { return std::make_unique<RecordingDatabase>(shared); }, 1, 2);
+
+  // the worker takes the first object and gets stuck uploading it
+  database.storeMO(makeMO("first", "v0"));
+  while (database.getAndResetStats().queueDepth != 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // only the newest version of "histo" is kept
+  database.storeMO(makeMO("histo", "v1"));
+  database.storeMO(makeMO("histo", "v2"));
+  database.storeMO(makeMO("other", "v1"));
+  // the queue is full, "histo" is the oldest and gets dropped
+  database.storeMO(makeMO("third", "v1"));
+
+  auto stats = database.getAndResetStats();
+  CHECK(stats.coalesced == 1);
+  CHECK(stats.dropped == 1);
+  CHECK(stats.queueDepth == 2);
+
+  shared->blocked = false;
+  database.flush();
+  CHECK(shared->storedTitles == std::vector<std::string>{ "v0", "v1", "v1" });
+}
+
+TEST_CASE("async_database_uploads_snapshots")
+{
+  auto shared = std::make_shared<RecordingDatabase::Shared>();
+  shared->blocked = true;
+  AsyncDatabase database([shared]() { return std::make_unique<RecordingDatabase>(shared); }, 1, 10);
+
+  // the objects are modified after being stored, e.g. by the beautification of the next Checks
+  auto owning = makeMO("owning", "v0");
+  TH1F histogram("nonOwning", "v0", 10, 0, 10);
+  auto nonOwning = std::make_shared<MonitorObject>(&histogram, "task", "class", "TST");
+  nonOwning->setIsOwner(false);
+  database.storeMO(owning);
+  database.storeMO(nonOwning);
+  owning->getObject()->SetTitle("v1");
+  histogram.SetTitle("v1");
+
+  shared->blocked = false;
+  database.flush();
+  CHECK(shared->storedTitles == std::vector<std::string>{ "v0", "v0" });
+}
@@ -69,24 +69,23 @@ WorkflowSpec defineDataProcessing(ConfigContext const&)
     Outputs{},
     adaptFromTask<quality_control::core::BookkeepingQualitySink>(
       "grpcUri", core::Provenance::SyncQC,
-      [](const std::string&, const core::BookkeepingQualitySink::FlagsMap& flagsMap, core::Provenance) {
-        if (!flagsMap.contains("TST")) {
+      [](const std::string&, const core::BookkeepingQualitySink::FlagCollections& flagCollections, core::Provenance) {
+        if (!flagCollections.contains("TST")) {
           LOG(fatal) << "no flag collections for detector TST";
           return;
         }
-        const auto& flagsCollectionsTST = flagsMap.at("TST");
-        if (!flagsCollectionsTST.contains("testCheckNull")) {
-          LOG(fatal) << "no flag collections for QO testCheckNull";
+        const auto& flagsCollectionsTST = flagCollections.at("TST");
+        if (flagsCollectionsTST.size() != 1) {
+          LOG(fatal) << "expected exactly one flag collection for detector TST, got " << flagsCollectionsTST.size();
           return;
         }
-        const auto& flagConverter = flagsCollectionsTST.at("testCheckNull");
-        if (flagConverter == nullptr) {
+        const auto& flagsCollection = flagsCollectionsTST.front();
+        if (flagsCollection == nullptr) {
           LOG(fatal) << "nullptr flag collection for QO testCheckNull";
           return;
         }
-        const auto flagsCollection = flagConverter->getResult();
-        if (flagsCollection == nullptr) {
-          LOG(fatal) << "nullptr flag collection for QO testCheckNull";
+        if (flagsCollection->getName() != "testCheckNull") {
+          LOG(fatal) << "no flag collection for QO testCheckNull";
           return;
         }
 
@@ -0,0 +1,163 @@
+// Copyright 2024 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testBookkeepingQualitySinkStreaming.cxx
+///
+
+#include <DataFormatsQualityControl/QualityControlFlag.h>
+#include "QualityControl/BookkeepingQualitySink.h"
+#include "QualityControl/InfrastructureGenerator.h"
+
+using namespace o2;
+using namespace o2::framework;
+
+void customize(std::vector<CompletionPolicy>& policies)
+{
+  quality_control::customizeInfrastructure(policies);
+}
+
+#include <Framework/runDataProcessing.h>
+#include <Framework/ControlService.h>
+#include "QualityControl/QualityObject.h"
+#include "QualityControl/Quality.h"
+
+#include <algorithm>
+#include <memory>
+
+void compareFatal(const quality_control::QualityControlFlag& got, const quality_control::QualityControlFlag& expected)
+{
+  if (got != expected) {
+    LOG(fatal) << "flags in test do not match. expected:\n"
+               << expected << "\nreceived\n"
+               << got;
+  }
+}
+
+// what the Bookkeeping endpoint received
+struct ReceivedFlags {
+  size_t batches = 0;
+  std::vector<quality_control::QualityControlFlag> flags;
+};
+
+// verifies the flags once the sink has sent the last batch at the end of stream
+class VerifiedBookkeepingQualitySink : public quality_control::core::BookkeepingQualitySink
+{
+ public:
+  VerifiedBookkeepingQualitySink(std::shared_ptr<ReceivedFlags> received, StreamingConfig streamingConfig)
+    : BookkeepingQualitySink("grpcUri", quality_control::core::Provenance::SyncQC, makeCallback(received), streamingConfig),
+      mReceived(std::move(received))
+  {
+  }
+
+  void endOfStream(EndOfStreamContext& context) override
+  {
+    const auto streamedBatches = mReceived->batches;
+    const auto streamedFlags = mReceived->flags.size();
+    BookkeepingQualitySink::endOfStream(context);
+    verify(streamedBatches, streamedFlags);
+  }
+
+ private:
+  static SendCallback makeCallback(std::shared_ptr<ReceivedFlags> received)
+  {
+    return [received](const std::string&, const FlagCollections& flagCollections, quality_control::core::Provenance) {
+      if (flagCollections.size() != 1 || !flagCollections.contains("TST")) {
+        LOG(fatal) << "expected flag collections only for detector TST";
+        return;
+      }
+      for (const auto& flagCollection : flagCollections.at("TST")) {
+        for (const auto& flag : *flagCollection) {
+          received->flags.push_back(flag);
+        }
+      }
+      ++received->batches;
+    };
+  }
+
+  void verify(size_t streamedBatches, size_t streamedFlags) const
+  {
+    using namespace quality_control;
+    // the flags ending before each new QO are sent during the run: [-inf, 10) after the first QO, [10, 100) after the second
+    if (streamedBatches < 1) {
+      LOG(fatal) << "no flags were sent before the end of run";
+    }
+    if (mReceived->batches != streamedBatches + 1) {
+      LOG(fatal) << "expected exactly one batch at the end of run, received " << mReceived->batches - streamedBatches;
+    }
+    if (std::none_of(mReceived->flags.begin() + streamedFlags, mReceived->flags.end(),
+                     [](const auto& flag) { return flag.getEnd() == core::gFullValidityInterval.getMax(); })) {
+      LOG(fatal) << "the last batch does not contain the flag which lasts until the end of run";
+    }
+
+    // the flags sent during the run and at the end together are the same as they would be if sent only at the end
+    auto received = mReceived->flags;
+    std::sort(received.begin(), received.end(), [](const auto& a, const auto& b) { return a.getStart() < b.getStart(); });
+    const std::string badComment = "Bad quality with no Flags associated";
+    const std::string noQOComment = "Did not receive a Quality Object which covers this period";
+    const std::vector<QualityControlFlag> expected{
+      { core::gFullValidityInterval.getMin(), 10, FlagTypeFactory::UnknownQuality(), noQOComment, "qc/TST/QO/testCheckStreaming" },
+      { 10, 100, FlagTypeFactory::Unknown(), badComment, "qc/TST/QO/testCheckStreaming" },
+      { 200, 300, FlagTypeFactory::Unknown(), badComment, "qc/TST/QO/testCheckStreaming" },
+      { 300, core::gFullValidityInterval.getMax(), FlagTypeFactory::UnknownQuality(), noQOComment, "qc/TST/QO/testCheckStreaming" }
+    };
+    if (received.size() != expected.size()) {
+      LOG(fatal) << "expected " << expected.size() << " flags in total, received " << received.size();
+      return;
+    }
+    for (size_t i = 0; i < expected.size(); ++i) {
+      compareFatal(received[i], expected[i]);
+    }
+  }
+
+  std::shared_ptr<ReceivedFlags> mReceived;
+};
+
+WorkflowSpec defineDataProcessing(ConfigContext const&)
+{
+  using namespace quality_control;
+
+  WorkflowSpec specs;
+
+  // QOs with validities moving forward in time, as for a Check of a moving window
+  DataProcessorSpec writer{
+    "writer",
+    Inputs{},
+    Outputs{ { { "tst-qo" }, "TST", "DATA" } },
+    AlgorithmSpec{ [](ProcessingContext& ctx) {
+      const std::vector<std::pair<core::Quality, core::ValidityInterval>> qualities{
+        { core::Quality::Bad, { 10, 100 } },
+        { core::Quality::Good, { 100, 200 } },
+        { core::Quality::Bad, { 200, 300 } }
+      };
+      for (const auto& [quality, validity] : qualities) {
+        auto obj = std::make_unique<core::QualityObject>(quality, "testCheckStreaming", "TST");
+        obj->getActivity().mValidity = validity;
+        ctx.outputs().snapshot(Output{ "TST", "DATA", 0 }, *obj);
+      }
+      ctx.services().get<ControlService>().endOfStream();
+    } }
+  };
+
+  specs.push_back(writer);
+
+  DataProcessorSpec reader{
+    "bookkeepingSink",
+    Inputs{ { { "tst-qo" }, "TST", "DATA" } },
+    Outputs{},
+    adaptFromTask<VerifiedBookkeepingQualitySink>(
+      std::make_shared<ReceivedFlags>(),
+      core::BookkeepingQualitySink::StreamingConfig{ .flushPeriodSeconds = 0.000001 })
+  };
+
+  specs.push_back(reader);
+  return specs;
+}
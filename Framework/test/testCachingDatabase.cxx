@@ -0,0 +1,137 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testCachingDatabase.cxx
+///
+
+#include "QualityControl/CachingDatabase.h"
+#include "QualityControl/DummyDatabase.h"
+#include "QualityControl/MonitorObject.h"
+
+#include <TH1F.h>
+#include <TROOT.h>
+#include <atomic>
+#include <thread>
+#include <catch_amalgamated.hpp>
+
+using namespace o2::quality_control::core;
+using namespace o2::quality_control::repository;
+
+namespace
+{
+
+// returns a new histogram for each retrieval and counts the retrievals
+struct CountingDatabase : public DummyDatabase {
+  explicit CountingDatabase(std::atomic<int>& retrievals, std::chrono::milliseconds delay = {}) : mRetrievals(retrievals), mDelay(delay) {}
+
+  std::shared_ptr<MonitorObject> retrieveMO(std::string path, std::string name, long timestamp, const Activity&, const std::map<std::string, std::string>&) override
+  {
+    mRetrievals++;
+    std::this_thread::sleep_for(mDelay);
+    if (name == "missing") {
+      return nullptr;
+    }
+    auto mo = std::make_shared<MonitorObject>(new TH1F(name.c_str(), path.c_str(), 100, 0, 100), "task", "class", "TST");
+    mo->setIsOwner(true);
+    return mo;
+  }
+
+  std::atomic<int>& mRetrievals;
+  std::chrono::milliseconds mDelay;
+};
+
+} // namespace
+
+TEST_CASE("caching_database_hits_and_copies")
+{
+  std::atomic<int> retrievals = 0;
+  RetrievalCache cache(std::chrono::seconds(60), 10 * 1024 * 1024);
+  CachingDatabase database(std::make_unique<CountingDatabase>(retrievals), cache);
+
+  auto first = database.retrieveMO("qc/TST/MO/task", "histo", 1000);
+  auto second = database.retrieveMO("qc/TST/MO/task", "histo", 1000);
+  REQUIRE(first != nullptr);
+  REQUIRE(second != nullptr);
+  CHECK(retrievals == 1);
+  // each caller gets its own copy
+  CHECK(first->getObject() != second->getObject());
+  dynamic_cast<TH1F*>(first->getObject())->Fill(5);
+  CHECK(dynamic_cast<TH1F*>(database.retrieveMO("qc/TST/MO/task", "histo", 1000)->getObject())->GetEntries() == 0);
+
+  // different timestamps, activities and metadata are different objects
+  database.retrieveMO("qc/TST/MO/task", "histo", 2000);
+  database.retrieveMO("qc/TST/MO/task", "histo", 1000, Activity{ 123, "PHYSICS" });
+  database.retrieveMO("qc/TST/MO/task", "histo", 1000, {}, { { "key", "value" } });
+  CHECK(retrievals == 4);
+
+  // objects which are not found are not cached
+  CHECK(database.retrieveMO("qc/TST/MO/task", "missing", 1000) == nullptr);
+  CHECK(database.retrieveMO("qc/TST/MO/task", "missing", 1000) == nullptr);
+  CHECK(retrievals == 6);
+
+  auto stats = cache.getStats();
+  CHECK(stats.hits == 2);
+  CHECK(stats.misses == 6);
+  CHECK(stats.entries == 4);
+}
+
+TEST_CASE("caching_database_expiration_and_eviction")
+{
+  std::atomic<int> retrievals = 0;
+  RetrievalCache cache(std::chrono::milliseconds(50), 10 * 1024 * 1024);
+  CachingDatabase database(std::make_unique<CountingDatabase>(retrievals), cache);
+
+  database.retrieveMO("qc/TST/MO/task", "histo", 1000);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  database.retrieveMO("qc/TST/MO/task", "histo", 1000);
+  CHECK(retrievals == 2);
+  CHECK(cache.getStats().expired == 1);
+
+  // the limit allows for only a bit more than 2 objects
+  auto objectSize = cache.getStats().sizeBytes;
+  cache.setLimits(std::chrono::seconds(60), objectSize * 2 + objectSize / 2);
+  database.retrieveMO("qc/TST/MO/task", "histo1", 1000);
+  database.retrieveMO("qc/TST/MO/task", "histo2", 1000);
+  database.retrieveMO("qc/TST/MO/task", "histo1", 1000); // histo1 becomes the most recently used
+  database.retrieveMO("qc/TST/MO/task", "histo3", 1000); // histo2 should be evicted
+  CHECK(retrievals == 5);
+  database.retrieveMO("qc/TST/MO/task", "histo1", 1000);
+  CHECK(retrievals == 5);
+  database.retrieveMO("qc/TST/MO/task", "histo2", 1000);
+  CHECK(retrievals == 6);
+  CHECK(cache.getStats().entries == 2);
+  CHECK(cache.getStats().sizeBytes <= objectSize * 2 + objectSize / 2);
+}
+
+TEST_CASE("caching_database_deduplicates_concurrent_retrievals")
+{
+  ROOT::EnableThreadSafety();
+  std::atomic<int> retrievals = 0;
+  RetrievalCache cache(std::chrono::seconds(60), 10 * 1024 * 1024);
+
+  std::vector<std::thread> threads;
+  std::atomic<int> found = 0;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&]() {
+      CachingDatabase database(std::make_unique<CountingDatabase>(retrievals, std::chrono::milliseconds(200)), cache);
+      if (database.retrieveMO("qc/TST/MO/task", "histo", 1000) != nullptr) {
+        found++;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  CHECK(found == 4);
+  CHECK(retrievals == 1);
+  CHECK(cache.getStats().deduplicated + cache.getStats().hits == 3);
+}
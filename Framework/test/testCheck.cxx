@@ -126,6 +126,31 @@ TEST_CASE("test_check_invoke_check")
   CHECK(qos.size() == 1);
 }
 
+TEST_CASE("test_check_deferred_beautify")
+{
+  std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
+
+  Check check(getCheckConfig(configFilePath, "singleCheck"));
+  check.init();
+  check.startOfActivity(Activity());
+
+  auto mo = dummyMO("example");
+  auto histo = dynamic_cast<TH1F*>(mo->getObject());
+  REQUIRE(histo != nullptr);
+  auto originalFillColor = histo->GetFillColor();
+  std::map<std::string, std::shared_ptr<MonitorObject>> moMap{
+    { "skeletonTask/example", mo }
+  };
+
+  auto qos = check.check(moMap, false);
+  REQUIRE(qos.size() == 1);
+  CHECK(qos[0]->getQuality() == Quality::Bad);
+  CHECK(histo->GetFillColor() == originalFillColor);
+
+  check.beautify(moMap, qos);
+  CHECK(histo->GetFillColor() == kRed);
+}
+
 TEST_CASE("test_check_postprocessing")
 {
   std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
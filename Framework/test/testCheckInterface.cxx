@@ -86,3 +86,32 @@ TEST_CASE("test_invoke_all_interface_methods")
   testCheck.beautify(mo);
   CHECK(reinterpret_cast<TObjString*>(mo->getObject())->String() == "A string is beautiful now");
 }
+
+TEST_CASE("test_view_falls_back_to_map_interface")
+{
+  test::TestCheck testCheck;
+  testCheck.mValidString = "A string";
+
+  std::map<std::string, std::shared_ptr<MonitorObject>> cache = {
+    { "task/a", std::make_shared<MonitorObject>(new TObjString("A string"), "task", "class", "DET") },
+    { "task/b", std::make_shared<MonitorObject>(new TObjString("Another string"), "task", "class", "DET") }
+  };
+  for (auto& [name, mo] : cache) {
+    mo->setIsOwner(true);
+  }
+  std::vector<const MonitorObjectsView::Entry*> entries;
+  for (const auto& entry : cache) {
+    entries.push_back(&entry);
+  }
+  MonitorObjectsView view{ entries };
+
+  CHECK(view.size() == 2);
+  CHECK(view.get("task/a") == cache["task/a"].get());
+  CHECK(view.get("task/c") == nullptr);
+  CHECK(view.toMap() == cache);
+
+  // the Check implements only the map-based interface, it should still be called with a view
+  checker::CheckInterface& checkInterface = testCheck;
+  CHECK(checkInterface.check(view.subview(0, 1)) == Quality::Good);
+  CHECK(checkInterface.check(view.subview(1, 1)) == Quality::Bad);
+}
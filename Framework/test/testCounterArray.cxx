@@ -0,0 +1,258 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testCounterArray.cxx
+///
+
+#include "QualityControl/CounterArray.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectCollection.h"
+
+#include <TH1F.h>
+#include <TH2F.h>
+#include <TBufferFile.h>
+#include <limits>
+#include <random>
+#include <catch_amalgamated.hpp>
+
+using namespace o2::quality_control::core;
+
+TEST_CASE("counter_array_1d")
+{
+  CounterArrayI counters("counters", "counters", 10, 0, 10);
+  TH1F reference("reference", "reference", 10, 0, 10);
+  CHECK(counters.getDimension() == 1);
+
+  for (double x : { -1., 0., 0.5, 3.2, 9.99, 10., 42., std::numeric_limits<double>::quiet_NaN() }) {
+    counters.fill(x);
+    reference.Fill(x);
+  }
+  std::vector<double> batch{ -5., 1.5, 1.5, 9.5, 11. };
+  counters.fill(batch);
+  for (auto x : batch) {
+    reference.Fill(x);
+  }
+  counters.fillBinWeighted(4, 3);
+  reference.AddBinContent(4, 3);
+
+  CHECK(counters.getEntries() == 14);
+  CHECK(counters.getSum() == 16);
+  for (int bin = 0; bin <= 11; bin++) {
+    CHECK(counters.getBinContent(bin) == reference.GetBinContent(bin));
+  }
+
+  auto histogram = counters.materialize();
+  REQUIRE(histogram != nullptr);
+  CHECK(std::string(histogram->GetName()) == "counters");
+  CHECK(histogram->GetDimension() == 1);
+  CHECK(histogram->GetNbinsX() == 10);
+  CHECK(histogram->GetEntries() == 14);
+  for (int bin = 0; bin <= 11; bin++) {
+    CHECK(histogram->GetBinContent(bin) == reference.GetBinContent(bin));
+  }
+
+  counters.reset();
+  CHECK(counters.getEntries() == 0);
+  CHECK(counters.getSum() == 0);
+
+  // a weighted 1D fill on floating point counters is not taken for a 2D fill
+  CounterArrayF floatCounters("floatCounters", "floatCounters", 10, 0, 10);
+  floatCounters.fillWeighted(2.5, 2.0);
+  floatCounters.fill(7.5);
+  CHECK(floatCounters.getBinContent(3) == 2.f);
+  CHECK(floatCounters.getBinContent(8) == 1.f);
+  CHECK(floatCounters.getEntries() == 2);
+
+  // the statistics of the histogram are updated with the added counters
+  auto floatHistogram = floatCounters.materialize();
+  CHECK(floatHistogram->GetMean() == Catch::Approx(12.5 / 3));
+  CHECK(floatHistogram->GetEntries() == 2);
+
+  CHECK_THROWS(CounterArrayI("invalid", "invalid", 0, 0, 10));
+  CHECK_THROWS(CounterArrayI("invalid", "invalid", 10, 10, 0));
+}
+
+TEST_CASE("counter_array_2d")
+{
+  CounterArrayF counters("counters", "counters", 4, 0, 4, 3, -1.5, 1.5);
+  TH2F reference("reference", "reference", 4, 0, 4, 3, -1.5, 1.5);
+  CHECK(counters.getDimension() == 2);
+
+  std::vector<double> xs{ 0.5, 3.5, -1., 5., 2.2, 2.2 };
+  std::vector<double> ys{ 0., 1., 0., -2., 1.4, 3. };
+  for (size_t i = 0; i < xs.size(); i++) {
+    counters.fillWeighted(xs[i], ys[i], 2.f);
+    reference.Fill(xs[i], ys[i], 2.);
+  }
+  counters.fill(xs, ys);
+  for (size_t i = 0; i < xs.size(); i++) {
+    reference.Fill(xs[i], ys[i]);
+  }
+  std::vector<int> binsX{ 1, 4 }, binsY{ 3, 0 };
+  counters.fillBins(binsX, binsY);
+  reference.AddBinContent(reference.GetBin(1, 3));
+  reference.AddBinContent(reference.GetBin(4, 0));
+
+  CHECK(counters.getEntries() == 14);
+  for (int binx = 0; binx <= 5; binx++) {
+    for (int biny = 0; biny <= 4; biny++) {
+      CHECK(counters.getBinContent(binx, biny) == reference.GetBinContent(binx, biny));
+    }
+  }
+
+  TH2F target("target", "target", 4, 0, 4, 3, -1.5, 1.5);
+  counters.fillHistogram(&target);
+  CHECK(target.GetBinContent(1, 2) == reference.GetBinContent(1, 2));
+  CHECK(target.GetEntries() == 14);
+  TH2F wrongBinning("wrong", "wrong", 5, 0, 4, 3, -1.5, 1.5);
+  CHECK_THROWS(counters.fillHistogram(&wrongBinning));
+  CHECK(dynamic_cast<TH2F*>(counters.materialize().get()) != nullptr);
+}
+
+TEST_CASE("counter_array_batch_edges")
+{
+  // values close to bin edges end up in the same bins with single and batch fills
+  CounterArrayL single("single", "single", 7, -0.3, 0.4);
+  CounterArrayL batch("batch", "batch", 7, -0.3, 0.4);
+  std::vector<double> values;
+  for (int i = 0; i <= 70; i++) {
+    values.push_back(-0.3 + i * 0.01);
+  }
+  for (auto x : values) {
+    single.fill(x);
+  }
+  batch.fill(values);
+  CHECK(batch.getCounters() == single.getCounters());
+}
+
+TEST_CASE("counter_array_merge")
+{
+  CounterArrayL target("counters", "counters", 3, 0, 3, 2, 0, 2);
+  CounterArrayL other("counters", "counters", 3, 0, 3, 2, 0, 2);
+  target.fill(0.5, 0.5);
+  other.fill(0.5, 0.5);
+  other.fill(2.5, 1.5);
+
+  target.merge(&other);
+  CHECK(target.getBinContent(1, 1) == 2);
+  CHECK(target.getBinContent(3, 2) == 1);
+  CHECK(target.getEntries() == 3);
+
+  CounterArrayL differentBinning("counters", "counters", 3, 0, 3, 2, 0, 3);
+  CHECK_THROWS(target.merge(&differentBinning));
+  CounterArrayI differentType("counters", "counters", 3, 0, 3, 2, 0, 2);
+  CHECK_THROWS(target.merge(&differentType));
+
+  // as a part of a MonitorObjectCollection, as done by Mergers
+  auto makeCollection = [](double x) {
+    auto counters = new CounterArrayL("counters", "counters", 3, 0, 3);
+    counters->fill(x);
+    auto mo = new MonitorObject(counters, "task", "class", "TST");
+    mo->setIsOwner(true);
+    auto collection = std::make_unique<MonitorObjectCollection>();
+    collection->SetOwner(true);
+    collection->Add(mo);
+    return collection;
+  };
+  auto collection = makeCollection(0.5);
+  auto otherCollection = makeCollection(1.5);
+  collection->merge(otherCollection.get());
+  auto mergedCounters = dynamic_cast<CounterArrayL*>(dynamic_cast<MonitorObject*>(collection->At(0))->getObject());
+  REQUIRE(mergedCounters != nullptr);
+  CHECK(mergedCounters->getEntries() == 2);
+  CHECK(mergedCounters->getBinContent(2) == 1);
+}
+
+TEST_CASE("counter_array_streaming")
+{
+  CounterArrayI counters("counters", "counters", 5, 0, 5, 5, 0, 5);
+  counters.fill(1.5, 2.5);
+  counters.fillBin(6, 6);
+
+  TBufferFile buffer(TBuffer::kWrite);
+  buffer.WriteObject(&counters);
+  buffer.SetReadMode();
+  buffer.SetBufferOffset(0);
+  std::unique_ptr<CounterArrayI> read(dynamic_cast<CounterArrayI*>(buffer.ReadObject(CounterArrayI::Class())));
+  REQUIRE(read != nullptr);
+  CHECK(std::string(read->GetName()) == "counters");
+  CHECK(read->getCounters() == counters.getCounters());
+  CHECK(read->getEntries() == 2);
+  CHECK(read->findBinY(4.5) == 5);
+}
+
+TEST_CASE("counter_array_vs_th2f", "[.][benchmark]")
+{
+  // A pixel map of one ITS chip (1024 columns x 512 rows) filled with 1M clusters, which is about one TF of one
+  // layer in pp collisions at 500 kHz. The positions are generated beforehand, so that only the filling is measured.
+  constexpr size_t nClusters = 1'000'000;
+  constexpr int nColumns = 1024;
+  constexpr int nRows = 512;
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> columnDistribution(0, nColumns);
+  std::normal_distribution<double> rowDistribution(nRows / 2., nRows / 6.);
+  std::vector<double> columns(nClusters), rows(nClusters);
+  std::vector<int> columnBins(nClusters), rowBins(nClusters);
+  for (size_t i = 0; i < nClusters; i++) {
+    columns[i] = columnDistribution(generator);
+    rows[i] = rowDistribution(generator);
+    columnBins[i] = 1 + std::clamp(static_cast<int>(columns[i]), -1, nColumns);
+    rowBins[i] = 1 + std::clamp(static_cast<int>(rows[i]), -1, nRows);
+  }
+
+  TH2F histogram("histogram", "histogram", nColumns, 0, nColumns, nRows, 0, nRows);
+  histogram.SetDirectory(nullptr);
+  CounterArrayI counters("counters", "counters", nColumns, 0, nColumns, nRows, 0, nRows);
+
+  BENCHMARK("TH2F::Fill")
+  {
+    for (size_t i = 0; i < nClusters; i++) {
+      histogram.Fill(columns[i], rows[i]);
+    }
+    return histogram.GetEntries();
+  };
+
+  BENCHMARK("CounterArray::fill")
+  {
+    for (size_t i = 0; i < nClusters; i++) {
+      counters.fill(columns[i], rows[i]);
+    }
+    return counters.getEntries();
+  };
+
+  BENCHMARK("CounterArray::fill batch")
+  {
+    counters.fill(columns, rows);
+    return counters.getEntries();
+  };
+
+  BENCHMARK("CounterArray::fillBins batch")
+  {
+    counters.fillBins(columnBins, rowBins);
+    return counters.getEntries();
+  };
+
+  BENCHMARK("CounterArray::fillHistogram")
+  {
+    histogram.Reset();
+    counters.fillHistogram(&histogram);
+    return histogram.GetEntries();
+  };
+
+  histogram.Reset();
+  counters.reset();
+  for (size_t i = 0; i < nClusters; i++) {
+    histogram.Fill(columns[i], rows[i]);
+  }
+  counters.fill(columns, rows);
+  CHECK(counters.materialize()->GetSumOfWeights() == histogram.GetSumOfWeights());
+}
@@ -0,0 +1,106 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testFlagIntervalBuffer.cxx
+///
+
+#include "QualityControl/FlagIntervalBuffer.h"
+#include <DataFormatsQualityControl/FlagTypeFactory.h>
+#include <catch_amalgamated.hpp>
+
+using namespace o2::quality_control;
+using namespace o2::quality_control::core;
+
+TEST_CASE("flag_interval_buffer_kinds")
+{
+  FlagIntervalBuffer buffer;
+  auto unknown = buffer.getKind(FlagTypeFactory::Unknown(), "comment");
+  CHECK(buffer.getKind(FlagTypeFactory::Unknown(), "comment") == unknown);
+  CHECK(buffer.getKind(FlagTypeFactory::Unknown(), "other comment") != unknown);
+  CHECK(buffer.getKind(FlagTypeFactory::BadTracking(), "comment") != unknown);
+  CHECK(buffer.getNumberOfKinds() == 3);
+  CHECK(buffer.getFlagType(unknown) == FlagTypeFactory::Unknown());
+  CHECK(buffer.getComment(unknown) == "comment");
+}
+
+TEST_CASE("flag_interval_buffer_queries")
+{
+  FlagIntervalBuffer buffer;
+  auto kind = buffer.getKind(FlagTypeFactory::Unknown(), "comment");
+  auto otherKind = buffer.getKind(FlagTypeFactory::BadTracking(), "comment");
+  buffer.insert(kind, { 10, 20 });
+  buffer.insert(kind, { 30, 40 });
+  buffer.insert(kind, { 50, 60 });
+  buffer.insert(otherKind, { 0, 100 });
+  REQUIRE(buffer.size() == 4);
+
+  SECTION("overlapping")
+  {
+    CHECK(buffer.getOverlapping(kind, { 20, 30 }).empty()); // adjacent only
+    auto overlapping = buffer.getOverlapping(kind, { 15, 35 });
+    REQUIRE(overlapping.size() == 2);
+    CHECK(overlapping[0].getMin() == 10);
+    CHECK(overlapping[1].getMax() == 40);
+    CHECK(buffer.getOverlapping(otherKind, { 15, 35 }).size() == 1);
+  }
+
+  SECTION("connecting")
+  {
+    // adjacent intervals are taken as well, the other kinds are not affected
+    auto merged = buffer.takeConnecting(kind, { 20, 30 });
+    CHECK(merged.getMin() == 10);
+    CHECK(merged.getMax() == 40);
+    CHECK(buffer.size() == 2);
+    merged = buffer.takeConnecting(kind, { 70, 80 });
+    CHECK(merged.getMin() == 70);
+    CHECK(merged.getMax() == 80);
+    CHECK(buffer.size() == 2);
+  }
+
+  SECTION("excluding")
+  {
+    buffer.exclude(kind, { 15, 55 });
+    auto remaining = buffer.getOverlapping(kind, { 0, 100 });
+    REQUIRE(remaining.size() == 2);
+    CHECK(remaining[0].getMin() == 10);
+    CHECK(remaining[0].getMax() == 15);
+    CHECK(remaining[1].getMin() == 55);
+    CHECK(remaining[1].getMax() == 60);
+
+    // an interval split in the middle becomes two
+    buffer.exclude(otherKind, { 40, 50 });
+    CHECK(buffer.getOverlapping(otherKind, { 0, 100 }).size() == 2);
+  }
+
+  SECTION("intersecting")
+  {
+    buffer.intersect({ 35, 55 });
+    CHECK(buffer.size() == 3);
+    auto flags = buffer.getFlags("qc/DET/QO/xyzCheck");
+    REQUIRE(flags.size() == 3);
+    for (const auto& flag : flags) {
+      CHECK(flag.getStart() >= 35);
+      CHECK(flag.getEnd() <= 55);
+      CHECK(flag.getComment() == "comment");
+      CHECK(flag.getSource() == "qc/DET/QO/xyzCheck");
+    }
+  }
+
+  SECTION("clearing")
+  {
+    buffer.erase(kind);
+    CHECK(buffer.size() == 1);
+    buffer.clear();
+    CHECK(buffer.size() == 0);
+    CHECK(buffer.getNumberOfKinds() == 2);
+  }
+}
@@ -0,0 +1,99 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testLatencyTracing.cxx
+///
+
+#include "QualityControl/LatencyTracing.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/ObjectMetadataKeys.h"
+
+#include <TH1F.h>
+#include <catch_amalgamated.hpp>
+
+using namespace o2::quality_control::core;
+using namespace o2::quality_control::repository;
+
+TEST_CASE("latency_histogram")
+{
+  latency_tracing::LatencyHistogram histogram;
+  CHECK(histogram.getCount() == 0);
+  CHECK(histogram.getMean() == 0);
+
+  histogram.fill(5);
+  histogram.fill(10);
+  histogram.fill(2500);
+  histogram.fill(1e6);
+  histogram.fill(-3); // unsynchronized clocks
+
+  CHECK(histogram.getCount() == 5);
+  CHECK(histogram.getMax() == 1e6);
+  CHECK(histogram.getMean() == Catch::Approx((5 + 10 + 2500 + 1e6) / 5));
+  const auto& buckets = histogram.getBuckets();
+  CHECK(buckets[0] == 3); // up to 10 ms, the upper edge included
+  CHECK(buckets[4] == 1); // 1 to 5 s
+  CHECK(buckets.back() == 1);
+
+  histogram.reset();
+  CHECK(histogram.getCount() == 0);
+  CHECK(histogram.getBuckets()[0] == 0);
+}
+
+TEST_CASE("latency_tracing_fill_latencies")
+{
+  std::map<std::string, std::string> metadata{
+    { metadata_keys::traceFirstData, "1000" },
+    { metadata_keys::traceCycleEnd, "61000" },
+    { metadata_keys::traceSnapshot, "61050" },
+    { metadata_keys::traceCheckRunnerInput, "65050" },
+  };
+  CHECK(latency_tracing::getTimestamp(metadata, metadata_keys::traceCycleEnd) == 61000);
+  CHECK_FALSE(latency_tracing::getTimestamp(metadata, metadata_keys::traceCheckDone).has_value());
+
+  std::map<std::string, latency_tracing::LatencyHistogram> latencies;
+  latency_tracing::fillLatencies(metadata, latencies);
+  REQUIRE(latencies.size() == 3);
+  CHECK(latencies.at("cycle").getMean() == 60000);
+  CHECK(latencies.at("publication").getMean() == 50);
+  CHECK(latencies.at("transport").getMean() == 4000);
+
+  // the latencies next to a missing or invalid stage are not filled
+  metadata.erase(metadata_keys::traceCycleEnd);
+  metadata[metadata_keys::traceCheckRunnerInput] = "not a number";
+  latencies.clear();
+  latency_tracing::fillLatencies(metadata, latencies);
+  CHECK(latencies.empty());
+}
+
+TEST_CASE("latency_tracing_merge")
+{
+  auto makeCollection = [](const std::string& snapshot) {
+    auto histogram = new TH1F("histo", "histo", 10, 0, 10);
+    histogram->SetDirectory(nullptr);
+    auto mo = new MonitorObject(histogram, "task", "class", "TST");
+    mo->setIsOwner(true);
+    auto collection = std::make_unique<MonitorObjectCollection>();
+    collection->SetOwner(true);
+    collection->Add(mo);
+    collection->addOrUpdateMetadata(metadata_keys::traceSnapshot, snapshot);
+    return collection;
+  };
+
+  // the merged object is as late as its latest input
+  auto target = makeCollection("2000");
+  target->merge(makeCollection("3000").get());
+  target->merge(makeCollection("1000").get());
+  auto mo = dynamic_cast<MonitorObject*>(target->At(0));
+  REQUIRE(mo != nullptr);
+  CHECK(mo->getMetadata(metadata_keys::traceSnapshot) == "3000");
+}
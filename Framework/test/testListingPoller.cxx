@@ -0,0 +1,166 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testListingPoller.cxx
+///
+
+#include "QualityControl/ListingPoller.h"
+#include "QualityControl/ObjectMetadataKeys.h"
+
+#include <thread>
+#include <catch_amalgamated.hpp>
+
+using namespace o2::quality_control::postprocessing;
+using namespace o2::quality_control::repository;
+
+namespace
+{
+
+// pretends to be a database which contains the latest versions of objects in a single directory
+struct FakeRepository {
+  struct Object {
+    uint64_t lastModified;
+    uint64_t validFrom;
+    std::optional<unsigned long> cycle;
+  };
+
+  void store(const std::string& path, std::optional<unsigned long> cycle = std::nullopt)
+  {
+    now++;
+    objects[path] = { now, now, cycle };
+  }
+
+  boost::property_tree::ptree list(const std::string& path, const std::map<std::string, std::string>&, bool)
+  {
+    listings.push_back(path);
+    boost::property_tree::ptree objectsTree;
+    for (const auto& [objectPath, object] : objects) {
+      boost::property_tree::ptree objectTree;
+      objectTree.put("path", objectPath);
+      objectTree.put(metadata_keys::lastModified, object.lastModified);
+      objectTree.put(metadata_keys::validFrom, object.validFrom);
+      objectTree.put(metadata_keys::validUntil, object.validFrom + 1000);
+      if (object.cycle.has_value()) {
+        objectTree.put(metadata_keys::cycleNumber, object.cycle.value());
+      }
+      objectsTree.push_back({ "", objectTree });
+    }
+    boost::property_tree::ptree listing;
+    listing.add_child("objects", objectsTree);
+    return listing;
+  }
+
+  ListingPoller::ListingFunction listingFunction()
+  {
+    return [this](const std::string& path, const std::map<std::string, std::string>& metadata, bool latestOnly) { return list(path, metadata, latestOnly); };
+  }
+
+  uint64_t now = 1000;
+  std::map<std::string, Object> objects;
+  std::vector<std::string> listings;
+};
+
+} // namespace
+
+TEST_CASE("listing_poller_shares_listings")
+{
+  FakeRepository repository;
+  repository.store("qc/TST/MO/Task/a");
+  ListingPoller poller(repository.listingFunction(), std::chrono::seconds(100));
+
+  auto a = poller.subscribe("qc/TST/MO/Task/a");
+  auto b = poller.subscribe("qc/TST/MO/Task/b");
+  auto c = poller.subscribe("qc/TST/MO/Task/c");
+  CHECK(repository.listings == std::vector<std::string>{ "qc/TST/MO/Task/.*" });
+
+  // the object existing before subscribing is not reported
+  CHECK(!poller.poll(*a).isValid());
+  CHECK(!poller.poll(*b).isValid());
+  CHECK(!poller.poll(*c).isValid());
+  CHECK(repository.listings.size() == 2);
+
+  repository.store("qc/TST/MO/Task/a");
+  repository.store("qc/TST/MO/Task/b");
+  // one listing per round of checks
+  CHECK(poller.poll(*a).getMin() == repository.objects["qc/TST/MO/Task/a"].validFrom);
+  CHECK(poller.poll(*b).getMin() == repository.objects["qc/TST/MO/Task/b"].validFrom);
+  CHECK(!poller.poll(*c).isValid());
+  CHECK(repository.listings.size() == 3);
+
+  // reported only once
+  CHECK(!poller.poll(*a).isValid());
+  CHECK(!poller.poll(*b).isValid());
+  CHECK(repository.listings.size() == 4);
+
+  auto stats = poller.getStats();
+  CHECK(stats.groups == 1);
+  CHECK(stats.subscriptions == 3);
+  CHECK(stats.listings == 4);
+}
+
+TEST_CASE("listing_poller_waits_for_complete_cycles")
+{
+  FakeRepository repository;
+  repository.store("qc/TST/MO/Task/a", 1);
+  repository.store("qc/TST/MO/Task/b", 1);
+  repository.store("qc/TST/MO/Task/c", 1);
+  ListingPoller poller(repository.listingFunction(), std::chrono::seconds(100), std::chrono::seconds(100));
+  auto a = poller.subscribe("qc/TST/MO/Task/a");
+
+  // "a" of the cycle 2 is there, but "b" and "c" are still at the cycle 1
+  repository.store("qc/TST/MO/Task/a", 2);
+  repository.store("qc/TST/MO/Task/b", 2);
+  CHECK(!poller.poll(*a).isValid());
+  // the cycle 2 is complete
+  repository.store("qc/TST/MO/Task/c", 2);
+  CHECK(poller.poll(*a).getMin() == repository.objects["qc/TST/MO/Task/a"].validFrom);
+
+  // "c" is not published anymore, so we report "a" when the directory does not change anymore
+  repository.store("qc/TST/MO/Task/a", 3);
+  repository.store("qc/TST/MO/Task/b", 3);
+  CHECK(!poller.poll(*a).isValid());
+  CHECK(poller.poll(*a).getMin() == repository.objects["qc/TST/MO/Task/a"].validFrom);
+  CHECK(!poller.poll(*a).isValid());
+
+  // objects without cycle numbers are reported immediately
+  repository.store("qc/TST/MO/Task/a");
+  CHECK(poller.poll(*a).isValid());
+}
+
+TEST_CASE("listing_poller_object_without_directory")
+{
+  FakeRepository repository;
+  ListingPoller poller(repository.listingFunction(), std::chrono::seconds(100));
+
+  auto a = poller.subscribe("a");
+  CHECK(repository.listings == std::vector<std::string>{ "a" });
+  repository.store("a");
+  CHECK(poller.poll(*a).getMin() == repository.objects["a"].validFrom);
+}
+
+TEST_CASE("listing_poller_full_listings")
+{
+  FakeRepository repository;
+  repository.store("qc/TST/MO/Task/a");
+
+  ListingPoller poller(repository.listingFunction(), std::chrono::seconds(100));
+  CHECK(poller.getFullListing("qc/TST/MO/Task/a").get_child("objects").size() == 1);
+  CHECK(poller.getFullListing("qc/TST/MO/Task/a").get_child("objects").size() == 1);
+  CHECK(repository.listings.size() == 1);
+
+  // expired listings are not kept
+  ListingPoller expiringPoller(repository.listingFunction(), std::chrono::milliseconds(0));
+  expiringPoller.getFullListing("qc/TST/MO/Task/a");
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  expiringPoller.getFullListing("qc/TST/MO/Task/a");
+  CHECK(repository.listings.size() == 3);
+}
@@ -0,0 +1,234 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testMergeHelpers.cxx
+///
+
+#include "QualityControl/MergeHelpers.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectCollection.h"
+
+#include <Mergers/MergerAlgorithm.h>
+#include <TH1C.h>
+#include <TH1D.h>
+#include <TH1F.h>
+#include <TH1I.h>
+#include <TH1S.h>
+#include <TH2D.h>
+#include <TH2F.h>
+#include <TProfile.h>
+#include <random>
+#include <catch_amalgamated.hpp>
+
+using namespace o2::quality_control::core;
+
+namespace
+{
+template <typename Histogram>
+void checkSameHistograms(const Histogram& merged, const Histogram& reference)
+{
+  REQUIRE(merged.GetNcells() == reference.GetNcells());
+  for (int bin = 0; bin < reference.GetNcells(); bin++) {
+    CHECK(merged.GetBinContent(bin) == Catch::Approx(reference.GetBinContent(bin)));
+    CHECK(merged.GetBinError(bin) == Catch::Approx(reference.GetBinError(bin)));
+  }
+  CHECK(merged.GetEntries() == Catch::Approx(reference.GetEntries()));
+  CHECK(merged.GetMean() == Catch::Approx(reference.GetMean()));
+  CHECK(merged.GetStdDev() == Catch::Approx(reference.GetStdDev()));
+}
+} // namespace
+
+TEST_CASE("merge_helpers_same_binning")
+{
+  std::mt19937 generator(42);
+  std::normal_distribution<double> distribution(5, 2);
+
+  TH1F target("target", "target", 10, 0, 10);
+  TH1F other("other", "other", 10, 0, 10);
+  for (int i = 0; i < 100; i++) {
+    target.Fill(distribution(generator));
+    other.Fill(distribution(generator));
+  }
+  TH1F reference(target);
+  reference.Add(&other);
+  REQUIRE(merge_helpers::mergeHistograms(&target, &other));
+  checkSameHistograms(target, reference);
+
+  TH2D target2D("target2D", "target2D", 5, 0, 10, 4, -2, 2);
+  TH2D other2D("other2D", "other2D", 5, 0, 10, 4, -2, 2);
+  target2D.Sumw2();
+  other2D.Sumw2();
+  target2D.Fill(1, 1, 0.5);
+  other2D.Fill(1, 1, 3);
+  other2D.Fill(9, -1.5);
+  other2D.Fill(20, 0); // overflow
+  TH2D reference2D(target2D);
+  reference2D.Add(&other2D);
+  REQUIRE(merge_helpers::mergeHistograms(&target2D, &other2D));
+  checkSameHistograms(target2D, reference2D);
+}
+
+namespace
+{
+// ROOT caps the integer bins when adding to them, the fast path must not let them overflow instead
+template <typename Histogram>
+void checkIntegerBinsAreCapped(double nearMaximum, double maximum)
+{
+  Histogram target("target", "target", 3, 0, 3);
+  Histogram other("other", "other", 3, 0, 3);
+  target.SetBinContent(2, nearMaximum);
+  other.SetBinContent(2, nearMaximum);
+  other.SetBinContent(3, 1);
+  CHECK_FALSE(merge_helpers::mergeHistograms(&target, &other));
+  CHECK(target.GetBinContent(2) == nearMaximum);
+
+  o2::mergers::algorithm::merge(&target, &other);
+  CHECK(target.GetBinContent(2) == maximum);
+  CHECK(target.GetBinContent(3) == 1);
+}
+} // namespace
+
+TEST_CASE("merge_helpers_integer_bins")
+{
+  checkIntegerBinsAreCapped<TH1C>(100, 127);
+  checkIntegerBinsAreCapped<TH1S>(30000, 32767);
+  checkIntegerBinsAreCapped<TH1I>(2000000000, 2147483647);
+}
+
+TEST_CASE("merge_helpers_fallback")
+{
+  TH1F target("target", "target", 10, 0, 10);
+  target.Fill(1);
+
+  TH1F differentBins("differentBins", "differentBins", 20, 0, 10);
+  CHECK_FALSE(merge_helpers::mergeHistograms(&target, &differentBins));
+  TH1F differentRange("differentRange", "differentRange", 10, 0, 20);
+  CHECK_FALSE(merge_helpers::mergeHistograms(&target, &differentRange));
+  TH1D differentClass("differentClass", "differentClass", 10, 0, 10);
+  CHECK_FALSE(merge_helpers::mergeHistograms(&target, &differentClass));
+  TH1F labelled("labelled", "labelled", 10, 0, 10);
+  labelled.GetXaxis()->SetBinLabel(1, "a");
+  CHECK_FALSE(merge_helpers::mergeHistograms(&target, &labelled));
+  TProfile profile("profile", "profile", 10, 0, 10);
+  TProfile otherProfile("otherProfile", "otherProfile", 10, 0, 10);
+  CHECK_FALSE(merge_helpers::mergeHistograms(&profile, &otherProfile));
+  TH1F averaged("averaged", "averaged", 10, 0, 10);
+  averaged.SetBit(TH1::kIsAverage);
+  CHECK_FALSE(merge_helpers::mergeHistograms(&target, &averaged));
+  CHECK_FALSE(merge_helpers::mergeHistograms(&averaged, &target));
+  CHECK_FALSE(merge_helpers::mergeHistograms(&target, nullptr));
+
+  // nothing was modified
+  CHECK(target.GetEntries() == 1);
+  CHECK(target.GetBinContent(2) == 1);
+}
+
+TEST_CASE("merge_helpers_collection_statistics")
+{
+  auto makeCollection = [](TObject* obj) {
+    auto mo = new MonitorObject(obj, "task", "class", "TST");
+    mo->setIsOwner(true);
+    auto collection = std::make_unique<MonitorObjectCollection>();
+    collection->SetOwner(true);
+    collection->Add(mo);
+    return collection;
+  };
+  auto makeHistogram = [](const char* name, int nbins) {
+    auto histogram = new TH1F(name, name, nbins, 0, 10);
+    histogram->SetDirectory(nullptr);
+    histogram->Fill(5);
+    return histogram;
+  };
+
+  auto target = makeCollection(makeHistogram("histo", 10));
+  target->merge(makeCollection(makeHistogram("histo", 10)).get());
+  target->merge(makeCollection(makeHistogram("histo", 20)).get());
+
+  auto histogram = dynamic_cast<TH1F*>(dynamic_cast<MonitorObject*>(target->At(0))->getObject());
+  REQUIRE(histogram != nullptr);
+  CHECK(histogram->GetEntries() == 3);
+
+  REQUIRE(target->getMergeStatistics().size() == 1);
+  const auto& statistics = target->getMergeStatistics()[0];
+  CHECK(statistics.className == "TH1F");
+  CHECK(statistics.merges == 2);
+  CHECK(statistics.fastMerges == 1);
+  CHECK(statistics.durationMs >= 0);
+
+  // the statistics of the lower layers are accumulated
+  auto upperLayer = makeCollection(makeHistogram("histo", 10));
+  upperLayer->merge(target.get());
+  CHECK(upperLayer->getMergeStatistics()[0].merges == 3);
+  CHECK(upperLayer->getMergeStatistics()[0].fastMerges == 1);
+}
+
+TEST_CASE("merge_helpers_new_statistics")
+{
+  const std::vector<MergeStatistics> first{ { "TH1F", 2, 1, 10.0 } };
+  const std::vector<MergeStatistics> second{ { "TH1F", 5, 3, 25.0 }, { "TH2F", 1, 1, 2.0 } };
+
+  auto newStatistics = getNewMergeStatistics(second, first);
+  REQUIRE(newStatistics.size() == 2);
+  CHECK(newStatistics[0].className == "TH1F");
+  CHECK(newStatistics[0].merges == 3);
+  CHECK(newStatistics[0].fastMerges == 2);
+  CHECK(newStatistics[0].durationMs == Catch::Approx(15.0));
+  CHECK(newStatistics[1].className == "TH2F");
+  CHECK(newStatistics[1].merges == 1);
+
+  // nothing was merged since the previous collection
+  CHECK(getNewMergeStatistics(second, second).empty());
+
+  // the totals went down, thus the target was recreated, e.g. after a reset
+  newStatistics = getNewMergeStatistics(first, second);
+  REQUIRE(newStatistics.size() == 1);
+  CHECK(newStatistics[0].merges == 2);
+  CHECK(newStatistics[0].durationMs == Catch::Approx(10.0));
+
+  std::vector<MergeStatistics> period;
+  addMergeStatistics(period, getNewMergeStatistics(first, {}));
+  addMergeStatistics(period, getNewMergeStatistics(second, first));
+  REQUIRE(period.size() == 2);
+  CHECK(period[0].merges == 5);
+  CHECK(period[0].fastMerges == 3);
+}
+
+TEST_CASE("merge_helpers_vs_mergers", "[.][benchmark]")
+{
+  // A pixel map of one ITS chip (1024 columns x 512 rows) with 1000 hits per cycle, as sent to Mergers
+  // by a QC task in the delta mode: most of the bins are empty.
+  constexpr int nColumns = 1024;
+  constexpr int nRows = 512;
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> columnDistribution(0, nColumns);
+  std::uniform_real_distribution<double> rowDistribution(0, nRows);
+
+  TH2F target("target", "target", nColumns, 0, nColumns, nRows, 0, nRows);
+  TH2F delta("delta", "delta", nColumns, 0, nColumns, nRows, 0, nRows);
+  target.SetDirectory(nullptr);
+  delta.SetDirectory(nullptr);
+  for (int i = 0; i < 1000; i++) {
+    delta.Fill(columnDistribution(generator), rowDistribution(generator));
+  }
+
+  BENCHMARK("mergers::algorithm::merge")
+  {
+    o2::mergers::algorithm::merge(&target, &delta);
+    return target.GetEntries();
+  };
+
+  BENCHMARK("merge_helpers::mergeHistograms")
+  {
+    merge_helpers::mergeHistograms(&target, &delta);
+    return target.GetEntries();
+  };
+}
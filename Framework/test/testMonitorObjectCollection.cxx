@@ -192,6 +192,88 @@ TEST_CASE("monitor_object_collection_post_deserialization")
   delete moc;
 }
 
+TEST_CASE("monitor_object_collection_find_object")
+{
+  auto makeMO = [](const char* name) {
+    auto mo = new MonitorObject(new TH1I(name, name, 10, 0, 10), "task", "class", "DET");
+    mo->setIsOwner(true);
+    return mo;
+  };
+
+  MonitorObjectCollection moc;
+  moc.SetOwner(true);
+  auto* mo1 = makeMO("histo1");
+  auto* mo2 = makeMO("histo2");
+  auto* mo3 = makeMO("histo3");
+  moc.Add(mo1);
+  moc.Add(mo2);
+  CHECK(moc.FindObject("histo1") == mo1);
+  CHECK(moc.FindObject("histo2") == mo2);
+  CHECK(moc.FindObject("histo3") == nullptr);
+
+  // objects added after the index was built are found as well
+  moc.Add(mo3);
+  CHECK(moc.FindObject("histo3") == mo3);
+
+  // removed objects are not found anymore
+  moc.Remove(mo2);
+  moc.Compress();
+  delete mo2;
+  CHECK(moc.FindObject("histo2") == nullptr);
+  CHECK(moc.FindObject("histo1") == mo1);
+  CHECK(moc.FindObject("histo3") == mo3);
+
+  // replacing an object in a slot
+  auto* mo4 = makeMO("histo4");
+  moc.AddAt(mo4, 0);
+  delete mo1;
+  CHECK(moc.FindObject("histo1") == nullptr);
+  CHECK(moc.FindObject("histo4") == mo4);
+
+  // copies share the objects and have a valid index
+  MonitorObjectCollection copy(moc);
+  copy.SetOwner(false);
+  CHECK(copy.FindObject("histo4") == mo4);
+  CHECK(copy.FindObject("histo3") == mo3);
+
+  moc.Clear();
+  CHECK(moc.FindObject("histo3") == nullptr);
+  CHECK(moc.GetEntries() == 0);
+}
+
+TEST_CASE("monitor_object_collection_merge_unchanged_objects")
+{
+  auto makeMO = [](const char* name) {
+    auto mo = new MonitorObject(new TH1I(name, name, 10, 0, 10), "task", "class", "DET");
+    mo->setIsOwner(true);
+    return mo;
+  };
+
+  MonitorObjectCollection target;
+  target.SetOwner(true);
+  target.Add(makeMO("histo1"));
+  target.setUnchangedObjects({ "histo2" });
+
+  // the other side sent histo2, but histo1 and histo3 did not change there
+  MonitorObjectCollection other;
+  other.SetOwner(true);
+  other.Add(makeMO("histo2"));
+  other.setUnchangedObjects({ "histo1", "histo3" });
+
+  CHECK_NOTHROW(algorithm::merge(&target, &other));
+
+  CHECK(target.GetEntries() == 2);
+  CHECK(target.FindObject("histo1") != nullptr);
+  CHECK(target.FindObject("histo2") != nullptr);
+  // only the objects which are not in the merged collection are still reported as unchanged
+  CHECK(target.getUnchangedObjects() == std::vector<std::string>{ "histo3" });
+
+  // the list survives copying
+  MonitorObjectCollection copy(target);
+  copy.SetOwner(false);
+  CHECK(copy.getUnchangedObjects() == std::vector<std::string>{ "histo3" });
+}
+
 TEST_CASE("monitor_object_collection_clone_mw")
 {
   const size_t bins = 10;
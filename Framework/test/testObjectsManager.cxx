@@ -22,6 +22,7 @@
 #include <TObjString.h>
 #include <TObjArray.h>
 #include <TH1F.h>
+#include <TH2F.h>
 #include <boost/test/unit_test.hpp>
 
 using namespace std;
@@ -165,6 +166,142 @@ BOOST_AUTO_TEST_CASE(getters_test)
   BOOST_CHECK_NO_THROW(objectsManager.getMonitorObject("histo"));
 }
 
+BOOST_AUTO_TEST_CASE(changed_objects_test)
+{
+  Config config;
+  config.taskName = "test";
+  config.consulUrl = "";
+  ObjectsManager objectsManager(config.taskName, config.taskClass, config.detectorName, 0);
+
+  TObjString s("content");
+  TH1F h("histo", "h", 100, 0, 99);
+  objectsManager.startPublishing<true>(&s, PublicationPolicy::Forever);
+  objectsManager.startPublishing<true>(&h, PublicationPolicy::Forever);
+
+  // everything is published the first time
+  std::unique_ptr<MonitorObjectCollection> array(objectsManager.getNonOwningArrayOfChangedObjects());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 2);
+  BOOST_CHECK(array->getUnchangedObjects().empty());
+
+  // the histogram did not change, other types are always published
+  array.reset(objectsManager.getNonOwningArrayOfChangedObjects());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 1);
+  BOOST_CHECK(array->FindObject("content") != nullptr);
+  BOOST_CHECK(array->getUnchangedObjects() == std::vector<std::string>{ "histo" });
+
+  h.Fill(5);
+  array.reset(objectsManager.getNonOwningArrayOfChangedObjects());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 2);
+  BOOST_CHECK(array->FindObject("histo") != nullptr);
+
+  // the task resets and refills the histogram itself, with the same number of entries but a different content
+  h.Reset();
+  h.Fill(7);
+  array.reset(objectsManager.getNonOwningArrayOfChangedObjects());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 2);
+  BOOST_CHECK(array->FindObject("histo") != nullptr);
+
+  // ...and with the same content
+  h.Reset();
+  h.Fill(7);
+  array.reset(objectsManager.getNonOwningArrayOfChangedObjects());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 1);
+  BOOST_CHECK(array->getUnchangedObjects() == std::vector<std::string>{ "histo" });
+
+  // a new activity requires a complete publication
+  array.reset(objectsManager.getNonOwningArrayOfChangedObjects());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 1);
+  objectsManager.setActivity(Activity{ 300000, "PHYSICS" });
+  array.reset(objectsManager.getNonOwningArrayOfChangedObjects());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 2);
+
+  // deleting the array does not delete objects
+  array.reset();
+  BOOST_CHECK_NO_THROW(objectsManager.getMonitorObject("histo"));
+}
+
+BOOST_AUTO_TEST_CASE(changed_objects_delta_test)
+{
+  Config config;
+  config.taskName = "test";
+  config.consulUrl = "";
+  ObjectsManager objectsManager(config.taskName, config.taskClass, config.detectorName, 0);
+
+  TH1F h("histo", "h", 100, 0, 99);
+  TH1F empty("empty", "e", 100, 0, 99);
+  objectsManager.startPublishing<true>(&h, PublicationPolicy::Forever);
+  objectsManager.startPublishing<true>(&empty, PublicationPolicy::Forever);
+
+  // first delta cycle
+  h.Fill(5);
+  std::unique_ptr<MonitorObjectCollection> array(objectsManager.getNonOwningArrayOfChangedObjects());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 2);
+
+  // second delta cycle with identical content after a reset, it must be sent again
+  h.Reset();
+  objectsManager.notifyObjectsReset();
+  h.Fill(5);
+  array.reset(objectsManager.getNonOwningArrayOfChangedObjects());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 1);
+  BOOST_CHECK(array->FindObject("histo") != nullptr);
+  BOOST_CHECK(array->getUnchangedObjects() == std::vector<std::string>{ "empty" });
+
+  // an object which stays empty after a reset is not sent
+  h.Reset();
+  objectsManager.notifyObjectsReset();
+  array.reset(objectsManager.getNonOwningArrayOfChangedObjects());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(shards_test)
+{
+  Config config;
+  ObjectsManager objectsManager(config.taskName, config.taskClass, config.detectorName, 0);
+
+  TObjString s("content");
+  TH1F h("histo", "h", 10, 0, 10);
+  objectsManager.startPublishing<true>(&s, PublicationPolicy::Forever);
+  objectsManager.startPublishing(&h, PublicationPolicy::Forever);
+  objectsManager.setNumberOfShards(3);
+  TH2F h2("histo2", "h2", 10, 0, 10, 10, 0, 10);
+  objectsManager.startPublishing(&h2, PublicationPolicy::Forever);
+  BOOST_CHECK_EQUAL(objectsManager.getNumberOfShards(), 3);
+
+  // worker 0 fills the published objects, the others fill their own copies
+  BOOST_CHECK_EQUAL(objectsManager.getShard(&h, 0), &h);
+  auto* shard1 = objectsManager.getShard(&h, 1);
+  auto* shard2 = objectsManager.getShard(&h, 2);
+  BOOST_CHECK(shard1 != &h && shard2 != &h && shard1 != shard2);
+  BOOST_CHECK(shard1->GetDirectory() == nullptr);
+  h.Fill(1);
+  shard1->Fill(1);
+  shard2->Fill(2);
+  objectsManager.getShard(&h2, 2)->Fill(3, 3);
+  BOOST_CHECK_EQUAL(h.GetEntries(), 1);
+
+  objectsManager.mergeShards();
+  BOOST_CHECK_EQUAL(h.GetEntries(), 3);
+  BOOST_CHECK_EQUAL(h.GetBinContent(h.FindBin(1)), 2);
+  BOOST_CHECK_EQUAL(h.GetBinContent(h.FindBin(2)), 1);
+  BOOST_CHECK_EQUAL(h2.GetEntries(), 1);
+  BOOST_CHECK_EQUAL(shard1->GetEntries(), 0);
+  BOOST_CHECK_EQUAL(shard2->GetEntries(), 0);
+
+  // merging again does not count the same entries twice
+  objectsManager.mergeShards();
+  BOOST_CHECK_EQUAL(h.GetEntries(), 3);
+
+  // unsupported types, unknown objects and workers have no shards
+  BOOST_CHECK_THROW(objectsManager.getShard(&s, 1), ObjectNotFoundError);
+  BOOST_CHECK_THROW(objectsManager.getShard(&h, 3), ObjectNotFoundError);
+  objectsManager.stopPublishing(&h);
+  BOOST_CHECK_THROW(objectsManager.getShard(&h, 1), ObjectNotFoundError);
+
+  objectsManager.setNumberOfShards(1);
+  BOOST_CHECK_THROW(objectsManager.getShard(&h2, 1), ObjectNotFoundError);
+  BOOST_CHECK_EQUAL(objectsManager.getShard(&h2, 0), &h2);
+}
+
 BOOST_AUTO_TEST_CASE(metadata_test)
 {
   Config config;
@@ -356,3 +356,98 @@ TEST_CASE("test_errors")
   CHECK(updatePolicyManager.isReady("actor2") == false);
   updatePolicyManager.updateGlobalRevision();
 }
+
+namespace
+{
+std::vector<std::string> readyActorsOneByOne(UpdatePolicyManager& updatePolicyManager, const std::vector<std::string>& actors)
+{
+  std::vector<std::string> readyActors;
+  for (const auto& actor : actors) {
+    if (updatePolicyManager.isReady(actor)) {
+      readyActors.push_back(actor);
+    }
+  }
+  return readyActors;
+}
+} // namespace
+
+TEST_CASE("test_get_ready_actors")
+{
+  UpdatePolicyManager updatePolicyManager;
+  updatePolicyManager.addPolicy("actor1", UpdatePolicyType::OnAny, { "object1", "object2" }, false, false);
+  updatePolicyManager.addPolicy("actor2", UpdatePolicyType::OnAll, { "object2", "object3/" }, false, false);
+  updatePolicyManager.addPolicy("actor3", UpdatePolicyType::OnAnyNonZero, { "object1", "object3" }, false, false);
+  updatePolicyManager.addPolicy("actor4", UpdatePolicyType::OnGlobalAny, {}, true, false);
+  updatePolicyManager.addPolicy("actor5", UpdatePolicyType::OnEachSeparately, { "object3" }, false, false);
+  const std::vector<std::string> actors{ "actor1", "actor2", "actor3", "actor4", "actor5" };
+
+  auto runCycle = [&](const std::vector<std::string>& updatedObjects) {
+    for (const auto& object : updatedObjects) {
+      updatePolicyManager.updateObjectRevision(object);
+    }
+    auto readyActors = updatePolicyManager.getReadyActors();
+    CHECK(readyActors == readyActorsOneByOne(updatePolicyManager, actors));
+    for (const auto& actor : readyActors) {
+      updatePolicyManager.updateActorRevision(actor);
+    }
+    updatePolicyManager.updateGlobalRevision();
+    return readyActors;
+  };
+
+  CHECK(runCycle({}) == std::vector<std::string>{ "actor4" });
+  CHECK(runCycle({ "object1" }) == std::vector<std::string>{ "actor1", "actor4" });
+  CHECK(runCycle({ "object2" }) == std::vector<std::string>{ "actor1", "actor4" });
+  // OnAll ignores the trailing slash of object names
+  CHECK(runCycle({ "object3" }) == std::vector<std::string>{ "actor2", "actor3", "actor4", "actor5" });
+  // OnAll needs all its objects updated since the last time it was triggered
+  CHECK(runCycle({ "object2" }) == std::vector<std::string>{ "actor1", "actor4" });
+  CHECK(runCycle({ "object2", "object3" }) == std::vector<std::string>{ "actor1", "actor2", "actor3", "actor4", "actor5" });
+
+  // an actor which was ready, but not triggered, stays ready
+  updatePolicyManager.updateObjectRevision("object1");
+  CHECK(updatePolicyManager.getReadyActors() == std::vector<std::string>{ "actor1", "actor3", "actor4" });
+  CHECK(updatePolicyManager.getReadyActors() == std::vector<std::string>{ "actor1", "actor3", "actor4" });
+}
+
+TEST_CASE("test_get_ready_actors_scale", "[.][benchmark]")
+{
+  // Many actors depending on few objects each, while only one object arrives in each cycle.
+  constexpr size_t nActors = 500;
+  constexpr size_t nObjects = 1000;
+  UpdatePolicyManager updatePolicyManager;
+  std::vector<std::string> actors;
+  for (size_t i = 0; i < nActors; i++) {
+    actors.push_back("actor" + std::to_string(i));
+    updatePolicyManager.addPolicy(actors.back(), UpdatePolicyType::OnAny, { "object" + std::to_string(2 * i), "object" + std::to_string(2 * i + 1) }, false, false);
+  }
+  std::vector<std::string> objects;
+  for (size_t i = 0; i < nObjects; i++) {
+    objects.push_back("object" + std::to_string(i));
+  }
+
+  size_t cycle = 0;
+  BENCHMARK("isReady for each actor")
+  {
+    updatePolicyManager.updateObjectRevision(objects[cycle++ % nObjects]);
+    auto readyActors = readyActorsOneByOne(updatePolicyManager, actors);
+    for (const auto& actor : readyActors) {
+      updatePolicyManager.updateActorRevision(actor);
+    }
+    updatePolicyManager.updateGlobalRevision();
+    return readyActors.size();
+  };
+
+  BENCHMARK("getReadyActors")
+  {
+    updatePolicyManager.updateObjectRevision(objects[cycle++ % nObjects]);
+    auto readyActors = updatePolicyManager.getReadyActors();
+    for (const auto& actor : readyActors) {
+      updatePolicyManager.updateActorRevision(actor);
+    }
+    updatePolicyManager.updateGlobalRevision();
+    return readyActors.size();
+  };
+
+  updatePolicyManager.updateObjectRevision("object42");
+  CHECK(updatePolicyManager.getReadyActors() == std::vector<std::string>{ "actor21" });
+}
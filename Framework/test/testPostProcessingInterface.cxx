@@ -47,9 +47,10 @@ class TestTask : public PostProcessingInterface
     test = 2;
   }
   // user gets to know what triggered the processing
-  void update(quality_control::postprocessing::Trigger, framework::ServiceRegistryRef) override
+  void update(quality_control::postprocessing::Trigger trigger, framework::ServiceRegistryRef) override
   {
     test = 3;
+    updates.push_back(trigger.timestamp);
   }
   // user gets to know what triggered the end
   void finalize(quality_control::postprocessing::Trigger, framework::ServiceRegistryRef) override
@@ -58,6 +59,22 @@ class TestTask : public PostProcessingInterface
   }
 
   int test;
+  std::vector<uint64_t> updates;
+};
+
+class ParallelTestTask : public TestTask
+{
+ public:
+  void backfill(const std::vector<quality_control::postprocessing::Trigger>& triggers, framework::ServiceRegistryRef, size_t workers) override
+  {
+    std::vector<uint64_t> results(triggers.size());
+    processInParallel(triggers, workers, [&](size_t trigger, size_t) {
+      results[trigger] = triggers[trigger].timestamp;
+      return triggers[trigger].timestamp != 0;
+    });
+    updates.insert(updates.end(), results.begin(), results.end());
+  }
+  bool supportsBackfill() const override { return true; }
 };
 
 } /* namespace o2::quality_control_modules::test */
@@ -86,4 +103,27 @@ BOOST_AUTO_TEST_CASE(test_factory)
   BOOST_CHECK_EQUAL(task.test, 3);
   task.finalize({ TriggerType::No }, services);
   BOOST_CHECK_EQUAL(task.test, 4);
-}
\ No newline at end of file
+}
+BOOST_AUTO_TEST_CASE(test_backfill)
+{
+  o2::framework::ServiceRegistry services;
+  std::vector<Trigger> triggers;
+  std::vector<uint64_t> timestamps;
+  for (uint64_t timestamp = 0; timestamp < 1000; timestamp++) {
+    triggers.emplace_back(TriggerType::ForEachObject, timestamp == 999, timestamp);
+    timestamps.push_back(timestamp);
+  }
+
+  // by default, the task is updated with each trigger in order
+  o2::quality_control_modules::test::TestTask task;
+  BOOST_CHECK(!task.supportsBackfill());
+  task.backfill(triggers, services, 4);
+  BOOST_CHECK_EQUAL(task.test, 3);
+  BOOST_CHECK(task.updates == timestamps);
+
+  // the results processed in parallel are appended in the order of the triggers
+  o2::quality_control_modules::test::ParallelTestTask parallelTask;
+  parallelTask.setName("parallel");
+  parallelTask.backfill(triggers, services, 4);
+  BOOST_CHECK(parallelTask.updates == timestamps);
+}
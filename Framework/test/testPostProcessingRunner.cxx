@@ -17,12 +17,19 @@
 #include "getTestDataDirectory.h"
 #include "QualityControl/PostProcessingRunner.h"
 #include "QualityControl/WorkflowType.h"
+#include "QualityControl/DummyDatabase.h"
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/ObjectsManager.h"
 #include <Configuration/ConfigurationFactory.h>
+#include <TBufferFile.h>
+#include <TH2F.h>
+#include <TTree.h>
 #include <catch_amalgamated.hpp>
 
 using namespace o2::quality_control::postprocessing;
 using namespace o2::quality_control::core;
 using namespace o2::configuration;
+using namespace o2::quality_control::repository;
 
 TEST_CASE("test_configurationfactory")
 {
@@ -35,3 +42,101 @@ TEST_CASE("test_configurationfactory")
   CHECK_NOTHROW(runner.init(config->getRecursive(), WorkflowType::Standalone));
   CHECK_NOTHROW(runner.run());
 }
+
+namespace
+{
+// serializes the objects as the CCDB does and records whether they were copied before being passed to storeMO
+struct SerializingDatabase : public DummyDatabase {
+  explicit SerializingDatabase(const MonitorObjectCollection& collection, bool synchronous = true)
+    : mCollection(collection), mSynchronous(synchronous)
+  {
+  }
+
+  void storeMO(std::shared_ptr<const MonitorObject> mo) override
+  {
+    TBufferFile buffer(TBuffer::kWrite);
+    buffer.WriteObject(mo->getObject());
+    mStoredBytes += buffer.Length();
+    if (mCollection.IndexOf(mo.get()) < 0) {
+      mCopiedBytes += buffer.Length();
+    }
+  }
+
+  bool storesSynchronously() const override { return mSynchronous; }
+
+  const MonitorObjectCollection& mCollection;
+  bool mSynchronous;
+  size_t mStoredBytes = 0;
+  size_t mCopiedBytes = 0;
+};
+
+// a large 2D histogram and a trending tree, as published by trending and correlation tasks
+struct LargeObjects {
+  LargeObjects()
+  {
+    histogram->SetDirectory(nullptr);
+    for (int i = 0; i < 100000; i++) {
+      histogram->Fill(i % 1000, (i / 1000) % 1000);
+    }
+    tree->SetDirectory(nullptr);
+    double value = 0;
+    tree->Branch("value", &value);
+    for (int i = 0; i < 100000; i++) {
+      value = i;
+      tree->Fill();
+    }
+    tree->ResetBranchAddresses();
+    objectsManager.startPublishing<true>(histogram.get(), PublicationPolicy::Forever);
+    objectsManager.startPublishing<true>(tree.get(), PublicationPolicy::Forever);
+    collection.reset(objectsManager.getNonOwningArray());
+  }
+
+  std::unique_ptr<TH2F> histogram = std::make_unique<TH2F>("map", "map", 1000, 0, 1000, 1000, 0, 1000);
+  std::unique_ptr<TTree> tree = std::make_unique<TTree>("trend", "trend");
+  ObjectsManager objectsManager{ "task", "class", "TST" };
+  std::unique_ptr<MonitorObjectCollection> collection;
+};
+} // namespace
+
+TEST_CASE("publish_to_repository")
+{
+  LargeObjects objects;
+  auto& collection = objects.collection;
+
+  // the objects are passed without copies to the databases which store them immediately...
+  SerializingDatabase synchronousDatabase(*collection);
+  publishToRepository(synchronousDatabase)(collection.get());
+  CHECK(synchronousDatabase.mStoredBytes > 0);
+  CHECK(synchronousDatabase.mCopiedBytes == 0);
+
+  // ...but they are copied for those which store them later
+  SerializingDatabase asynchronousDatabase(*collection, false);
+  publishToRepository(asynchronousDatabase)(collection.get());
+  CHECK(asynchronousDatabase.mCopiedBytes == asynchronousDatabase.mStoredBytes);
+
+  CHECK(collection->GetEntries() == 2);
+}
+
+TEST_CASE("publish_to_repository_benchmark", "[.][benchmark]")
+{
+  LargeObjects objects;
+  auto& collection = objects.collection;
+  SerializingDatabase synchronousDatabase(*collection);
+  SerializingDatabase asynchronousDatabase(*collection, false);
+  auto publishWithoutCopies = publishToRepository(synchronousDatabase);
+  auto publishWithCopies = publishToRepository(asynchronousDatabase);
+
+  BENCHMARK("publishToRepository with copies")
+  {
+    publishWithCopies(collection.get());
+  };
+
+  BENCHMARK("publishToRepository without copies")
+  {
+    publishWithoutCopies(collection.get());
+  };
+
+  asynchronousDatabase.mCopiedBytes = asynchronousDatabase.mStoredBytes = 0;
+  publishWithCopies(collection.get());
+  WARN("Without the copies, each update saves cloning objects of " << asynchronousDatabase.mCopiedBytes << " bytes once serialized");
+}
@@ -18,7 +18,9 @@
 #include "QualityControl/QualityObject.h"
 #include <DataFormatsQualityControl/QualityControlFlagCollection.h>
 #include <DataFormatsQualityControl/FlagTypeFactory.h>
+#include <algorithm>
 #include <ranges>
+#include <tuple>
 #include <catch_amalgamated.hpp>
 
 using namespace o2::quality_control;
@@ -594,4 +596,116 @@ TEST_CASE("Extending the validity interval", "[QualitiesToFlagCollectionConverte
   CHECK(flag4.getEnd() == 120);
   CHECK(flag4.getFlag() == FlagTypeFactory::UnknownQuality());
   CHECK(flag4.getSource() == "qc/DET/QO/xyzCheck");
-}
\ No newline at end of file
+}
+namespace
+{
+// QOs of consecutive cycles, every third one is Bad and every seventh one carries a flag
+std::vector<QualityObject> makeConsecutiveQOs(size_t nQOs)
+{
+  std::vector<QualityObject> qos;
+  qos.reserve(nQOs);
+  for (size_t i = 0; i < nQOs; i++) {
+    auto& qo = qos.emplace_back(i % 3 == 0 ? Quality::Bad : Quality::Good, "xyzCheck", "DET");
+    qo.setValidity({ 1000 * i, 1000 * (i + 1) });
+    if (i % 7 == 0) {
+      qo.addFlag(FlagTypeFactory::BadTracking(), "tracking");
+    }
+  }
+  return qos;
+}
+} // namespace
+
+TEST_CASE("Many consecutive QOs", "[QualitiesToFlagCollectionConverter]")
+{
+  constexpr size_t nQOs = 2100;
+  auto qos = makeConsecutiveQOs(nQOs);
+
+  std::unique_ptr<QualityControlFlagCollection> qcfc{ new QualityControlFlagCollection("test1", "DET", { 0, 1000 * nQOs + 500 }) };
+  QualitiesToFlagCollectionConverter converter(std::move(qcfc), "qc/DET/QO/xyzCheck");
+  for (const auto& qo : qos) {
+    converter(qo);
+  }
+  qcfc = converter.getResult();
+
+  // QOs with flags: every 7th. Bad QOs without flags: every 3rd, but not every 21st, each separated by Good QOs.
+  // The last 500 ms are not covered by any QO.
+  size_t badTracking = 0;
+  size_t unknown = 0;
+  size_t unknownQuality = 0;
+  for (const auto& flag : *qcfc) {
+    if (flag.getFlag() == FlagTypeFactory::BadTracking()) {
+      badTracking++;
+    } else if (flag.getFlag() == FlagTypeFactory::Unknown()) {
+      unknown++;
+    } else if (flag.getFlag() == FlagTypeFactory::UnknownQuality()) {
+      unknownQuality++;
+      CHECK(flag.getStart() == 1000 * nQOs);
+    }
+  }
+  CHECK(badTracking == nQOs / 7);
+  CHECK(unknown == nQOs / 3 - nQOs / 21);
+  CHECK(unknownQuality == 1);
+  CHECK(qcfc->size() == badTracking + unknown + unknownQuality);
+}
+
+TEST_CASE("Taking finalized flags", "[QualitiesToFlagCollectionConverter]")
+{
+  constexpr size_t nQOs = 2100;
+  auto qos = makeConsecutiveQOs(nQOs);
+  auto sortFlags = [](std::vector<QualityControlFlag>& flags) {
+    std::sort(flags.begin(), flags.end(), [](const auto& a, const auto& b) {
+      return std::make_tuple(a.getStart(), a.getEnd(), a.getComment()) < std::make_tuple(b.getStart(), b.getEnd(), b.getComment());
+    });
+  };
+
+  std::unique_ptr<QualityControlFlagCollection> qcfc{ new QualityControlFlagCollection("test1", "DET", { 0, 1000 * nQOs + 500 }) };
+  QualitiesToFlagCollectionConverter converter(std::move(qcfc), "qc/DET/QO/xyzCheck");
+  for (const auto& qo : qos) {
+    converter(qo);
+  }
+  auto allAtOnce = converter.getResult();
+  std::vector<QualityControlFlag> expected(allAtOnce->begin(), allAtOnce->end());
+  sortFlags(expected);
+
+  // the same converter is reused, as it is reset by getResult()
+  std::vector<QualityControlFlag> streamed;
+  size_t maxBufferedFlags = 0;
+  for (size_t i = 0; i < nQOs; i++) {
+    converter(qos[i]);
+    maxBufferedFlags = std::max(maxBufferedFlags, converter.getBufferedFlags());
+    if (i % 50 == 49) {
+      CHECK(converter.getNewestQOStart() == qos[i].getValidity().getMin());
+      auto finalized = converter.takeFinalizedFlags(converter.getNewestQOStart());
+      CHECK(finalized->getName() == "test1");
+      for (const auto& flag : *finalized) {
+        CHECK(flag.getEnd() < converter.getNewestQOStart());
+        CHECK(flag.getFlag() != FlagTypeFactory::Good()); // the dummy Good flags are never sent
+        streamed.push_back(flag);
+      }
+    }
+  }
+  auto remainder = converter.getResult();
+  streamed.insert(streamed.end(), remainder->begin(), remainder->end());
+  sortFlags(streamed);
+
+  CHECK(streamed == expected);
+  // the finalized flags do not pile up in the buffer
+  CHECK(maxBufferedFlags < 100);
+}
+
+TEST_CASE("Conversion scaling", "[.][benchmark]")
+{
+  // in async passes, there can be many thousands of QOs per run and path
+  for (size_t nQOs : { 1000, 10000, 100000 }) {
+    auto qos = makeConsecutiveQOs(nQOs);
+    BENCHMARK("convert " + std::to_string(nQOs) + " QOs")
+    {
+      std::unique_ptr<QualityControlFlagCollection> qcfc{ new QualityControlFlagCollection("test1", "DET", { 0, 1000 * nQOs }) };
+      QualitiesToFlagCollectionConverter converter(std::move(qcfc), "qc/DET/QO/xyzCheck");
+      for (const auto& qo : qos) {
+        converter(qo);
+      }
+      return converter.getResult()->size();
+    };
+  }
+}
@@ -0,0 +1,114 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testRetrievalPool.cxx
+///
+
+#include "QualityControl/RetrievalPool.h"
+#include "QualityControl/DummyDatabase.h"
+
+#include <TObjString.h>
+#include <atomic>
+#include <thread>
+#include <catch_amalgamated.hpp>
+
+using namespace o2::quality_control::repository;
+
+namespace
+{
+
+// each copy counts the retrievals in flight, so we can see how many are executed at the same time
+struct SlowDatabase : public DummyDatabase {
+  struct Shared {
+    std::atomic<int> inFlight = 0;
+    std::atomic<int> maxInFlight = 0;
+  };
+
+  SlowDatabase(std::shared_ptr<Shared> shared, bool copyable) : mShared(std::move(shared)), mCopyable(copyable) {}
+
+  TObject* retrieveTObject(std::string path, const std::map<std::string, std::string>&, long, std::map<std::string, std::string>*) override
+  {
+    int inFlight = ++mShared->inFlight;
+    int maxInFlight = mShared->maxInFlight;
+    while (inFlight > maxInFlight && !mShared->maxInFlight.compare_exchange_weak(maxInFlight, inFlight)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    mShared->inFlight--;
+    if (path == "throw") {
+      throw std::runtime_error("retrieval failed");
+    }
+    return new TObjString(path.c_str());
+  }
+
+  std::unique_ptr<DatabaseInterface> clone() override
+  {
+    return mCopyable ? std::make_unique<SlowDatabase>(mShared, mCopyable) : nullptr;
+  }
+
+  std::shared_ptr<Shared> mShared;
+  bool mCopyable;
+};
+
+std::shared_ptr<TObject> retrieve(DatabaseInterface& database, const std::string& path)
+{
+  return std::shared_ptr<TObject>(database.retrieveTObject(path, {}));
+}
+
+} // namespace
+
+TEST_CASE("retrieval_pool_bounded_parallelism")
+{
+  auto shared = std::make_shared<SlowDatabase::Shared>();
+  SlowDatabase database(shared, true);
+  RetrievalPool pool(database, 3);
+  CHECK(pool.getParallelism() == 3);
+
+  std::vector<std::shared_future<std::shared_ptr<TObject>>> results;
+  for (int i = 0; i < 9; i++) {
+    results.emplace_back(pool.submit([i](DatabaseInterface& db) { return retrieve(db, "object" + std::to_string(i)); }));
+  }
+  for (int i = 0; i < 9; i++) {
+    REQUIRE(results[i].get() != nullptr);
+    CHECK(std::string(results[i].get()->GetName()) == "object" + std::to_string(i));
+  }
+  CHECK(shared->maxInFlight > 1);
+  CHECK(shared->maxInFlight <= 3);
+
+  // the retrievals can be taken in the order they finish
+  std::vector<std::shared_future<std::shared_ptr<TObject>>> pending;
+  for (int i = 0; i < 5; i++) {
+    pending.emplace_back(pool.submit([i](DatabaseInterface& db) { return retrieve(db, "pending" + std::to_string(i)); }));
+  }
+  while (!pending.empty()) {
+    auto ready = pool.waitForAny(pending);
+    REQUIRE(ready < pending.size());
+    CHECK(pending[ready].wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    pending.erase(pending.begin() + ready);
+  }
+
+  auto failed = pool.submit([](DatabaseInterface& db) { return retrieve(db, "throw"); });
+  CHECK_THROWS_AS(failed.get(), std::runtime_error);
+}
+
+TEST_CASE("retrieval_pool_sequential_fallback")
+{
+  auto shared = std::make_shared<SlowDatabase::Shared>();
+  SlowDatabase database(shared, false);
+  RetrievalPool pool(database, 3);
+  CHECK(pool.getParallelism() == 1);
+
+  auto result = pool.submit([](DatabaseInterface& db) { return retrieve(db, "object"); });
+  // executed immediately in the calling thread
+  CHECK(result.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+  CHECK(std::string(result.get()->GetName()) == "object");
+  CHECK(shared->maxInFlight == 1);
+}
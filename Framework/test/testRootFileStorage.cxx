@@ -402,4 +402,41 @@ TEST_CASE("walking")
     REQUIRE(!mwWalker.hasNextPath());
     CHECK(mwWalker.nextPath().empty());
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("index_from_keys")
+{
+  // the fixture will do the cleanup when being destroyed only after any file readers are destroyed earlier
+  TestFileFixture fixture("index_from_keys");
+
+  MonitorObjectCollection* moc = new MonitorObjectCollection();
+  moc->SetOwner(true);
+  moc->setDetector("TST");
+
+  TH1I* histo = new TH1I("histo 1", "histo 1", bins, min, max);
+  histo->Fill(5);
+  MonitorObject* moHisto = new MonitorObject(histo, "histo 1", "class", "DET");
+  moHisto->setActivity({ 300000, "PHYSICS", "LHC32x", "apass2", "qc_async", { 100, 300 } });
+  moHisto->setIsOwner(true);
+  moc->Add(moHisto);
+
+  RootFileStorage storage(fixture.filePath, RootFileStorage::ReadMode::Update);
+  storage.storeIntegralMOC(moc);
+  storage.storeMovingWindowMOC(moc);
+  delete moc;
+
+  // the index is built from the keys only
+  auto index = storage.readStructure(false);
+  const auto& integralTask = std::get<RootFileStorage::DirectoryNode>(std::get<RootFileStorage::DirectoryNode>(index.children.at("int")).children.at("TST"));
+  const auto& integralEntry = std::get<RootFileStorage::MonitorObjectCollectionNode>(integralTask.children.at("Test"));
+  CHECK(integralEntry.fullPath == "int/TST/Test");
+  CHECK(integralEntry.moc == nullptr);
+  CHECK(!integralEntry.validFrom.has_value());
+
+  const auto& mwDetector = std::get<RootFileStorage::DirectoryNode>(std::get<RootFileStorage::DirectoryNode>(index.children.at("mw")).children.at("TST"));
+  const auto& mwTask = std::get<RootFileStorage::DirectoryNode>(mwDetector.children.at("Test"));
+  const auto& mwEntry = std::get<RootFileStorage::MonitorObjectCollectionNode>(mwTask.children.at("100"));
+  CHECK(mwEntry.fullPath == "mw/TST/Test/100");
+  CHECK(mwEntry.moc == nullptr);
+  CHECK(mwEntry.validFrom == 100);
+}
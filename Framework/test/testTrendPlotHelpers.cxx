@@ -0,0 +1,72 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testTrendPlotHelpers.cxx
+///
+
+#include "QualityControl/TrendPlotHelpers.h"
+
+#include <TGraphErrors.h>
+#include <TH1F.h>
+#include <TH2F.h>
+#include <catch_amalgamated.hpp>
+
+using namespace o2::quality_control::postprocessing;
+
+TEST_CASE("trend_plot_helpers_split_varexp")
+{
+  using trend_plot_helpers::splitVarexp;
+  CHECK(splitVarexp("source.mean:time") == std::vector<std::string>{ "source.mean", "time" });
+  CHECK(splitVarexp("source.mean") == std::vector<std::string>{ "source.mean" });
+  CHECK(splitVarexp("TMath::Abs(source.mean):meta.runNumber") == std::vector<std::string>{ "TMath::Abs(source.mean)", "meta.runNumber" });
+  CHECK(splitVarexp("a:b:c:d").size() == 4);
+}
+
+TEST_CASE("trend_plot_helpers_append_points")
+{
+  std::vector<double> x{ 1, 2, 3 }, y{ 10, 20, 30 }, ex{ 0.1, 0.2, 0.3 }, ey{ 1, 2, 3 };
+
+  TGraphErrors graph(2);
+  graph.SetPoint(0, -1, -10);
+  graph.SetPoint(1, 0, 0);
+  trend_plot_helpers::appendPoints(&graph, x, y, ex, ey);
+  REQUIRE(graph.GetN() == 5);
+  CHECK(graph.GetX()[0] == -1);
+  CHECK(graph.GetX()[4] == 3);
+  CHECK(graph.GetY()[2] == 10);
+  CHECK(graph.GetEX()[3] == 0.2);
+  CHECK(graph.GetEY()[4] == 3);
+
+  trend_plot_helpers::appendPoints(&graph, {}, {});
+  CHECK(graph.GetN() == 5);
+  trend_plot_helpers::appendPoints(nullptr, x, y);
+}
+
+TEST_CASE("trend_plot_helpers_fit_in_frame")
+{
+  std::vector<double> inside{ 1, 5 }, outside{ 1, 15 };
+
+  TH1F frame1D("frame1D", "frame1D", 10, 0, 10);
+  frame1D.SetMinimum(0);
+  frame1D.SetMaximum(10);
+  CHECK(trend_plot_helpers::fitInFrame(&frame1D, inside, inside));
+  CHECK_FALSE(trend_plot_helpers::fitInFrame(&frame1D, outside, inside));
+  CHECK_FALSE(trend_plot_helpers::fitInFrame(&frame1D, inside, outside));
+  CHECK(trend_plot_helpers::fitInFrame(&frame1D, outside, inside, false, true));
+  CHECK(trend_plot_helpers::fitInFrame(&frame1D, inside, outside, true, false));
+
+  TH2F frame2D("frame2D", "frame2D", 10, 0, 10, 10, 0, 20);
+  CHECK(trend_plot_helpers::fitInFrame(&frame2D, inside, outside));
+  CHECK_FALSE(trend_plot_helpers::fitInFrame(&frame2D, outside, outside));
+
+  CHECK_FALSE(trend_plot_helpers::fitInFrame(nullptr, inside, inside));
+}
@@ -0,0 +1,158 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testTrendStore.cxx
+///
+
+#include "QualityControl/TrendStore.h"
+
+#include <catch_amalgamated.hpp>
+
+using namespace o2::quality_control::postprocessing;
+
+namespace
+{
+
+struct Values {
+  Double_t mean = 0;
+  Int_t entries[2][3] = {};
+  Float_t stddev = 0;
+};
+
+struct Meta {
+  Long64_t runNumber = 0;
+  char runNumberStr[7] = { 0 };
+};
+
+struct TestTrend {
+  explicit TestTrend(size_t chunkSize) : store("trend", chunkSize)
+  {
+    store.addBranch("meta", &meta, "runNumber/L:runNumberStr/C");
+    store.addBranch("time", &time, "time/i");
+    store.addBranch("source", &values, "mean/D:entries[2][3]/I:stddev/F");
+  }
+
+  void fill(int i)
+  {
+    time = 1000 + i;
+    meta.runNumber = 500000 + i;
+    values.mean = i * 0.5;
+    values.entries[1][2] = i;
+    values.stddev = 2.f * i;
+    store.fill();
+  }
+
+  Values values;
+  Meta meta;
+  UInt_t time = 0;
+  TrendStore store;
+};
+
+} // namespace
+
+TEST_CASE("trend_store_columns")
+{
+  TestTrend trend(0);
+  for (int i = 0; i < 5; i++) {
+    trend.fill(i);
+  }
+  CHECK(trend.store.getEntries() == 5);
+  CHECK(trend.store.getTree()->GetEntries() == 5);
+  CHECK(trend.store.getTail()->GetEntries() == 5);
+  // without chunks, the tail is the complete trend
+  CHECK(trend.store.getTail() == trend.store.getTree());
+
+  auto time = trend.store.getColumn("time");
+  REQUIRE(time.has_value());
+  CHECK(time->size() == 5);
+  CHECK(time->back() == 1004);
+  auto runNumber = trend.store.getColumn("meta.runNumber");
+  REQUIRE(runNumber.has_value());
+  CHECK(runNumber->front() == 500000);
+  auto mean = trend.store.getColumn(" source.mean ");
+  REQUIRE(mean.has_value());
+  CHECK(mean->back() == 2.0);
+  auto entries = trend.store.getColumn("source.entries[1][2]");
+  REQUIRE(entries.has_value());
+  CHECK(entries->back() == 4);
+  auto stddev = trend.store.getColumn("source.stddev");
+  REQUIRE(stddev.has_value());
+  CHECK(stddev->back() == 8.0);
+
+  // not columns: strings, whole arrays, expressions and unknown names
+  CHECK(!trend.store.getColumn("meta.runNumberStr").has_value());
+  CHECK(!trend.store.getColumn("source.entries").has_value());
+  CHECK(!trend.store.getColumn("source.mean*2").has_value());
+  CHECK(!trend.store.getColumn("other.mean").has_value());
+
+  // the TTree contains the same values
+  trend.store.getTree()->Draw("source.entries[1][2]:source.mean", "", "goff");
+  CHECK(trend.store.getTree()->GetSelectedRows() == 5);
+  CHECK(trend.store.getTree()->GetVal(0)[4] == 4);
+  CHECK(trend.store.getTree()->GetVal(1)[4] == 2.0);
+
+  CHECK_THROWS(trend.store.addBranch("late", &trend.time, "late/i"));
+}
+
+TEST_CASE("trend_store_chunks")
+{
+  TestTrend trend(3);
+  for (int i = 0; i < 7; i++) {
+    trend.fill(i);
+  }
+  CHECK(trend.store.getEntries() == 7);
+  CHECK(trend.store.getTail()->GetEntries() == 1);
+  CHECK(trend.store.getNumberOfSealedChunks() == 2);
+
+  auto chunks = trend.store.takeNewlySealedChunks();
+  REQUIRE(chunks.size() == 2);
+  CHECK(std::string(chunks[0]->GetName()) == TrendStore::getChunkName("trend", 0));
+  CHECK(std::string(chunks[1]->GetName()) == "trend_chunk1");
+  CHECK(std::string(trend.store.getTail()->GetName()) == "trend");
+  CHECK(chunks[0]->GetEntries() == 3);
+  CHECK(chunks[1]->GetEntries() == 3);
+  CHECK(trend.store.takeNewlySealedChunks().empty());
+
+  SECTION("restoring the chunks")
+  {
+    TestTrend restored(3);
+    restored.store.loadSealedChunk(*chunks[0]);
+    restored.store.loadSealedChunk(*chunks[1]);
+    restored.store.loadTail(*trend.store.getTail());
+    CHECK(restored.store.getEntries() == 7);
+    CHECK(restored.store.getNumberOfSealedChunks() == 2);
+    CHECK(restored.store.getTail()->GetEntries() == 1);
+    CHECK(restored.store.takeNewlySealedChunks().empty());
+    auto time = restored.store.getColumn("time");
+    REQUIRE(time.has_value());
+    CHECK(std::vector<double>(time->begin(), time->end()) == std::vector<double>{ 1000, 1001, 1002, 1003, 1004, 1005, 1006 });
+
+    restored.fill(7);
+    CHECK(restored.store.getTail()->GetEntries() == 2);
+    CHECK(restored.store.getColumn("source.mean")->back() == 3.5);
+  }
+
+  SECTION("restoring a trend stored as one TTree")
+  {
+    TestTrend restored(3);
+    restored.store.loadTail(*trend.store.getTree());
+    CHECK(restored.store.getEntries() == 7);
+    CHECK(restored.store.getNumberOfSealedChunks() == 2);
+    CHECK(restored.store.getTail()->GetEntries() == 1);
+    CHECK(restored.store.takeNewlySealedChunks().size() == 2);
+  }
+
+  trend.store.reset();
+  CHECK(trend.store.getEntries() == 0);
+  CHECK(trend.store.getNumberOfSealedChunks() == 0);
+  CHECK(trend.store.getColumn("time")->empty());
+}
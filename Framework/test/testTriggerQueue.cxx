@@ -0,0 +1,111 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testTriggerQueue.cxx
+///
+
+#include "QualityControl/TriggerQueue.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <catch_amalgamated.hpp>
+
+using namespace std::chrono;
+using namespace o2::quality_control::postprocessing;
+
+namespace
+{
+// fires the provided number of times, each time with the next timestamp, then triggers for the last time
+TriggerFcn countingTrigger(uint64_t times, TriggerType type = TriggerType::ForEachObject)
+{
+  return [times, type, current = uint64_t{ 0 }]() mutable -> Trigger {
+    current++;
+    return { type, current == times, current };
+  };
+}
+} // namespace
+
+TEST_CASE("trigger_queue_takes_ready_triggers")
+{
+  TriggerQueue queue({ milliseconds(10), milliseconds(10) });
+  CHECK(queue.isExhausted(TriggerQueue::Group::Update));
+  CHECK_FALSE(queue.take(TriggerQueue::Group::Update));
+
+  queue.setTriggers(TriggerQueue::Group::Update, { countingTrigger(100) });
+  CHECK_FALSE(queue.isExhausted(TriggerQueue::Group::Update));
+  CHECK(queue.waitForAny(seconds(10)));
+
+  // the triggers known in advance are evaluated as soon as the previous one is taken
+  for (uint64_t i = 1; i <= 100; i++) {
+    auto trigger = queue.take(TriggerQueue::Group::Update, seconds(10));
+    REQUIRE(trigger == TriggerType::ForEachObject);
+    CHECK(trigger.timestamp == i);
+    CHECK(trigger.last == (i == 100));
+  }
+  CHECK(queue.isExhausted(TriggerQueue::Group::Update));
+  CHECK_FALSE(queue.take(TriggerQueue::Group::Update, milliseconds(20)));
+
+  auto stats = queue.getStats();
+  CHECK(stats.evaluations == 100);
+  CHECK(stats.fired == 100);
+  CHECK(stats.taken == 100);
+  CHECK(stats.maxEvaluationSeconds >= 0);
+  CHECK(stats.maxWaitingSeconds >= 0);
+}
+
+TEST_CASE("trigger_queue_groups")
+{
+  TriggerQueue queue({ milliseconds(10), milliseconds(10) });
+  queue.setTriggers(TriggerQueue::Group::Update, { countingTrigger(1, TriggerType::NewObject) });
+  queue.setTriggers(TriggerQueue::Group::Stop, { countingTrigger(1, TriggerType::EndOfRun) });
+
+  CHECK(queue.take(TriggerQueue::Group::Stop, seconds(10)) == TriggerType::EndOfRun);
+  CHECK_FALSE(queue.take(TriggerQueue::Group::Stop));
+  CHECK(queue.take(TriggerQueue::Group::Update, seconds(10)) == TriggerType::NewObject);
+
+  // replacing the functions drops the triggers which were ready
+  queue.setTriggers(TriggerQueue::Group::Update, { countingTrigger(1, TriggerType::NewObject) });
+  REQUIRE(queue.waitForAny(seconds(10)));
+  queue.setTriggers(TriggerQueue::Group::Update, {});
+  CHECK_FALSE(queue.take(TriggerQueue::Group::Update));
+  CHECK(queue.isExhausted(TriggerQueue::Group::Update));
+}
+
+TEST_CASE("trigger_queue_backoff")
+{
+  std::atomic<size_t> evaluations = 0;
+  std::atomic<bool> fire = false;
+  TriggerQueue queue({ milliseconds(5), milliseconds(40) });
+  queue.setTriggers(TriggerQueue::Group::Update, { [&]() -> Trigger {
+                      evaluations++;
+                      return { fire ? TriggerType::NewObject : TriggerType::No, false };
+                    } });
+
+  // 5 + 10 + 20 + 40 + 40 + ... ms, thus about 10 evaluations in 400 ms instead of 80 without the backoff
+  std::this_thread::sleep_for(milliseconds(400));
+  CHECK(evaluations > 2);
+  CHECK(evaluations < 20);
+  CHECK_FALSE(queue.take(TriggerQueue::Group::Update));
+
+  // the latency of a trigger is bounded by the maximum backoff
+  fire = true;
+  CHECK(queue.take(TriggerQueue::Group::Update, milliseconds(1000)) == TriggerType::NewObject);
+}
+
+TEST_CASE("trigger_queue_errors")
+{
+  TriggerQueue queue;
+  queue.setTriggers(TriggerQueue::Group::Init, { []() -> Trigger { throw std::runtime_error("cannot reach the database"); } });
+  CHECK_THROWS_AS(queue.take(TriggerQueue::Group::Init, seconds(10)), std::runtime_error);
+  CHECK(queue.isExhausted(TriggerQueue::Group::Init));
+}
@@ -0,0 +1,92 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testWorkerPool.cxx
+///
+
+#include "QualityControl/WorkerPool.h"
+
+#include <TH1F.h>
+#include <TROOT.h>
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <catch_amalgamated.hpp>
+
+using namespace o2::quality_control::core;
+
+TEST_CASE("worker_pool_run")
+{
+  WorkerPool pool(4);
+  REQUIRE(pool.getNumberOfWorkers() == 4);
+
+  // each item is processed exactly once, by one of the workers
+  for (size_t nItems : { 0, 1, 3, 1000 }) {
+    std::vector<std::atomic<int>> processed(nItems);
+    std::vector<size_t> workers(nItems);
+    pool.run(nItems, [&](size_t item, size_t worker) {
+      processed[item]++;
+      workers[item] = worker;
+    });
+    for (size_t item = 0; item < nItems; item++) {
+      CHECK(processed[item] == 1);
+      CHECK(workers[item] < 4);
+    }
+  }
+
+  // the first exception is rethrown and the pool can be used afterwards
+  auto failing = [](size_t item, size_t) {
+    if (item == 10) {
+      throw std::runtime_error("failed");
+    }
+  };
+  CHECK_THROWS_AS(pool.run(100, failing), std::runtime_error);
+  std::atomic<size_t> sum = 0;
+  pool.run(10, [&](size_t item, size_t) { sum += item; });
+  CHECK(sum == 45);
+}
+
+TEST_CASE("worker_pool_single_worker")
+{
+  WorkerPool pool(0);
+  CHECK(pool.getNumberOfWorkers() == 1);
+  std::set<size_t> workers;
+  size_t count = 0;
+  pool.run(5, [&](size_t, size_t worker) {
+    workers.insert(worker);
+    count++;
+  });
+  CHECK(count == 5);
+  CHECK(workers == std::set<size_t>{ 0 });
+}
+
+TEST_CASE("worker_pool_histograms")
+{
+  // typical usage: each worker fills its own histogram, they are added together at the end
+  ROOT::EnableThreadSafety();
+  WorkerPool pool(3);
+  std::vector<std::unique_ptr<TH1F>> histograms;
+  for (size_t worker = 0; worker < pool.getNumberOfWorkers(); worker++) {
+    histograms.emplace_back(std::make_unique<TH1F>(("h" + std::to_string(worker)).c_str(), "h", 100, 0, 100));
+    histograms.back()->SetDirectory(nullptr);
+  }
+  pool.run(100, [&](size_t item, size_t worker) {
+    for (int i = 0; i < 1000; i++) {
+      histograms[worker]->Fill(static_cast<double>(item));
+    }
+  });
+  for (size_t worker = 1; worker < histograms.size(); worker++) {
+    histograms[0]->Add(histograms[worker].get());
+  }
+  CHECK(histograms[0]->GetEntries() == 100000);
+  CHECK(histograms[0]->GetBinContent(42) == 1000);
+}